@@ -1,4 +1,5 @@
 #include "hxcomm/common/connection_parameter.h"
+#include "hxcomm/common/execute_messages.h"
 #include "hxcomm/common/loopbackconnection.h"
 #include "hxcomm/vx/utmessage.h"
 #include "hxcomm/vx/utmessage_random.h"
@@ -77,6 +78,29 @@ void throughput_measurement(size_t const num, unsigned int const seed)
 		std::cout << " - rec: " << std::setprecision(5) << to_mega_rate(num, ms) << " MHz;\t"
 		          << to_mega_rate(byte_count, ms) << " MiB/s" << std::endl;
 	}
+	// round trip of single-message programs via execute_messages
+	{
+		LoopbackConnection<UTMessageParameter, system::Loopback> stream_connection;
+
+		constexpr size_t num_programs = 10000;
+		std::vector<typename loopback_connection_t::send_message_type> const program{
+		    UTMessage<
+		        UTMessageParameter::HeaderAlignment, typename UTMessageParameter::SubwordType,
+		        typename UTMessageParameter::PhywordType, send_dict, timing::Setup>()};
+
+		auto const begin = std::chrono::high_resolution_clock::now();
+
+		for (size_t i = 0; i < num_programs; ++i) {
+			execute_messages(stream_connection, program);
+		}
+
+		auto const end = std::chrono::high_resolution_clock::now();
+		auto const us = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+
+		std::cout << " - execute: " << std::setprecision(5)
+		          << static_cast<double>(us) / static_cast<double>(num_programs) << " us/program"
+		          << std::endl;
+	}
 }
 
 int main(int argc, char* argv[])
@@ -2,22 +2,31 @@
 #include "bss_hw_params/cube_ethernet/constants.h"
 #include "bss_hw_params/jboa_ethernet/constants.h"
 #include "hate/visibility.h"
+#include "hxcomm/common/async_send_queue.h"
+#include "hxcomm/common/cancellation_token.h"
 #include "hxcomm/common/connect_to_remote_parameter_defs.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_registry.h"
+#include "hxcomm/common/connection_time_accumulator.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_accumulator.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/decoder.h"
 #include "hxcomm/common/encoder.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/listener_halt.h"
+#include "hxcomm/common/receive_wait_policy.h"
+#include "hxcomm/common/signal.h"
 #include "hxcomm/common/stream.h"
 #include "hxcomm/common/target.h"
+#include "hxcomm/common/thread_placement.h"
 #include "hxcomm/common/utmessage.h"
 #include "sctrltp/ARQFrame.h"
 #include "sctrltp/ARQStream.h"
 #include <array>
 #include <atomic>
-#include <filesystem>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -106,6 +115,14 @@ public:
 	 */
 	ConnectionTimeInfo get_time_info() const SYMBOL_VISIBLE;
 
+	/**
+	 * Get transport-level information of HostARQ packets.
+	 * The time blocked in sending is accounted for in the send thread of the asynchronous send
+	 * queue for non-zero send queue capacity.
+	 * @return Wire information
+	 */
+	ConnectionWireInfo get_wire_info() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get unique identifier from hwdb.
 	 * @param hwdb_path Optional path to hwdb
@@ -133,6 +150,88 @@ public:
 	 */
 	std::string get_remote_repo_state() const SYMBOL_VISIBLE;
 
+	/**
+	 * Set policy of the receive worker on how to wait while no data is available.
+	 * @param policy Receive wait policy
+	 */
+	void set_receive_wait_policy(ReceiveWaitPolicy const& policy) SYMBOL_VISIBLE;
+
+	/**
+	 * Get policy of the receive worker on how to wait while no data is available.
+	 * Defaults to the policy found in the environment.
+	 * @return Receive wait policy
+	 */
+	ReceiveWaitPolicy get_receive_wait_policy() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set capacity of the asynchronous send queue in number of packets.
+	 * For non-zero capacity, filled packets are sent by a dedicated send thread and adding
+	 * messages only blocks while the queue is full, so that encoding overlaps with transmission.
+	 * For zero capacity, filled packets are sent inline while adding messages.
+	 * @param capacity Send queue capacity
+	 */
+	void set_send_queue_capacity(size_t capacity) SYMBOL_VISIBLE;
+
+	/**
+	 * Get capacity of the asynchronous send queue in number of packets.
+	 * Defaults to the capacity found in the environment.
+	 * @return Send queue capacity
+	 */
+	size_t get_send_queue_capacity() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set placement of the receive thread onto CPU cores and its scheduling policy.
+	 * Safe to call concurrently to executions.
+	 * @param placement Thread placement
+	 */
+	void set_thread_placement(ThreadPlacement const& placement) SYMBOL_VISIBLE;
+
+	/**
+	 * Get placement of the receive thread onto CPU cores and its scheduling policy.
+	 * Defaults to the placement found in the environment.
+	 * @return Thread placement
+	 */
+	ThreadPlacement get_thread_placement() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set maximal duration of executions, after which run_until_halt aborts the execution.
+	 * Responses of an aborted execution arriving later are discarded, so that the connection
+	 * stays usable without reconnect.
+	 * Not to be called during an execution.
+	 * @param timeout Execution timeout, none for waiting indefinitely
+	 */
+	void set_execution_timeout(std::optional<std::chrono::nanoseconds> timeout) SYMBOL_VISIBLE;
+
+	/**
+	 * Get maximal duration of executions.
+	 * Defaults to none.
+	 * @return Execution timeout
+	 */
+	std::optional<std::chrono::nanoseconds> get_execution_timeout() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set token to cancel executions from other threads.
+	 * A cancelled token aborts running and future executions in run_until_halt until reset.
+	 * Not to be called during an execution.
+	 * @param token Cancellation token
+	 */
+	void set_cancellation_token(CancellationToken const& token) SYMBOL_VISIBLE;
+
+	/**
+	 * Get token to cancel executions from other threads.
+	 * Defaults to a token owned by the connection.
+	 * @return Cancellation token sharing its state with the one of the connection
+	 */
+	CancellationToken get_cancellation_token() const SYMBOL_VISIBLE;
+
+	/**
+	 * Wait until the remaining responses of aborted executions are discarded, i.e. their halt
+	 * responses arrived.
+	 * @param timeout Maximal duration to wait
+	 * @return Whether no responses of aborted executions are outstanding anymore
+	 */
+	bool wait_discarded(std::chrono::nanoseconds timeout) SYMBOL_VISIBLE;
+
 private:
 	friend MultiConnection<ARQConnection<ConnectionParameter>>;
 	/**
@@ -171,6 +270,55 @@ private:
 	 */
 	receive_queue_type receive_all() SYMBOL_VISIBLE;
 
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * The storage of the buffer is exchanged with the one of the receive queue, so that reusing
+	 * the buffer for subsequent receives keeps the allocated capacity of both.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer) SYMBOL_VISIBLE;
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive() SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message waiting for at most the given duration.
+	 * @param message Message to receive to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * If no message is available, wait for at most the given duration for at least one message or
+	 * the halt response to arrive.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the halt response was received and all messages up to it were received from the
+	 * receive queue, i.e. the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get whether the connection has no UT messages available to receive.
 	 * @return Boolean value
@@ -179,9 +327,36 @@ private:
 
 	/**
 	 * Start execution and wait until halt instruction is received from FPGA.
+	 * @throws ExecutionAborted On cancellation or exceeded execution timeout
 	 */
 	void run_until_halt() SYMBOL_VISIBLE;
 
+	/**
+	 * Abort the execution by discarding its responses received so far and its remaining
+	 * responses including the halt response, unless the halt response was received in the
+	 * meantime.
+	 * @param cancelled Whether the execution was cancelled instead of exceeding its deadline
+	 * @throws ExecutionAborted If the execution was aborted
+	 */
+	void abort_execution(bool cancelled);
+
+	/**
+	 * Send messages and wait for the given number of responses without halt handling.
+	 * The receive worker keeps polling for packets during the transaction and wakes the waiting
+	 * thread once responses are decoded.
+	 * Further responses remain in the receive queue.
+	 * @param messages Messages to send
+	 * @param responses Buffer to receive responses into, replacing its content
+	 * @param num_responses Number of responses to wait for
+	 * @param timeout Maximal duration to wait for the responses
+	 * @throws std::runtime_error On timeout
+	 */
+	void transact(
+	    std::vector<send_message_type> const& messages,
+	    receive_queue_type& responses,
+	    size_t num_responses,
+	    std::chrono::nanoseconds timeout) SYMBOL_VISIBLE;
+
 	/**
 	 * Get internal mutex to use for mutual exclusion.
 	 * @return Mutable reference to mutex
@@ -226,6 +401,12 @@ private:
 	typedef sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube> arq_stream_type;
 	std::unique_ptr<arq_stream_type> m_arq_stream;
 
+	/**
+	 * Accumulator of wire information, allocated separately to be referenced by the send queue
+	 * and its send thread like the ARQ stream.
+	 */
+	std::unique_ptr<ConnectionWireAccumulator> m_wire_accumulator;
+
 	typedef sctrltp::packet<sctrltp::ParametersFcpBss2Cube>::entry_t subpacket_type;
 
 	static_assert(
@@ -238,15 +419,32 @@ private:
 	struct SendQueue
 	{
 	public:
-		SendQueue(arq_stream_type& arq_stream);
+		typedef sctrltp::packet<sctrltp::ParametersFcpBss2Cube> packet_type;
+
+		SendQueue(arq_stream_type& arq_stream, ConnectionWireAccumulator& wire_accumulator);
 
 		void push(subpacket_type const& subpacket);
 
 		void flush();
 
+		void set_capacity(size_t capacity);
+
+		size_t get_capacity() const;
+
 	private:
+		/**
+		 * Send packet accounting for it in the wire information.
+		 */
+		static void send(
+		    arq_stream_type& arq_stream,
+		    ConnectionWireAccumulator& wire_accumulator,
+		    packet_type const& packet,
+		    typename arq_stream_type::Mode mode);
+
 		arq_stream_type& m_arq_stream;
-		sctrltp::packet<sctrltp::ParametersFcpBss2Cube> m_packet;
+		ConnectionWireAccumulator& m_wire_accumulator;
+		packet_type m_packet;
+		std::unique_ptr<AsyncSendQueue<packet_type>> m_async_send_queue;
 	};
 
 	typedef SendQueue send_queue_type;
@@ -256,7 +454,12 @@ private:
 	encoder_type m_encoder;
 
 	mutable std::mutex m_receive_queue_mutex;
+	std::condition_variable m_receive_queue_condition;
 	receive_queue_type m_receive_queue;
+	/**
+	 * Index of first message in receive queue not yet received.
+	 */
+	size_t m_receive_queue_front;
 
 	typedef ListenerHalt<UTMessage<
 	    ConnectionParameter::Receive::HeaderAlignment,
@@ -275,24 +478,34 @@ private:
 
 	log4cxx::LoggerPtr m_logger;
 
+	ReceiveWaiter m_receive_waiter;
+
+	mutable std::mutex m_thread_placement_mutex;
+	ThreadPlacement m_thread_placement;
+
 	void work_receive();
 	std::thread m_worker_receive;
 
 	std::mutex m_mutex;
 
-	typedef std::atomic<std::chrono::nanoseconds::rep> duration_type;
-	duration_type m_encode_duration{};
-	duration_type m_decode_duration{};
-	duration_type m_commit_duration{};
-	duration_type m_execution_duration{};
+	ConnectionTimeAccumulator m_time_accumulator;
 
-	// cached for performance reasons
-	mutable std::map<
-	    std::optional<std::string>,
-	    std::pair<std::filesystem::file_time_type, hwdb4cpp::database>>
-	    m_last_hwdb;
+	SignalOverrideIntTerm m_signal_override;
 
-	hwdb4cpp::database const& get_last_hwdb(std::optional<std::string> const& hwdb_path) const;
+	CancellationToken m_cancellation_token;
+	std::optional<std::chrono::nanoseconds> m_execution_timeout;
+	/**
+	 * Deadline of the running execution observed by the receive worker, which interrupts
+	 * run_until_halt on cancellation or exceeded deadline.
+	 */
+	std::atomic<std::chrono::steady_clock::time_point> m_execution_deadline;
+	std::atomic<bool> m_execution_running;
+
+	/**
+	 * Interrupt waiting for the halt response of a running execution, if it is cancelled or
+	 * exceeded its deadline.
+	 */
+	void check_execution_abort();
 };
 
 } // namespace hxcomm
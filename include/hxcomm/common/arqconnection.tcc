@@ -1,4 +1,3 @@
-#include "hate/timer.h"
 #include <yaml-cpp/yaml.h>
 
 #include <chrono>
@@ -9,14 +8,12 @@ template <typename ConnectionParameter>
 template <typename InputIterator>
 void ARQConnection<ConnectionParameter>::add(InputIterator const& begin, InputIterator const& end)
 {
-	hate::Timer timer;
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
 	}
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	m_encoder(begin, end);
-	auto const duration = timer.get_ns();
-	m_encode_duration.fetch_add(duration, std::memory_order_relaxed);
-	m_execution_duration.fetch_add(duration, std::memory_order_relaxed);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
 } // namespace hxcomm
@@ -1,23 +1,41 @@
 #include "hate/math.h"
-#include "hate/timer.h"
 #include "hwdb4cpp/hwdb4cpp.h"
 #include "hxcomm/common/fpga_ip_list.h"
+#include "hxcomm/common/hwdb_cache.h"
 #include "hxcomm/common/logger.h"
-#include "hxcomm/common/signal.h"
-#include <boost/asio/ip/address_v4.hpp>
 #include <yaml-cpp/yaml.h>
 
+#include <algorithm>
 #include <chrono>
-#include <filesystem>
+#include <sstream>
 
 namespace hxcomm {
 
 template <typename ConnectionParameter>
-ARQConnection<ConnectionParameter>::SendQueue::SendQueue(arq_stream_type& arq_stream) :
-    m_arq_stream(arq_stream), m_packet()
+ARQConnection<ConnectionParameter>::SendQueue::SendQueue(
+    arq_stream_type& arq_stream, ConnectionWireAccumulator& wire_accumulator) :
+    m_arq_stream(arq_stream),
+    m_wire_accumulator(wire_accumulator),
+    m_packet(),
+    m_async_send_queue()
 {
 	m_packet.len = 0;
 	m_packet.pid = pid;
+	set_capacity(get_send_queue_capacity_from_env());
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::SendQueue::send(
+    arq_stream_type& arq_stream,
+    ConnectionWireAccumulator& wire_accumulator,
+    packet_type const& packet,
+    typename arq_stream_type::Mode const mode)
+{
+	auto const time_begin = ConnectionWireAccumulator::clock_type::now();
+	arq_stream.send(packet, mode);
+	wire_accumulator.add_sent(
+	    packet.len, sctrltp::ParametersFcpBss2Cube::MAX_PDUWORDS,
+	    ConnectionWireAccumulator::clock_type::now() - time_begin);
 }
 
 template <typename ConnectionParameter>
@@ -26,8 +44,13 @@ void ARQConnection<ConnectionParameter>::SendQueue::push(subpacket_type const& s
 	m_packet.pdu[m_packet.len] = subpacket;
 	m_packet.len++;
 	if (m_packet.len == sctrltp::ParametersFcpBss2Cube::MAX_PDUWORDS) {
-		m_arq_stream.send(
-		    m_packet, sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube>::Mode::NOTHING);
+		if (m_async_send_queue) {
+			m_async_send_queue->push(m_packet);
+		} else {
+			send(
+			    m_arq_stream, m_wire_accumulator, m_packet,
+			    sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube>::Mode::NOTHING);
+		}
 		m_packet.len = 0;
 	}
 }
@@ -35,15 +58,48 @@ void ARQConnection<ConnectionParameter>::SendQueue::push(subpacket_type const& s
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::SendQueue::flush()
 {
-	if (m_packet.len) {
-		m_arq_stream.send(
-		    m_packet, sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube>::Mode::FLUSH);
+	if (m_async_send_queue) {
+		if (m_packet.len) {
+			m_async_send_queue->push(m_packet);
+			m_packet.len = 0;
+		}
+		// only waits for the tail of the queue still in transmission
+		m_async_send_queue->flush();
+	} else if (m_packet.len) {
+		send(
+		    m_arq_stream, m_wire_accumulator, m_packet,
+		    sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube>::Mode::FLUSH);
 		m_packet.len = 0;
 	} else {
 		m_arq_stream.flush();
 	}
 }
 
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::SendQueue::set_capacity(size_t const capacity)
+{
+	// sends all packets still in the queue
+	m_async_send_queue.reset();
+	if (capacity) {
+		auto& arq_stream = m_arq_stream;
+		auto& wire_accumulator = m_wire_accumulator;
+		m_async_send_queue = std::make_unique<AsyncSendQueue<packet_type>>(
+		    capacity,
+		    [&arq_stream, &wire_accumulator](packet_type const& packet) {
+			    send(
+			        arq_stream, wire_accumulator, packet,
+			        sctrltp::ARQStream<sctrltp::ParametersFcpBss2Cube>::Mode::NOTHING);
+		    },
+		    [&arq_stream]() { arq_stream.flush(); });
+	}
+}
+
+template <typename ConnectionParameter>
+size_t ARQConnection<ConnectionParameter>::SendQueue::get_capacity() const
+{
+	return m_async_send_queue ? m_async_send_queue->capacity() : 0;
+}
+
 template <typename ConnectionParameter>
 ARQConnection<ConnectionParameter>::ARQConnection(init_parameters_type const& params) :
     ARQConnection(std::get<0>(params))
@@ -54,73 +110,108 @@ template <typename ConnectionParameter>
 ARQConnection<ConnectionParameter>::ARQConnection() :
     m_registry(std::make_unique<Registry>(std::tuple{get_fpga_ip()})),
     m_arq_stream(std::make_unique<arq_stream_type>(std::get<0>(m_registry->m_parameters))),
-    m_send_queue(*m_arq_stream),
+    m_wire_accumulator(std::make_unique<ConnectionWireAccumulator>()),
+    m_send_queue(*m_arq_stream, *m_wire_accumulator),
     m_encoder(m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt),
     m_run_receive(true),
     m_logger(log4cxx::Logger::getLogger("hxcomm.ARQConnection")),
-    m_worker_receive()
+    m_receive_waiter(),
+    m_thread_placement_mutex(),
+    m_thread_placement(ThreadPlacement::from_env()),
+    m_worker_receive(),
+    m_signal_override(),
+    m_cancellation_token(),
+    m_execution_timeout(),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false)
 {
 	check_compatibility();
 	m_worker_receive = std::thread(&ARQConnection<ConnectionParameter>::work_receive, this);
+	m_thread_placement.apply(m_worker_receive.native_handle(), "ARQConnection receive");
 }
 
 template <typename ConnectionParameter>
 ARQConnection<ConnectionParameter>::ARQConnection(ip_t const ip) :
     m_registry(std::make_unique<Registry>(std::tuple{ip})),
     m_arq_stream(std::make_unique<arq_stream_type>(std::get<0>(m_registry->m_parameters))),
-    m_send_queue(*m_arq_stream),
+    m_wire_accumulator(std::make_unique<ConnectionWireAccumulator>()),
+    m_send_queue(*m_arq_stream, *m_wire_accumulator),
     m_encoder(m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt),
     m_run_receive(true),
     m_logger(log4cxx::Logger::getLogger("hxcomm.ARQConnection")),
-    m_worker_receive()
+    m_receive_waiter(),
+    m_thread_placement_mutex(),
+    m_thread_placement(ThreadPlacement::from_env()),
+    m_worker_receive(),
+    m_signal_override(),
+    m_cancellation_token(),
+    m_execution_timeout(),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false)
 {
 	HXCOMM_LOG_TRACE(m_logger, "ARQConnection(): ARQ connection startup initiated.");
 	check_compatibility();
 	m_worker_receive = std::thread(&ARQConnection<ConnectionParameter>::work_receive, this);
+	m_thread_placement.apply(m_worker_receive.native_handle(), "ARQConnection receive");
 }
 
 template <typename ConnectionParameter>
 ARQConnection<ConnectionParameter>::ARQConnection(ARQConnection&& other) :
     m_registry(),
     m_arq_stream(),
-    m_send_queue(other.m_send_queue),
+    m_wire_accumulator(),
+    m_send_queue(std::move(other.m_send_queue)),
     m_encoder(other.m_encoder, m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt), // temporary
     m_run_receive(true),
     m_logger(log4cxx::Logger::getLogger("hxcomm.ARQConnection")),
+    m_receive_waiter(other.m_receive_waiter.get_policy()),
+    m_thread_placement_mutex(),
+    m_thread_placement(other.get_thread_placement()),
     m_worker_receive(),
-    m_last_hwdb(std::move(other.m_last_hwdb))
+    m_signal_override(),
+    m_cancellation_token(other.m_cancellation_token),
+    m_execution_timeout(other.m_execution_timeout),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false)
 {
 	// shutdown other threads
 	other.m_run_receive = false;
+	other.m_receive_waiter.notify();
 	other.m_worker_receive.join();
-	m_encode_duration = other.m_encode_duration.load(std::memory_order_relaxed);
-	m_decode_duration = other.m_decode_duration.load(std::memory_order_relaxed);
-	m_commit_duration = other.m_commit_duration.load(std::memory_order_relaxed);
-	m_execution_duration = other.m_execution_duration.load(std::memory_order_relaxed);
+	m_time_accumulator = other.m_time_accumulator;
 	// move registry
 	m_registry = std::move(other.m_registry);
 	// move arq stream
 	m_arq_stream = std::move(other.m_arq_stream);
+	m_wire_accumulator = std::move(other.m_wire_accumulator);
 	// move queues
 	m_receive_queue.~receive_queue_type();
 	new (&m_receive_queue) decltype(m_receive_queue)(std::move(other.m_receive_queue));
+	m_receive_queue_front = other.m_receive_queue_front;
 	// create decoder
 	m_decoder.~decoder_type();
 	new (&m_decoder) decltype(m_decoder)(other.m_decoder, m_receive_queue, m_listener_halt);
 	// create and start threads
 	m_worker_receive = std::thread(&ARQConnection<ConnectionParameter>::work_receive, this);
+	m_thread_placement.apply(m_worker_receive.native_handle(), "ARQConnection receive");
 	HXCOMM_LOG_TRACE(m_logger, "ARQConnection(): ARQ connection startup initiated.");
 }
 
@@ -132,27 +223,33 @@ ARQConnection<ConnectionParameter>& ARQConnection<ConnectionParameter>::operator
 		// shutdown own threads
 		if (m_run_receive) {
 			m_run_receive = false;
+			m_receive_waiter.notify();
 			m_worker_receive.join();
 		}
 		m_run_receive = static_cast<bool>(other.m_run_receive);
 		// shutdown other threads
 		if (other.m_run_receive) {
 			other.m_run_receive = false;
+			other.m_receive_waiter.notify();
 			other.m_worker_receive.join();
 		}
-		m_encode_duration = other.m_encode_duration.load(std::memory_order_relaxed);
-		m_decode_duration = other.m_decode_duration.load(std::memory_order_relaxed);
-		m_commit_duration = other.m_commit_duration.load(std::memory_order_relaxed);
-		m_execution_duration = other.m_execution_duration.load(std::memory_order_relaxed);
+		m_receive_waiter.set_policy(other.m_receive_waiter.get_policy());
+		m_thread_placement = other.get_thread_placement();
+		m_time_accumulator = other.m_time_accumulator;
+		m_cancellation_token = other.m_cancellation_token;
+		m_execution_timeout = other.m_execution_timeout;
+		// shutdown own send queue before its arq stream is destroyed
+		m_send_queue.~send_queue_type();
 		// move registry
 		m_registry = std::move(other.m_registry);
 		// move arq stream
 		m_arq_stream = std::move(other.m_arq_stream);
+		m_wire_accumulator = std::move(other.m_wire_accumulator);
 		// move queues
-		m_send_queue.~send_queue_type();
-		new (&m_send_queue) send_queue_type(other.m_send_queue);
+		new (&m_send_queue) send_queue_type(std::move(other.m_send_queue));
 		m_receive_queue.~receive_queue_type();
 		new (&m_receive_queue) decltype(m_receive_queue)(std::move(other.m_receive_queue));
+		m_receive_queue_front = other.m_receive_queue_front;
 		// create decoder
 		m_decoder.~decoder_type();
 		new (&m_decoder) decltype(m_decoder)(other.m_decoder, m_receive_queue, m_listener_halt);
@@ -161,7 +258,7 @@ ARQConnection<ConnectionParameter>& ARQConnection<ConnectionParameter>::operator
 		new (&m_encoder) encoder_type(other.m_encoder, m_send_queue);
 		// create and start thread
 		m_worker_receive = std::thread(&ARQConnection<ConnectionParameter>::work_receive, this);
-		m_last_hwdb = std::move(other.m_last_hwdb);
+		m_thread_placement.apply(m_worker_receive.native_handle(), "ARQConnection receive");
 	}
 	return *this;
 }
@@ -171,6 +268,7 @@ ARQConnection<ConnectionParameter>::~ARQConnection()
 {
 	HXCOMM_LOG_TRACE(m_logger, "~ARQConnection(): Stopping ARQ connection.");
 	m_run_receive = false;
+	m_receive_waiter.notify();
 	if (m_worker_receive.joinable()) {
 		m_worker_receive.join();
 	}
@@ -185,29 +283,27 @@ std::mutex& ARQConnection<ConnectionParameter>::get_mutex()
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::add(send_message_type const& message)
 {
-	hate::Timer timer;
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
 	}
+	// only the encoding is accounted for, not the time spent by the caller between messages
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	std::visit([this](auto const& m) { m_encoder(m); }, message);
-	auto const duration = timer.get_ns();
-	m_encode_duration.fetch_add(duration, std::memory_order_relaxed);
-	m_execution_duration.fetch_add(duration, std::memory_order_relaxed);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::commit()
 {
-	hate::Timer timer;
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
 	}
 	m_encoder.flush();
 	m_send_queue.flush();
-	auto const duration = timer.get_ns();
-	m_commit_duration.fetch_add(duration, std::memory_order_relaxed);
-	// Issue #3583 : Execution already starts upon sending
-	m_execution_duration.fetch_add(duration, std::memory_order_relaxed);
+	// responses are to be expected
+	m_receive_waiter.notify();
+	m_time_accumulator.commit.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
 template <typename ConnectionParameter>
@@ -215,11 +311,94 @@ typename ARQConnection<ConnectionParameter>::receive_queue_type
 ARQConnection<ConnectionParameter>::receive_all()
 {
 	receive_queue_type all;
-	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	std::swap(all, m_receive_queue);
+	receive_into(all);
 	return all;
 }
 
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::receive_into(receive_queue_type& buffer)
+{
+	buffer.clear();
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == 0) {
+		std::swap(buffer, m_receive_queue);
+	} else {
+		buffer.assign(
+		    std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+		    std::make_move_iterator(m_receive_queue.end()));
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+}
+
+template <typename ConnectionParameter>
+typename ARQConnection<ConnectionParameter>::receive_message_type
+ARQConnection<ConnectionParameter>::receive()
+{
+	receive_message_type message;
+	if (!try_receive(message)) {
+		throw std::runtime_error("Trying to receive from empty receive queue.");
+	}
+	return message;
+}
+
+template <typename ConnectionParameter>
+bool ARQConnection<ConnectionParameter>::try_receive(receive_message_type& message)
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		return false;
+	}
+	message = std::move(m_receive_queue[m_receive_queue_front]);
+	m_receive_queue_front++;
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+	return true;
+}
+
+template <typename ConnectionParameter>
+bool ARQConnection<ConnectionParameter>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const timeout)
+{
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (!m_receive_queue_condition.wait_for(lock, timeout, [this] {
+			    return m_receive_queue_front != m_receive_queue.size();
+		    })) {
+			return false;
+		}
+	}
+	return try_receive(message);
+}
+
+template <typename ConnectionParameter>
+size_t ARQConnection<ConnectionParameter>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const timeout)
+{
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	m_receive_queue_condition.wait_for(lock, timeout, [this] {
+		return (m_receive_queue_front != m_receive_queue.size()) || m_listener_halt.get();
+	});
+	size_t const count = m_receive_queue.size() - m_receive_queue_front;
+	buffer.insert(
+	    buffer.end(), std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+	    std::make_move_iterator(m_receive_queue.end()));
+	m_receive_queue.clear();
+	m_receive_queue_front = 0;
+	return count;
+}
+
+template <typename ConnectionParameter>
+bool ARQConnection<ConnectionParameter>::receive_halted() const
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_listener_halt.get() && (m_receive_queue_front == m_receive_queue.size());
+}
+
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::work_receive()
 {
@@ -230,20 +409,35 @@ void ARQConnection<ConnectionParameter>::work_receive()
 			HXCOMM_LOG_TRACE(m_logger, "Receiving new packet.");
 			m_arq_stream->receive(packet);
 			HXCOMM_LOG_TRACE(m_logger, "Received packet #" << packet.seq);
+			m_wire_accumulator->add_received(packet.len);
 			if (packet.pid != pid) {
 				std::stringstream ss;
 				ss << "Unknown HostARQ packet ID received: " << packet.pid;
 				throw std::runtime_error(ss.str());
 			}
 			HXCOMM_LOG_TRACE(m_logger, "Forwarding packet contents to decoder-coroutine..");
-			hate::Timer timer;
+			auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 			{
 				std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+				bool const discarding = m_listener_halt.is_discarding();
+				size_t const num_discarded = m_listener_halt.get_num_discarded();
+				size_t const size = m_receive_queue.size();
 				m_decoder(packet.begin(), packet.end());
+				if (discarding) {
+					m_listener_halt.erase_discarded(
+					    m_receive_queue, size,
+					    m_listener_halt.get_num_discarded() - num_discarded);
+				}
 			}
-			m_decode_duration.fetch_add(timer.get_ns(), std::memory_order_release);
+			m_receive_queue_condition.notify_all();
+			m_time_accumulator.decode.add(
+			    ConnectionTimeAccumulator::clock_type::now() - time_begin);
 			HXCOMM_LOG_TRACE(m_logger, "Forwarded packet contents to decoder-coroutine.");
+			m_receive_waiter.reset();
+			check_execution_abort();
 		}
+		check_execution_abort();
+		m_receive_waiter.wait();
 	}
 	HXCOMM_LOG_TRACE(m_logger, "work_receive() terminating..");
 }
@@ -252,38 +446,139 @@ template <typename ConnectionParameter>
 bool ARQConnection<ConnectionParameter>::receive_empty() const
 {
 	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	return m_receive_queue.empty();
+	return m_receive_queue_front == m_receive_queue.size();
 }
 
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::run_until_halt()
 {
-	using namespace std::literals::chrono_literals;
-
-	hate::Timer timer;
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
 	}
-	SignalOverrideIntTerm signal_override;
+	m_execution_deadline.store(
+	    m_execution_timeout ? (std::chrono::steady_clock::now() + *m_execution_timeout)
+	                        : std::chrono::steady_clock::time_point::max(),
+	    std::memory_order_relaxed);
+	auto const interrupts = m_listener_halt.get_interrupts();
+	m_execution_running.store(true, std::memory_order_release);
+	bool halted;
+	{
+		// keep receive worker from blocking until halt is received
+		ReceiveWaiter::Active receive_active(m_receive_waiter);
+
+		// woken up by the receive worker upon decoding the halt response or upon interruption
+		// by cancellation or exceeded deadline
+		halted = m_listener_halt.wait(interrupts);
+		m_execution_running.store(false, std::memory_order_release);
+	}
+	if (halted) {
+		m_listener_halt.reset();
+	} else {
+		abort_execution(m_cancellation_token.is_cancelled());
+	}
+	m_time_accumulator.execution.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+}
 
-	auto wait_period = 1us;
-	constexpr std::chrono::microseconds max_wait_period = 10ms;
-	while (!m_listener_halt.get()) {
-		std::this_thread::sleep_for(wait_period);
-		wait_period = std::min(wait_period * 2, max_wait_period);
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::check_execution_abort()
+{
+	if (!m_execution_running.load(std::memory_order_acquire)) {
+		return;
+	}
+	if (!m_cancellation_token.is_cancelled() &&
+	    (std::chrono::steady_clock::now() <
+	     m_execution_deadline.load(std::memory_order_relaxed))) {
+		return;
+	}
+	// only interrupt once per execution
+	if (m_execution_running.exchange(false, std::memory_order_acq_rel)) {
+		m_listener_halt.interrupt();
 	}
-	m_listener_halt.reset();
-	m_execution_duration += timer.get_ns();
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::abort_execution(bool const cancelled)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (m_listener_halt.consume_or_discard()) {
+			// the halt response arrived in the meantime, the execution is complete
+			return;
+		}
+		// responses of the aborted execution are not to be received, the ones still to arrive
+		// are discarded by the receive worker up to and including the halt response
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+	HXCOMM_LOG_WARN(
+	    m_logger, "run_until_halt(): Execution aborted, discarding its remaining responses.");
+	throw ExecutionAborted(
+	    cancelled ? "Execution was cancelled." : "Execution exceeded its timeout.");
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::transact(
+    std::vector<send_message_type> const& messages,
+    receive_queue_type& responses,
+    size_t const num_responses,
+    std::chrono::nanoseconds const timeout)
+{
+	// keep receive worker from blocking until all responses are received
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+
+	add(messages.begin(), messages.end());
+	commit();
+
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+	auto const deadline = std::chrono::steady_clock::now() + timeout;
+	responses.clear();
+	while (responses.size() < num_responses) {
+		{
+			// block until the receive worker decoded responses instead of competing with it for
+			// the receive queue mutex
+			std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+			m_receive_queue_condition.wait_until(lock, deadline, [this] {
+				return m_receive_queue_front != m_receive_queue.size();
+			});
+			size_t const count = std::min(
+			    num_responses - responses.size(), m_receive_queue.size() - m_receive_queue_front);
+			auto const begin = m_receive_queue.begin() + m_receive_queue_front;
+			responses.insert(
+			    responses.end(), std::make_move_iterator(begin),
+			    std::make_move_iterator(begin + count));
+			m_receive_queue_front += count;
+			if (m_receive_queue_front == m_receive_queue.size()) {
+				m_receive_queue.clear();
+				m_receive_queue_front = 0;
+			}
+		}
+		if ((responses.size() < num_responses) && (std::chrono::steady_clock::now() > deadline)) {
+			std::stringstream ss;
+			ss << "Timeout while waiting for responses of transaction, received "
+			   << responses.size() << " of " << num_responses << ".";
+			throw std::runtime_error(ss.str());
+		}
+	}
+	m_time_accumulator.execution.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
 template <typename ConnectionParameter>
 ConnectionTimeInfo ARQConnection<ConnectionParameter>::get_time_info() const
 {
-	return ConnectionTimeInfo{
-	    std::chrono::nanoseconds(m_encode_duration.load(std::memory_order_relaxed)),
-	    std::chrono::nanoseconds(m_decode_duration.load(std::memory_order_acquire)),
-	    std::chrono::nanoseconds(m_commit_duration.load(std::memory_order_relaxed)),
-	    std::chrono::nanoseconds(m_execution_duration.load(std::memory_order_relaxed))};
+	auto time_info = m_time_accumulator.get();
+	// Issue #3583 : Execution already starts upon sending
+	time_info.execution_duration += time_info.encode_duration + time_info.commit_duration;
+	return time_info;
+}
+
+template <typename ConnectionParameter>
+ConnectionWireInfo ARQConnection<ConnectionParameter>::get_wire_info() const
+{
+	if (!m_wire_accumulator) {
+		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
+	}
+	return m_wire_accumulator->get();
 }
 
 template <typename ConnectionParameter>
@@ -293,45 +588,17 @@ std::string ARQConnection<ConnectionParameter>::get_unique_identifier(
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to empty instance.");
 	}
-	auto const ip = boost::asio::ip::make_address_v4(m_arq_stream->get_remote_ip());
-
-	auto const& hwdb = get_last_hwdb(hwdb_path);
-	std::optional<std::variant<hwdb4cpp::HXCubeSetupEntry, hwdb4cpp::JboaSetupEntry>> entry;
-	size_t fcp = 0;
-	auto const hxcube_ids = hwdb.get_hxcube_ids();
-	for (auto const& id : hxcube_ids) {
-		auto const& local_entry = hwdb.get_hxcube_setup_entry(id);
-		for (auto const& [f, e] : local_entry.fpgas) {
-			if (e.ip == ip) {
-				fcp = f;
-				entry = local_entry;
-				break;
-			}
-		}
-	}
-	auto const jboa_ids = hwdb.get_jboa_ids();
-	for (auto const& id : jboa_ids) {
-		auto const& local_entry = hwdb.get_jboa_setup_entry(id);
-		for (auto const& [f, e] : local_entry.fpgas) {
-			if (e.ip == ip) {
-				fcp = f;
-				entry = local_entry;
-				break;
-			}
-		}
-	}
-	if (!entry) {
-		throw std::out_of_range("Setup not found in hwdb.");
-	}
+	auto const location =
+	    HwdbCache::get_instance().get_fpga_location(m_arq_stream->get_remote_ip(), hwdb_path);
 	return std::visit(
-	    [fcp](auto const& entry) {
+	    [fcp = location.fcp](auto const& entry) {
 		    if (!entry.fpgas.at(fcp).wing) {
 			    throw std::runtime_error("No chip present.");
 		    }
 		    return entry.get_unique_branch_identifier(
 		        entry.fpgas.at(fcp).wing.value().handwritten_chip_serial);
 	    },
-	    *entry);
+	    location.setup_entry);
 }
 
 template <typename ConnectionParameter>
@@ -340,42 +607,13 @@ HwdbEntry ARQConnection<ConnectionParameter>::get_hwdb_entry() const
 	if (!m_arq_stream) {
 		throw std::runtime_error("Unexpected access to empty instance.");
 	}
-	auto const ip = boost::asio::ip::make_address_v4(m_arq_stream->get_remote_ip());
-
-	auto const& hwdb = get_last_hwdb(std::nullopt);
-	std::optional<std::variant<hwdb4cpp::HXCubeSetupEntry, hwdb4cpp::JboaSetupEntry>> entry;
-	size_t fcp = 0;
-	auto const hxcube_ids = hwdb.get_hxcube_ids();
-	for (auto const& id : hxcube_ids) {
-		auto const& local_entry = hwdb.get_hxcube_setup_entry(id);
-		for (auto const& [f, e] : local_entry.fpgas) {
-			if (e.ip == ip) {
-				fcp = f;
-				entry = local_entry;
-				break;
-			}
-		}
-	}
-	auto const jboa_ids = hwdb.get_jboa_ids();
-	for (auto const& id : jboa_ids) {
-		auto const& local_entry = hwdb.get_jboa_setup_entry(id);
-		for (auto const& [f, e] : local_entry.fpgas) {
-			if (e.ip == ip) {
-				fcp = f;
-				entry = local_entry;
-				break;
-			}
-		}
-	}
-	if (!entry) {
-		throw std::out_of_range("Setup not found in hwdb.");
-	}
+	auto location = HwdbCache::get_instance().get_fpga_location(m_arq_stream->get_remote_ip());
 	return std::visit(
-	    [fcp](auto& entry) -> HwdbEntry {
+	    [fcp = location.fcp](auto& entry) -> HwdbEntry {
 		    entry.fpgas = {{fcp, entry.fpgas.at(fcp)}};
 		    return entry;
 	    },
-	    *entry);
+	    location.setup_entry);
 }
 
 template <typename ConnectionParameter>
@@ -393,6 +631,88 @@ std::string ARQConnection<ConnectionParameter>::get_remote_repo_state() const
 	return "";
 }
 
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::set_receive_wait_policy(ReceiveWaitPolicy const& policy)
+{
+	m_receive_waiter.set_policy(policy);
+	HXCOMM_LOG_DEBUG(m_logger, "set_receive_wait_policy(): Using " << policy << ".");
+}
+
+template <typename ConnectionParameter>
+ReceiveWaitPolicy ARQConnection<ConnectionParameter>::get_receive_wait_policy() const
+{
+	return m_receive_waiter.get_policy();
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::set_send_queue_capacity(size_t const capacity)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_arq_stream) {
+		throw std::runtime_error("Unexpected access to moved-from ARQConnection.");
+	}
+	m_send_queue.set_capacity(capacity);
+}
+
+template <typename ConnectionParameter>
+size_t ARQConnection<ConnectionParameter>::get_send_queue_capacity() const
+{
+	return m_send_queue.get_capacity();
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::set_thread_placement(ThreadPlacement const& placement)
+{
+	std::lock_guard<std::mutex> lock(m_thread_placement_mutex);
+	m_thread_placement = placement;
+	if (m_worker_receive.joinable()) {
+		m_thread_placement.apply(m_worker_receive.native_handle(), "ARQConnection receive");
+	}
+}
+
+template <typename ConnectionParameter>
+ThreadPlacement ARQConnection<ConnectionParameter>::get_thread_placement() const
+{
+	std::lock_guard<std::mutex> lock(m_thread_placement_mutex);
+	return m_thread_placement;
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::set_execution_timeout(
+    std::optional<std::chrono::nanoseconds> const timeout)
+{
+	m_execution_timeout = timeout;
+}
+
+template <typename ConnectionParameter>
+std::optional<std::chrono::nanoseconds> ARQConnection<ConnectionParameter>::get_execution_timeout()
+    const
+{
+	return m_execution_timeout;
+}
+
+template <typename ConnectionParameter>
+void ARQConnection<ConnectionParameter>::set_cancellation_token(CancellationToken const& token)
+{
+	m_cancellation_token = token;
+}
+
+template <typename ConnectionParameter>
+CancellationToken ARQConnection<ConnectionParameter>::get_cancellation_token() const
+{
+	return m_cancellation_token;
+}
+
+template <typename ConnectionParameter>
+bool ARQConnection<ConnectionParameter>::wait_discarded(std::chrono::nanoseconds const timeout)
+{
+	// keep receive worker from blocking until the halt responses are received
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_receive_queue_condition.wait_for(
+	    lock, timeout, [this] { return !m_listener_halt.is_discarding(); });
+}
+
 template <typename ConnectionParameter>
 void ARQConnection<ConnectionParameter>::check_compatibility() const
 {
@@ -439,20 +759,4 @@ size_t ARQConnection<ConnectionParameter>::get_newest_supported_compatible_until
 	}
 }
 
-template <typename ConnectionParameter>
-hwdb4cpp::database const& ARQConnection<ConnectionParameter>::get_last_hwdb(
-    std::optional<std::string> const& hwdb_path) const
-{
-	auto const current_hwdb_write_time =
-	    std::filesystem::last_write_time(hwdb4cpp::database::get_default_path());
-	if (!m_last_hwdb.contains(hwdb_path) ||
-	    current_hwdb_write_time != m_last_hwdb.at(hwdb_path).first) {
-		auto& last_hwdb = m_last_hwdb[hwdb_path];
-		last_hwdb.second = hwdb4cpp::database();
-		last_hwdb.second.load(hwdb_path ? *hwdb_path : hwdb4cpp::database::get_default_path());
-		last_hwdb.first = current_hwdb_write_time;
-	}
-	return m_last_hwdb.at(hwdb_path).second;
-}
-
 } // namespace hxcomm
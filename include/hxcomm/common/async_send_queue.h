@@ -0,0 +1,104 @@
+#pragma once
+#include "hate/visibility.h"
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hxcomm {
+
+/**
+ * Get capacity of asynchronous send queues of connections from environment.
+ * The capacity is read from HXCOMM_SEND_QUEUE_CAPACITY in number of packets, defaults to zero
+ * (sending inline without separate send thread) if not set.
+ * @throws std::runtime_error On invalid capacity in environment
+ * @return Capacity
+ */
+size_t get_send_queue_capacity_from_env() SYMBOL_VISIBLE;
+
+/**
+ * Bounded queue of filled packets transmitted by a dedicated send thread.
+ * Pushing a packet blocks only while the queue is full, i.e. while the backend is not able to
+ * accept further data, so that the production of packets overlaps with their transmission.
+ * Exceptions thrown by the backend in the send thread are rethrown on the next push() or flush().
+ * Only a single producer thread is supported.
+ * @tparam Packet Packet type
+ */
+template <typename Packet>
+class AsyncSendQueue
+{
+public:
+	typedef Packet packet_type;
+	typedef std::function<void(packet_type const&)> send_type;
+	typedef std::function<void()> flush_type;
+
+	/**
+	 * Construct queue and start send thread.
+	 * @param capacity Maximal number of packets in the queue
+	 * @param send Function sending a single packet to the backend
+	 * @param flush Function flushing the backend
+	 * @throws std::runtime_error On zero capacity
+	 */
+	AsyncSendQueue(size_t capacity, send_type send, flush_type flush);
+
+	AsyncSendQueue(AsyncSendQueue const&) = delete;
+	AsyncSendQueue& operator=(AsyncSendQueue const&) = delete;
+
+	/**
+	 * Send all remaining packets and stop send thread.
+	 */
+	~AsyncSendQueue();
+
+	/**
+	 * Add packet to the queue.
+	 * Blocks while the queue is full.
+	 * @param packet Packet to add
+	 */
+	void push(packet_type const& packet);
+
+	/**
+	 * Flush the backend after all packets in the queue are sent.
+	 * Blocks until the backend is flushed.
+	 */
+	void flush();
+
+	/**
+	 * Get maximal number of packets in the queue.
+	 * @return Capacity
+	 */
+	size_t capacity() const;
+
+private:
+	void work_send();
+
+	/**
+	 * Rethrow exception of send thread, expects lock of m_mutex.
+	 */
+	void rethrow();
+
+	send_type m_send;
+	flush_type m_flush;
+
+	/**
+	 * Ring buffer of packets, of which m_size packets starting at m_front are to be sent.
+	 */
+	std::vector<packet_type> m_packets;
+	size_t m_front;
+	size_t m_size;
+	bool m_flush_requested;
+	bool m_run;
+	std::exception_ptr m_exception;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition_send;
+	std::condition_variable m_condition_push;
+
+	std::thread m_worker_send;
+};
+
+} // namespace hxcomm
+
+#include "hxcomm/common/async_send_queue.tcc"
@@ -0,0 +1,117 @@
+#include <stdexcept>
+#include <utility>
+
+namespace hxcomm {
+
+template <typename Packet>
+AsyncSendQueue<Packet>::AsyncSendQueue(size_t const capacity, send_type send, flush_type flush) :
+    m_send(std::move(send)),
+    m_flush(std::move(flush)),
+    m_packets(capacity),
+    m_front(0),
+    m_size(0),
+    m_flush_requested(false),
+    m_run(true),
+    m_exception(),
+    m_mutex(),
+    m_condition_send(),
+    m_condition_push(),
+    m_worker_send()
+{
+	if (capacity == 0) {
+		throw std::runtime_error("AsyncSendQueue requires non-zero capacity.");
+	}
+	m_worker_send = std::thread(&AsyncSendQueue<Packet>::work_send, this);
+}
+
+template <typename Packet>
+AsyncSendQueue<Packet>::~AsyncSendQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_run = false;
+	}
+	m_condition_send.notify_one();
+	m_worker_send.join();
+}
+
+template <typename Packet>
+void AsyncSendQueue<Packet>::push(packet_type const& packet)
+{
+	size_t back;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition_push.wait(lock, [this] { return (m_size < m_packets.size()) || m_exception; });
+		rethrow();
+		back = (m_front + m_size) % m_packets.size();
+	}
+	// the send thread only accesses the first m_size packets, so the back slot is free to fill
+	m_packets[back] = packet;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_size++;
+	}
+	m_condition_send.notify_one();
+}
+
+template <typename Packet>
+void AsyncSendQueue<Packet>::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_flush_requested = true;
+	m_condition_send.notify_one();
+	m_condition_push.wait(
+	    lock, [this] { return (!m_flush_requested && (m_size == 0)) || m_exception; });
+	rethrow();
+}
+
+template <typename Packet>
+size_t AsyncSendQueue<Packet>::capacity() const
+{
+	return m_packets.size();
+}
+
+template <typename Packet>
+void AsyncSendQueue<Packet>::rethrow()
+{
+	if (m_exception) {
+		std::rethrow_exception(std::exchange(m_exception, nullptr));
+	}
+}
+
+template <typename Packet>
+void AsyncSendQueue<Packet>::work_send()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_condition_send.wait(lock, [this] { return m_size || m_flush_requested || !m_run; });
+		try {
+			if (m_size) {
+				lock.unlock();
+				m_send(m_packets[m_front]);
+				lock.lock();
+				m_front = (m_front + 1) % m_packets.size();
+				m_size--;
+			} else if (m_flush_requested) {
+				lock.unlock();
+				m_flush();
+				lock.lock();
+				m_flush_requested = false;
+			} else {
+				break;
+			}
+		} catch (...) {
+			if (!lock.owns_lock()) {
+				lock.lock();
+			}
+			// drop queue content, the connection is unusable after a failed send
+			m_exception = std::current_exception();
+			m_front = 0;
+			m_size = 0;
+			m_flush_requested = false;
+		}
+		m_condition_push.notify_one();
+	}
+}
+
+} // namespace hxcomm
@@ -0,0 +1,53 @@
+#pragma once
+#include "hate/visibility.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace hxcomm {
+
+/**
+ * Token to cancel executions of connections from other threads.
+ * Copies share their state, so that a copy handed to a connection is cancelled by cancelling
+ * any other copy. A cancelled token stays cancelled until reset.
+ */
+class CancellationToken
+{
+public:
+	/**
+	 * Construct token in not cancelled state.
+	 */
+	CancellationToken() SYMBOL_VISIBLE;
+
+	/**
+	 * Cancel running and future executions observing the token.
+	 * May be called from any thread.
+	 */
+	void cancel() SYMBOL_VISIBLE;
+
+	/**
+	 * Reset token to not cancelled state.
+	 */
+	void reset() SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the token is cancelled.
+	 * @return Boolean value
+	 */
+	bool is_cancelled() const SYMBOL_VISIBLE;
+
+private:
+	std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/**
+ * Exception thrown by run_until_halt if the execution was cancelled or exceeded its deadline.
+ * The connection discards the remaining responses of the aborted execution and stays usable.
+ */
+class ExecutionAborted : public std::runtime_error
+{
+public:
+	using std::runtime_error::runtime_error;
+};
+
+} // namespace hxcomm
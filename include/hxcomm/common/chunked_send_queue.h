@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+
+namespace hxcomm {
+
+/**
+ * Contiguous queue of words sent to a backend in chunks of bounded size upon flush.
+ * Sending chunks instead of single words reduces the number of transfers, e.g. remote procedure
+ * calls to the simulator, which dominate the transfer time for small amounts of data.
+ * The allocated capacity is kept over flushes.
+ * @tparam Buffer Contiguous container of words accepted by the backend
+ */
+template <typename Buffer>
+class ChunkedSendQueue
+{
+public:
+	typedef Buffer buffer_type;
+	typedef typename buffer_type::value_type word_type;
+
+	/**
+	 * Default number of words per chunk.
+	 */
+	static constexpr size_t default_chunk_size = 1 << 16;
+
+	/**
+	 * Construct empty queue.
+	 * @param chunk_size Maximal number of words per chunk
+	 * @throws std::runtime_error On zero chunk size
+	 */
+	explicit ChunkedSendQueue(size_t chunk_size = default_chunk_size);
+
+	/**
+	 * Add word to the queue.
+	 * @param word Word to add
+	 */
+	void push(word_type const& word);
+
+	/**
+	 * Send all words in the queue in chunks.
+	 * Words of chunks not sent due to an exception of the backend remain in the queue.
+	 * @tparam Send Function type
+	 * @param send Function sending a single chunk to the backend, invoked as `send(chunk)`
+	 */
+	template <typename Send>
+	void flush(Send&& send);
+
+	/**
+	 * Get number of words in the queue.
+	 * @return Number of words
+	 */
+	size_t size() const;
+
+	/**
+	 * Get whether the queue is empty.
+	 * @return Boolean value
+	 */
+	bool empty() const;
+
+	/**
+	 * Set maximal number of words per chunk.
+	 * @param chunk_size Chunk size
+	 * @throws std::runtime_error On zero chunk size
+	 */
+	void set_chunk_size(size_t chunk_size);
+
+	/**
+	 * Get maximal number of words per chunk.
+	 * @return Chunk size
+	 */
+	size_t get_chunk_size() const;
+
+private:
+	buffer_type m_buffer;
+	buffer_type m_chunk;
+	size_t m_chunk_size;
+};
+
+} // namespace hxcomm
+
+#include "hxcomm/common/chunked_send_queue.tcc"
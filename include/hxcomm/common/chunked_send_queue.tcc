@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <stdexcept>
+
+namespace hxcomm {
+
+template <typename Buffer>
+ChunkedSendQueue<Buffer>::ChunkedSendQueue(size_t const chunk_size) :
+    m_buffer(), m_chunk(), m_chunk_size(0)
+{
+	set_chunk_size(chunk_size);
+}
+
+template <typename Buffer>
+void ChunkedSendQueue<Buffer>::push(word_type const& word)
+{
+	m_buffer.push_back(word);
+}
+
+template <typename Buffer>
+template <typename Send>
+void ChunkedSendQueue<Buffer>::flush(Send&& send)
+{
+	// common case of a single chunk is sent without copy
+	if (m_buffer.size() <= m_chunk_size) {
+		if (!m_buffer.empty()) {
+			send(static_cast<buffer_type const&>(m_buffer));
+		}
+		m_buffer.clear();
+		return;
+	}
+	auto begin = m_buffer.begin();
+	try {
+		while (begin != m_buffer.end()) {
+			auto const end =
+			    begin + std::min(m_chunk_size, static_cast<size_t>(m_buffer.end() - begin));
+			m_chunk.assign(begin, end);
+			send(static_cast<buffer_type const&>(m_chunk));
+			begin = end;
+		}
+	} catch (...) {
+		m_buffer.erase(m_buffer.begin(), begin);
+		throw;
+	}
+	m_buffer.clear();
+}
+
+template <typename Buffer>
+size_t ChunkedSendQueue<Buffer>::size() const
+{
+	return m_buffer.size();
+}
+
+template <typename Buffer>
+bool ChunkedSendQueue<Buffer>::empty() const
+{
+	return m_buffer.empty();
+}
+
+template <typename Buffer>
+void ChunkedSendQueue<Buffer>::set_chunk_size(size_t const chunk_size)
+{
+	if (!chunk_size) {
+		throw std::runtime_error("ChunkedSendQueue requires non-zero chunk size.");
+	}
+	m_chunk_size = chunk_size;
+}
+
+template <typename Buffer>
+size_t ChunkedSendQueue<Buffer>::get_chunk_size() const
+{
+	return m_chunk_size;
+}
+
+} // namespace hxcomm
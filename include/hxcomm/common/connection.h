@@ -110,6 +110,14 @@ struct MessageTypes
 	    typename ConnectionParameter::SendHalt>
 	    send_halt_type;
 
+	typedef typename hxcomm::UTMessage<
+	    ConnectionParameter::Receive::HeaderAlignment,
+	    typename ConnectionParameter::Receive::SubwordType,
+	    typename ConnectionParameter::Receive::PhywordType,
+	    typename ConnectionParameter::Receive::Dictionary,
+	    typename ConnectionParameter::ReceiveHalt>
+	    receive_halt_type;
+
 	using connection_parameter_type = ConnectionParameter;
 };
 
@@ -19,11 +19,9 @@ template <typename Connection>
 std::set<typename ConnectionRegistry<Connection>::Parameters>&
 ConnectionRegistry<Connection>::registry()
 {
-	static std::set<Parameters>* storage = nullptr;
-	if (!storage) {
-		storage = new std::set<Parameters>();
-	}
-	assert(storage);
+	// initialization is thread-safe, storage is never destroyed to allow for deregistration of
+	// connections destroyed during static destruction
+	static std::set<Parameters>* storage = new std::set<Parameters>();
 	return *storage;
 }
 
@@ -0,0 +1,138 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/connection_time_info.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(HXCOMM_TIME_INFO_TSC) && !defined(HXCOMM_DISABLE_TIME_INFO)
+#if !defined(__x86_64__)
+#error "Time-stamp counter based time information is only supported on x86_64."
+#endif
+#include <x86intrin.h>
+#endif
+
+namespace hxcomm {
+
+/**
+ * Clock used for accumulation of connection time information.
+ * By default, std::chrono::steady_clock is used.
+ * If HXCOMM_TIME_INFO_TSC is defined, the time-stamp counter of the CPU is read instead, which
+ * avoids the overhead of the system clock call and is converted to nanoseconds only upon readout.
+ * If HXCOMM_DISABLE_TIME_INFO is defined, no time is measured and all durations are zero.
+ */
+struct ConnectionTimeClock
+{
+	typedef uint64_t ticks_type;
+
+	/**
+	 * Get current point in time in clock ticks.
+	 * @return Clock ticks
+	 */
+	static ticks_type now()
+	{
+#if defined(HXCOMM_DISABLE_TIME_INFO)
+		return 0;
+#elif defined(HXCOMM_TIME_INFO_TSC)
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		    .count();
+#endif
+	}
+
+	/**
+	 * Calibrate conversion of clock ticks to duration once per process.
+	 * For the time-stamp counter, this takes about 10 ms on first invocation.
+	 */
+	static void calibrate() SYMBOL_VISIBLE;
+
+	/**
+	 * Convert number of clock ticks to duration.
+	 * @param ticks Clock ticks
+	 * @return Duration
+	 */
+	static std::chrono::nanoseconds to_duration(ticks_type ticks) SYMBOL_VISIBLE;
+};
+
+
+/**
+ * Accumulator of time information of a connection.
+ * Durations are accumulated in clock ticks and only converted upon readout.
+ * Every duration is only to be added to by one thread at a time, which allows updates without
+ * atomic read-modify-write operations.
+ * The decode duration, which is added to by the receive thread, is placed on a separate cache line
+ * from the durations added to by the thread using the connection.
+ */
+class ConnectionTimeAccumulator
+{
+public:
+	typedef ConnectionTimeClock clock_type;
+	typedef clock_type::ticks_type ticks_type;
+
+	/**
+	 * Size of a cache line used to separate durations added to by different threads.
+	 */
+	static constexpr size_t cache_line_size = 64;
+
+	/**
+	 * Accumulated duration with a single thread adding to it.
+	 */
+	class Duration
+	{
+	public:
+		/**
+		 * Add clock ticks to duration.
+		 * @param ticks Clock ticks to add
+		 */
+		void add(ticks_type const ticks)
+		{
+			m_ticks.store(m_ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_release);
+		}
+
+		/**
+		 * Get accumulated duration.
+		 * @return Duration
+		 */
+		std::chrono::nanoseconds get() const
+		{
+			return clock_type::to_duration(m_ticks.load(std::memory_order_acquire));
+		}
+
+		Duration& operator=(Duration const& other)
+		{
+			m_ticks.store(other.m_ticks.load(std::memory_order_acquire), std::memory_order_release);
+			return *this;
+		}
+
+	private:
+		std::atomic<ticks_type> m_ticks{0};
+	};
+
+	/**
+	 * Construct accumulator with zero durations.
+	 * Calibrates the clock if not already done, so that readout does not include calibration.
+	 */
+	ConnectionTimeAccumulator() { clock_type::calibrate(); }
+	ConnectionTimeAccumulator& operator=(ConnectionTimeAccumulator const& other) = default;
+
+	/**
+	 * Get accumulated time information.
+	 * @return Time information
+	 */
+	ConnectionTimeInfo get() const
+	{
+		return ConnectionTimeInfo{encode.get(), decode.get(), commit.get(), execution.get()};
+	}
+
+	alignas(cache_line_size) Duration decode;
+
+	alignas(cache_line_size) Duration encode;
+	Duration commit;
+	Duration execution;
+
+};
+
+} // namespace hxcomm
@@ -0,0 +1,113 @@
+#pragma once
+#include "hxcomm/common/connection_time_accumulator.h"
+#include "hxcomm/common/connection_wire_info.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hxcomm {
+
+/**
+ * Accumulator of transport-level information of a connection.
+ * Counters are only updated once per packet and, like the durations of the
+ * ConnectionTimeAccumulator, only added to by one thread at a time, which allows updates without
+ * atomic read-modify-write operations.
+ * The receive counters, which are added to by the receive thread, are placed on a separate cache
+ * line from the send counters.
+ */
+class ConnectionWireAccumulator
+{
+public:
+	typedef ConnectionTimeAccumulator::clock_type clock_type;
+	typedef ConnectionTimeAccumulator::Duration Duration;
+
+	/**
+	 * Accumulated count with a single thread adding to it.
+	 */
+	class Counter
+	{
+	public:
+		/**
+		 * Add to count.
+		 * @param value Value to add
+		 */
+		void add(uint64_t const value)
+		{
+			m_value.store(m_value.load(std::memory_order_relaxed) + value, std::memory_order_release);
+		}
+
+		/**
+		 * Get accumulated count.
+		 * @return Count
+		 */
+		uint64_t get() const { return m_value.load(std::memory_order_acquire); }
+
+		Counter& operator=(Counter const& other)
+		{
+			m_value.store(other.m_value.load(std::memory_order_acquire), std::memory_order_release);
+			return *this;
+		}
+
+	private:
+		std::atomic<uint64_t> m_value{0};
+	};
+
+	ConnectionWireAccumulator() = default;
+	ConnectionWireAccumulator& operator=(ConnectionWireAccumulator const& other) = default;
+
+	/**
+	 * Account for a sent packet.
+	 * @param num_words Number of payload words in the packet
+	 * @param capacity Maximal number of payload words in a packet, zero if unlimited
+	 * @param blocked Clock ticks spent blocked in sending the packet
+	 */
+	void add_sent(
+	    size_t const num_words, size_t const capacity, clock_type::ticks_type const blocked)
+	{
+		packets_sent.add(1);
+		words_sent.add(num_words);
+		words_capacity_sent.add(capacity);
+		if (num_words < capacity) {
+			partial_packets_sent.add(1);
+		}
+		send_blocked.add(blocked);
+	}
+
+	/**
+	 * Account for a received packet.
+	 * @param num_words Number of payload words in the packet
+	 */
+	void add_received(size_t const num_words)
+	{
+		packets_received.add(1);
+		words_received.add(num_words);
+	}
+
+	/**
+	 * Get accumulated transport-level information.
+	 * @return Wire information
+	 */
+	ConnectionWireInfo get() const
+	{
+		ConnectionWireInfo info;
+		info.num_packets_sent = packets_sent.get();
+		info.num_words_sent = words_sent.get();
+		info.num_words_capacity_sent = words_capacity_sent.get();
+		info.num_partial_packets_sent = partial_packets_sent.get();
+		info.num_packets_received = packets_received.get();
+		info.num_words_received = words_received.get();
+		info.send_blocked_duration = send_blocked.get();
+		return info;
+	}
+
+	alignas(ConnectionTimeAccumulator::cache_line_size) Counter packets_received;
+	Counter words_received;
+
+	alignas(ConnectionTimeAccumulator::cache_line_size) Counter packets_sent;
+	Counter words_sent;
+	Counter words_capacity_sent;
+	Counter partial_packets_sent;
+	Duration send_blocked;
+};
+
+} // namespace hxcomm
@@ -0,0 +1,80 @@
+#pragma once
+#include "hate/visibility.h"
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace cereal {
+struct access;
+} // namespace cereal
+
+namespace hxcomm {
+
+/**
+ * Transport-level information of a connection's history of usage.
+ * A packet is a single transfer to or from the backend, i.e. a HostARQ packet for
+ * ARQConnection and a single transfer to or from the simulator for SimConnection.
+ */
+struct ConnectionWireInfo
+{
+	/**
+	 * Number of packets sent to backend since construction.
+	 */
+	uint64_t num_packets_sent{};
+
+	/**
+	 * Number of payload words sent to backend since construction.
+	 */
+	uint64_t num_words_sent{};
+
+	/**
+	 * Number of payload words the sent packets could have carried since construction.
+	 * Zero if the backend does not limit the size of packets.
+	 */
+	uint64_t num_words_capacity_sent{};
+
+	/**
+	 * Number of packets sent before being completely filled, e.g. on commit, since construction.
+	 */
+	uint64_t num_partial_packets_sent{};
+
+	/**
+	 * Number of packets received from backend since construction.
+	 */
+	uint64_t num_packets_received{};
+
+	/**
+	 * Number of payload words received from backend since construction.
+	 */
+	uint64_t num_words_received{};
+
+	/**
+	 * Time spent blocked in sending packets to backend since construction, e.g. while the send
+	 * window of the HostARQ protocol is full.
+	 */
+	std::chrono::nanoseconds send_blocked_duration{};
+
+	/**
+	 * Get ratio of sent payload words to the capacity of sent packets.
+	 * @return Fill ratio in [0, 1], zero if no capacity applies
+	 */
+	double get_send_fill_ratio() const SYMBOL_VISIBLE;
+
+	friend std::ostream& operator<<(std::ostream& os, ConnectionWireInfo const& data)
+	    SYMBOL_VISIBLE;
+
+	ConnectionWireInfo& operator-=(ConnectionWireInfo const& other) SYMBOL_VISIBLE;
+	ConnectionWireInfo operator-(ConnectionWireInfo const& other) const SYMBOL_VISIBLE;
+	ConnectionWireInfo& operator+=(ConnectionWireInfo const& other) SYMBOL_VISIBLE;
+	ConnectionWireInfo operator+(ConnectionWireInfo const& other) const SYMBOL_VISIBLE;
+
+	bool operator==(ConnectionWireInfo const& other) const SYMBOL_VISIBLE;
+	bool operator!=(ConnectionWireInfo const& other) const SYMBOL_VISIBLE;
+
+private:
+	friend cereal::access;
+	template <typename Archive>
+	void serialize(Archive& ar, std::uint32_t version);
+};
+
+} // namespace hxcomm
@@ -0,0 +1,83 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/thread_placement.h"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace hxcomm {
+
+/**
+ * Persistent thread executing tasks on a connection one after another.
+ * Handing over a task and waiting for its completion only synchronizes via a single atomic
+ * state, so that repeated short executions on the same connection avoid the creation and
+ * teardown of a thread per execution.
+ * Only a single thread is supported to submit tasks and wait for them.
+ */
+class ConnectionWorker
+{
+public:
+	typedef std::function<void()> task_type;
+
+	/**
+	 * Construct worker and start its thread.
+	 * @param name Name of thread used in logging
+	 */
+	explicit ConnectionWorker(std::string const& name) SYMBOL_VISIBLE;
+
+	ConnectionWorker(ConnectionWorker const&) = delete;
+	ConnectionWorker& operator=(ConnectionWorker const&) = delete;
+
+	/**
+	 * Wait for the submitted task, if any, and stop the thread.
+	 */
+	~ConnectionWorker() SYMBOL_VISIBLE;
+
+	/**
+	 * Submit task for execution.
+	 * Waits for a previously submitted task to complete, discarding its exception.
+	 * @param task Task to execute
+	 */
+	void submit(task_type task) SYMBOL_VISIBLE;
+
+	/**
+	 * Wait for the submitted task to complete.
+	 * Returns immediately if no task is submitted.
+	 * @throws Exception thrown by the task
+	 */
+	void wait() SYMBOL_VISIBLE;
+
+	/**
+	 * Apply placement to the thread of the worker if it differs from the one applied last.
+	 * To be called from within tasks only.
+	 * @param placement Placement to apply
+	 */
+	void apply_placement(ThreadPlacement const& placement) SYMBOL_VISIBLE;
+
+private:
+	enum State : uint32_t
+	{
+		idle,
+		pending,
+		stopped
+	};
+
+	void work();
+
+	/**
+	 * Wait for the submitted task to complete without rethrowing its exception.
+	 */
+	void join_task();
+
+	std::string m_name;
+	std::atomic<uint32_t> m_state;
+	task_type m_task;
+	std::exception_ptr m_exception;
+	ThreadPlacement m_placement;
+	std::thread m_thread;
+};
+
+} // namespace hxcomm
@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+
+namespace hxcomm {
+
+/**
+ * Construct connections concurrently, one thread per connection.
+ * Connection setup, e.g. HostARQ initialization, bitfile information exchange and hwdb lookup,
+ * then takes the time of the slowest connection instead of the sum over all connections.
+ * If constructions fail, all successfully constructed connections are destroyed before throwing.
+ * @tparam Connection Connection type to construct
+ * @tparam Parameter Type of parameter to construct a single connection from
+ * @param parameters Parameters of the connections to construct, one per connection
+ * @throws Exception of the failed construction if a single construction failed
+ * @throws std::runtime_error Listing the errors of all failed constructions if multiple
+ * constructions failed
+ * @return Constructed connections in order of their parameters
+ */
+template <typename Connection, typename Parameter>
+std::vector<Connection> construct_connections(std::vector<Parameter> const& parameters);
+
+} // namespace hxcomm
+
+#include "hxcomm/common/construct_connections.tcc"
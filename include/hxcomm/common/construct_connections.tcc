@@ -0,0 +1,81 @@
+#include <exception>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace hxcomm {
+
+template <typename Connection, typename Parameter>
+std::vector<Connection> construct_connections(std::vector<Parameter> const& parameters)
+{
+	std::vector<std::optional<Connection>> connections(parameters.size());
+	std::vector<std::exception_ptr> exceptions(parameters.size());
+
+	auto const construct = [&parameters, &connections, &exceptions](size_t const index) {
+		try {
+			connections.at(index).emplace(parameters.at(index));
+		} catch (...) {
+			exceptions.at(index) = std::current_exception();
+		}
+	};
+
+	{
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < parameters.size(); ++i) {
+			try {
+				threads.emplace_back(construct, i);
+			} catch (std::system_error const&) {
+				// fall back to sequential construction if no thread is available
+				construct(i);
+			}
+		}
+		// the calling thread constructs the first connection itself
+		if (!parameters.empty()) {
+			construct(0);
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+
+	size_t num_failed = 0;
+	std::exception_ptr first_exception;
+	std::stringstream ss;
+	for (size_t i = 0; i < exceptions.size(); ++i) {
+		if (!exceptions.at(i)) {
+			continue;
+		}
+		if (!first_exception) {
+			first_exception = exceptions.at(i);
+		}
+		num_failed++;
+		ss << std::endl << "Connection " << i << ": ";
+		try {
+			std::rethrow_exception(exceptions.at(i));
+		} catch (std::exception const& e) {
+			ss << e.what();
+		} catch (...) {
+			ss << "Unknown error.";
+		}
+	}
+	if (num_failed == 1) {
+		std::rethrow_exception(first_exception);
+	} else if (num_failed > 1) {
+		throw std::runtime_error(
+		    "Failed to construct " + std::to_string(num_failed) + " of " +
+		    std::to_string(parameters.size()) + " connections:" + ss.str());
+	}
+
+	std::vector<Connection> result;
+	result.reserve(connections.size());
+	for (auto& connection : connections) {
+		result.push_back(std::move(*connection));
+	}
+	return result;
+}
+
+} // namespace hxcomm
@@ -2,12 +2,24 @@
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_time_info.h"
 #include "hxcomm/common/execute_messages_types.h"
+#include "hxcomm/common/expected_responses.h"
+#include "hxcomm/common/listener_halt.h"
 #include "hxcomm/common/logger.h"
 #include "hxcomm/common/stream.h"
 #include "hxcomm/common/visit_connection.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "hate/type_traits.h"
 
@@ -64,7 +76,418 @@ struct ExecutorMessages
 
 		return {std::move(responses), time_difference};
 	}
+
+	/**
+	 * Maximal duration to wait for responses before checking for the end of execution.
+	 */
+	static constexpr std::chrono::milliseconds receive_timeout{1};
+
+	/**
+	 * Execute messages handing responses to the callback in batches as they arrive.
+	 */
+	template <typename Callback>
+	ConnectionTimeInfo operator()(
+	    connection_type& conn, messages_type const& messages, Callback&& callback)
+	{
+		using receive_halt_message_type = typename GetMessageTypes<
+		    connection_type>::type::receive_halt_type;
+
+		Stream<connection_type> stream(conn);
+		auto const time_begin = conn.get_time_info();
+
+		stream.add(messages.begin(), messages.end());
+		stream.add(send_halt_message_type());
+		stream.commit();
+
+		// Execution progresses concurrently, since e.g. simulation time only advances during
+		// run_until_halt. Responses are received in this thread.
+		auto halted = std::async(std::launch::async, [&stream]() { stream.run_until_halt(); });
+
+		response_type responses;
+		size_t num_responses = 0;
+		ListenerHalt<receive_halt_message_type> listener_halt;
+		auto const forward = [&]() {
+			if (responses.empty()) {
+				return;
+			}
+			// the halt response is the last response of the execution
+			std::visit([&listener_halt](auto const& m) { listener_halt(m); }, responses.back());
+			num_responses += responses.size();
+			callback(responses);
+			responses.clear();
+		};
+
+		while (!listener_halt.get() &&
+		       (halted.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+			stream.receive_some(responses, receive_timeout);
+			forward();
+		}
+		halted.get();
+		stream.receive_some(responses, std::chrono::nanoseconds(0));
+		forward();
+
+		auto const time_difference = conn.get_time_info() - time_begin;
+
+		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
+		HXCOMM_LOG_INFO(
+		    log, "Executed messages(" << messages.size() << ") and streamed responses("
+		                              << num_responses << ") with time expenditure: " << std::endl
+		                              << time_difference << ".");
+
+		return time_difference;
+	}
+};
+
+/**
+ * Helper for partial specialization over templated connection-types.
+ *
+ * operator()-contains the implementation of execute_messages_streaming defined below.
+ */
+template <typename Connection>
+struct ExecutorMessagesStreaming
+{
+	using connection_type = Connection;
+	using response_type = typename execute_messages_return_t<Connection>::first_type;
+	using messages_type = execute_messages_argument_t<Connection>;
+	using send_halt_message_type = typename connection_type::send_halt_message_type;
+	using receive_halt_message_type =
+	    typename GetMessageTypes<connection_type>::type::receive_halt_type;
+
+	template <typename Producer, typename Callback>
+	ConnectionTimeInfo operator()(
+	    connection_type& conn,
+	    Producer&& producer,
+	    Callback&& callback,
+	    std::chrono::nanoseconds const flush_latency)
+	{
+		Stream<connection_type> stream(conn);
+		auto const time_begin = conn.get_time_info();
+
+		// Connections only executing during run_until_halt are run for the whole duration of
+		// streaming, all others start execution upon the first commit.
+		std::future<void> halted;
+		auto const run = [&stream, &halted]() {
+			halted = std::async(std::launch::async, [&stream]() { stream.run_until_halt(); });
+		};
+		if constexpr (!executes_on_commit<connection_type>::value) {
+			run();
+		}
+
+		response_type responses;
+		size_t num_responses = 0;
+		ListenerHalt<receive_halt_message_type> listener_halt;
+		auto const forward = [&]() {
+			if (responses.empty()) {
+				return;
+			}
+			// the halt response is the last response of the execution
+			std::visit([&listener_halt](auto const& m) { listener_halt(m); }, responses.back());
+			num_responses += responses.size();
+			callback(responses);
+			responses.clear();
+		};
+
+		// While the producer is pulled in this thread, a service thread commits partially filled
+		// packets after the flush latency and forwards responses, so that neither is delayed by
+		// a blocking producer. Access to the stream is serialized by the stream mutex.
+		std::mutex stream_mutex;
+		std::condition_variable service_condition;
+		bool producing = true;
+		bool uncommitted = false;
+		auto last_commit = std::chrono::steady_clock::now();
+		std::exception_ptr service_exception;
+
+		auto const service_period =
+		    (flush_latency > std::chrono::nanoseconds(0))
+		        ? std::min<std::chrono::nanoseconds>(
+		              flush_latency, ExecutorMessages<connection_type>::receive_timeout)
+		        : std::chrono::nanoseconds(ExecutorMessages<connection_type>::receive_timeout);
+
+		auto const service = [&]() {
+			try {
+				std::unique_lock<std::mutex> lock(stream_mutex);
+				while (true) {
+					service_condition.wait_for(
+					    lock, service_period, [&producing]() { return !producing; });
+					if (!producing) {
+						return;
+					}
+					auto const now = std::chrono::steady_clock::now();
+					if (uncommitted && (now - last_commit >= flush_latency)) {
+						stream.commit();
+						uncommitted = false;
+						last_commit = now;
+					}
+					stream.receive_some(responses, std::chrono::nanoseconds(0));
+					// responses are only accessed by this thread during production
+					lock.unlock();
+					forward();
+					lock.lock();
+				}
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(stream_mutex);
+				service_exception = std::current_exception();
+				producing = false;
+			}
+		};
+
+		std::thread service_thread(service);
+		auto const stop_service = [&]() {
+			{
+				std::lock_guard<std::mutex> lock(stream_mutex);
+				producing = false;
+			}
+			service_condition.notify_all();
+			if (service_thread.joinable()) {
+				service_thread.join();
+			}
+			if (service_exception) {
+				std::rethrow_exception(service_exception);
+			}
+		};
+
+		messages_type messages;
+		size_t num_messages = 0;
+		bool more = true;
+		try {
+			while (more) {
+				messages.clear();
+				more = producer(messages);
+
+				std::lock_guard<std::mutex> lock(stream_mutex);
+				if (service_exception) {
+					std::rethrow_exception(service_exception);
+				}
+				stream.add(messages.begin(), messages.end());
+				num_messages += messages.size();
+				uncommitted = uncommitted || !messages.empty();
+
+				// full packets are transmitted during add, partially filled ones are flushed at
+				// the latest after the flush latency
+				auto const now = std::chrono::steady_clock::now();
+				if (uncommitted && (now - last_commit >= flush_latency)) {
+					stream.commit();
+					uncommitted = false;
+					last_commit = now;
+				}
+			}
+			stop_service();
+		} catch (...) {
+			// the service thread is to end before the stream is used exclusively again
+			try {
+				stop_service();
+			} catch (...) {
+			}
+			// end the execution of the messages added so far and discard its responses before
+			// propagating the error, so that subsequent executions start from a clean connection
+			try {
+				stream.add(send_halt_message_type());
+				stream.commit();
+				if constexpr (executes_on_commit<connection_type>::value) {
+					run();
+				}
+				halted.get();
+				stream.receive_all();
+			} catch (...) {
+			}
+			throw;
+		}
+		stream.add(send_halt_message_type());
+		stream.commit();
+
+		if constexpr (executes_on_commit<connection_type>::value) {
+			run();
+		}
+
+		while (!listener_halt.get() &&
+		       (halted.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+			stream.receive_some(responses, ExecutorMessages<connection_type>::receive_timeout);
+			forward();
+		}
+		halted.get();
+		stream.receive_some(responses, std::chrono::nanoseconds(0));
+		forward();
+
+		auto const time_difference = conn.get_time_info() - time_begin;
+
+		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
+		HXCOMM_LOG_INFO(
+		    log, "Streamed messages(" << num_messages << ") and responses(" << num_responses
+		                              << ") with time expenditure: " << std::endl
+		                              << time_difference << ".");
+
+		return time_difference;
+	}
+};
+
+/**
+ * Helper for partial specialization over templated connection-types.
+ *
+ * operator()-contains the implementation of execute_messages_pipelined defined below.
+ */
+template <typename Connection>
+struct ExecutorMessagesPipelined
+{
+	using connection_type = Connection;
+	using receive_message_type = typename connection_type::receive_message_type;
+	using return_type = std::vector<execute_messages_return_t<Connection>>;
+	using response_type = typename execute_messages_return_t<Connection>::first_type;
+	using messages_type = execute_messages_argument_t<Connection>;
+	using send_halt_message_type = typename connection_type::send_halt_message_type;
+	using receive_halt_message_type =
+	    typename GetMessageTypes<connection_type>::type::receive_halt_type;
+
+	return_type operator()(connection_type& conn, std::vector<messages_type> const& programs)
+	{
+		return_type results;
+		if constexpr (!executes_on_commit<connection_type>::value) {
+			// no execution in flight possible, execute sequentially
+			for (auto const& messages : programs) {
+				results.push_back(ExecutorMessages<connection_type>()(conn, messages));
+			}
+		} else {
+			Stream<connection_type> stream(conn);
+
+			auto const submit = [&stream](messages_type const& messages) {
+				stream.add(messages.begin(), messages.end());
+				stream.add(send_halt_message_type());
+				stream.commit();
+			};
+
+			auto const is_halt = [](receive_message_type const& message) {
+				auto const* halt = std::get_if<receive_halt_message_type>(&message);
+				return halt && (halt->decode() == receive_halt_message_type::instruction_type::halt);
+			};
+
+			auto const time_begin = conn.get_time_info();
+			auto time_program_begin = time_begin;
+			if (!programs.empty()) {
+				submit(programs.front());
+			}
+
+			response_type received;
+			for (size_t i = 0; i < programs.size(); ++i) {
+				// overlap encoding and transmission of the next program with execution of the
+				// current one
+				if (i + 1 < programs.size()) {
+					submit(programs.at(i + 1));
+				}
+				stream.run_until_halt();
+
+				// responses of current program end with the first halt response
+				stream.receive_some(received, std::chrono::nanoseconds(0));
+				auto const halt = std::find_if(received.begin(), received.end(), is_halt);
+				if (halt == received.end()) {
+					throw std::logic_error("Halt response missing after end of execution.");
+				}
+				response_type responses(
+				    std::make_move_iterator(received.begin()),
+				    std::make_move_iterator(std::next(halt)));
+				received.erase(received.begin(), std::next(halt));
+
+				auto const time_program_end = conn.get_time_info();
+				results.emplace_back(std::move(responses), time_program_end - time_program_begin);
+				time_program_begin = time_program_end;
+			}
+
+			log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
+			HXCOMM_LOG_INFO(
+			    log, "Executed programs(" << programs.size()
+			                              << ") pipelined with time expenditure: " << std::endl
+			                              << (conn.get_time_info() - time_begin) << ".");
+		}
+		return results;
+	}
+};
+
+/**
+ * Helper for partial specialization over templated connection-types.
+ *
+ * operator()-contains the implementation of execute_messages_into defined below.
+ */
+template <typename Connection>
+struct ExecutorMessagesInto
+{
+	using connection_type = Connection;
+	using response_type = typename execute_messages_return_t<Connection>::first_type;
+	using messages_type = execute_messages_argument_t<Connection>;
+	using send_halt_message_type = typename connection_type::send_halt_message_type;
+
+	ConnectionTimeInfo operator()(
+	    connection_type& conn, messages_type const& messages, response_type& responses)
+	{
+		Stream<connection_type> stream(conn);
+		auto const time_begin = conn.get_time_info();
+
+		stream.add(messages.begin(), messages.end());
+		stream.add(send_halt_message_type());
+		stream.commit();
+
+		stream.run_until_halt();
+
+		stream.receive_into(responses);
+		auto const time_difference = conn.get_time_info() - time_begin;
+
+		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
+		HXCOMM_LOG_INFO(
+		    log, "Executed messages(" << messages.size() << ") and got responses("
+		                              << responses.size()
+		                              << ") with time expenditure: " << std::endl
+		                              << time_difference << ".");
+
+		return time_difference;
+	}
+};
+
+/**
+ * Helper for partial specialization over templated connection-types.
+ *
+ * operator()-contains the implementation of transact defined below.
+ */
+template <typename Connection>
+struct ExecutorTransact
+{
+	using connection_type = Connection;
+	using response_type = typename execute_messages_return_t<Connection>::first_type;
+	using messages_type = execute_messages_argument_t<Connection>;
+	using send_halt_message_type = typename connection_type::send_halt_message_type;
+	using connection_parameter_type =
+	    typename GetMessageTypes<connection_type>::type::connection_parameter_type;
+
+	void operator()(
+	    connection_type& conn,
+	    messages_type const& messages,
+	    response_type& responses,
+	    std::chrono::nanoseconds const timeout)
+	{
+		ExpectedResponses<connection_parameter_type> const expected_responses;
+		size_t num_responses = 0;
+		for (auto const& message : messages) {
+			num_responses += expected_responses(message);
+		}
+
+		Stream<connection_type> stream(conn);
+		if constexpr (Stream<connection_type>::supports_transact) {
+			stream.transact(messages, responses, num_responses, timeout);
+		} else {
+			// execution might only progress until halt, e.g. in simulation
+			stream.add(messages.begin(), messages.end());
+			stream.add(send_halt_message_type());
+			stream.commit();
+			stream.run_until_halt();
+			stream.receive_into(responses);
+			if (responses.size() != num_responses + 1 /* halt */) {
+				std::stringstream ss;
+				ss << "Unexpected number of responses of transaction, received "
+				   << (responses.size() ? responses.size() - 1 : 0) << " of " << num_responses
+				   << ".";
+				throw std::runtime_error(ss.str());
+			}
+			responses.pop_back();
+		}
+	}
 };
+
 } // namespace detail
 
 /**
@@ -91,4 +514,187 @@ auto execute_messages(Connection& connection, auto const& messages)
 	    connection);
 }
 
+/**
+ * Execute multiple independent programs back-to-back, where encoding and transmission of each
+ * program overlaps with the execution of its predecessor.
+ * Responses are split into programs at the halt responses. The time information of a program
+ * covers the duration from the end of its predecessor until its halt response and therefore
+ * includes the encoding and transmission of its successor.
+ * For connections not starting execution upon commit, the programs are executed sequentially.
+ *
+ * @tparam Connection The connection on which the programs are executed.
+ * @param connection Connection to execute programs on
+ * @param programs Programs to execute in order
+ * @return Responses and time information for each program
+ */
+template <typename Connection, ConnectionIsPlainGuard<Connection> = 0>
+auto execute_messages_pipelined(
+    Connection& connection,
+    std::vector<detail::execute_messages_argument_t<Connection>> const& programs)
+{
+	return detail::ExecutorMessagesPipelined<Connection>()(connection, programs);
+}
+
+template <typename Connection, ConnectionIsWrappedGuard<Connection> = 0>
+auto execute_messages_pipelined(Connection& connection, auto const& programs)
+{
+	return hxcomm::visit_connection(
+	    [&programs](auto& conn) -> decltype(auto) {
+		    return execute_messages_pipelined(conn, programs);
+	    },
+	    connection);
+}
+
+/**
+ * Execute messages while handing responses to a callback in batches as they arrive during
+ * execution instead of returning them after the end of execution.
+ * Only supported for connections implementing the full Stream interface.
+ *
+ * @tparam Connection The connection on which the messages are executed.
+ * @param connection Connection to execute messages on
+ * @param messages Messages to execute
+ * @param callback Callable invoked with each non-empty batch of responses in order of arrival as
+ * `callback(responses)`. The responses are cleared after the invocation, the callback may move
+ * from them.
+ * @return Time information of execution
+ */
+template <typename Connection, ConnectionIsPlainGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages(Connection& connection, auto const& messages, auto&& callback)
+{
+	return detail::ExecutorMessages<Connection>()(connection, messages, callback);
+}
+
+template <typename Connection, ConnectionIsWrappedGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages(Connection& connection, auto const& messages, auto&& callback)
+{
+	return hxcomm::visit_connection(
+	    [&messages, &callback](auto& conn) -> ConnectionTimeInfo {
+		    return execute_messages(conn, messages, callback);
+	    },
+	    connection);
+}
+
+/**
+ * Execute a stream of messages of unbounded length with bounded memory usage.
+ * Messages are pulled in batches from the producer, encoded and transmitted while previous
+ * batches are already executing. Responses are handed to the callback in batches as they arrive.
+ * Transmission blocks while the connection's send window is full, so that the producer is only
+ * pulled as fast as the backend processes the messages.
+ * While the producer blocks, added messages are still committed after the flush latency and
+ * responses are still handed to the callback.
+ * Only supported for connections implementing the full Stream interface.
+ *
+ * For connections only executing during run_until_halt, e.g. in simulation, execution continues
+ * while waiting for the producer, timing between batches is therefore only deterministic if the
+ * producer keeps ahead of execution.
+ *
+ * @tparam Connection The connection on which the messages are executed.
+ * @param connection Connection to execute messages on
+ * @param producer Callable invoked as `bool producer(messages)` with an empty sequence of
+ * messages to append the next batch to. Returning false ends the stream after the batch.
+ * @param callback Callable invoked with each non-empty batch of responses in order of arrival as
+ * `callback(responses)`. The responses are cleared after the invocation, the callback may move
+ * from them. While the producer is pulled, the callback is invoked from a separate thread, never
+ * concurrently to itself.
+ * @param flush_latency Maximal duration between adding messages and committing them, after which
+ * partially filled packets are transmitted. Zero commits after each batch.
+ * @return Time information of execution
+ */
+template <typename Connection, ConnectionIsPlainGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages_streaming(
+    Connection& connection,
+    auto&& producer,
+    auto&& callback,
+    std::chrono::nanoseconds const flush_latency = std::chrono::milliseconds(1))
+{
+	return detail::ExecutorMessagesStreaming<Connection>()(
+	    connection, producer, callback, flush_latency);
+}
+
+template <typename Connection, ConnectionIsWrappedGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages_streaming(
+    Connection& connection,
+    auto&& producer,
+    auto&& callback,
+    std::chrono::nanoseconds const flush_latency = std::chrono::milliseconds(1))
+{
+	return hxcomm::visit_connection(
+	    [&producer, &callback, flush_latency](auto& conn) -> ConnectionTimeInfo {
+		    return execute_messages_streaming(conn, producer, callback, flush_latency);
+	    },
+	    connection);
+}
+
+/**
+ * Execute messages receiving the responses into a reusable buffer replacing its content.
+ * The storage of the buffer is exchanged with the one of the connection's receive queue, so that
+ * repeated execution with the same buffer performs no allocation for responses once the capacity
+ * suffices.
+ * Only supported for connections implementing the full Stream interface.
+ *
+ * @tparam Connection The connection on which the messages are executed.
+ * @param connection Connection to execute messages on
+ * @param messages Messages to execute
+ * @param responses Buffer to receive responses into
+ * @return Time information of execution
+ */
+template <typename Connection, ConnectionIsPlainGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages_into(
+    Connection& connection, auto const& messages, auto& responses)
+{
+	return detail::ExecutorMessagesInto<Connection>()(connection, messages, responses);
+}
+
+template <typename Connection, ConnectionIsWrappedGuard<Connection> = 0>
+ConnectionTimeInfo execute_messages_into(
+    Connection& connection, auto const& messages, auto& responses)
+{
+	return hxcomm::visit_connection(
+	    [&messages, &responses](auto& conn) -> ConnectionTimeInfo {
+		    return execute_messages_into(conn, messages, responses);
+	    },
+	    connection);
+}
+
+/**
+ * Execute a small program and wait for its responses with low latency, e.g. for closed-loop
+ * experiments with many short round trips.
+ * The number of expected responses is derived from the program, responses not triggered by the
+ * program, e.g. events, are therefore not allowed during the transaction.
+ * Connections supporting it wait for the responses without adding a halt message, other
+ * connections execute the program like execute_messages.
+ * No logging is performed and the responses are received into a reusable buffer.
+ * Only supported for connections implementing the full Stream interface.
+ *
+ * @tparam Connection The connection on which the messages are executed.
+ * @param connection Connection to execute messages on
+ * @param messages Messages to execute
+ * @param responses Buffer to receive responses into, replacing its content
+ * @param timeout Maximal duration to wait for the responses
+ * @throws std::runtime_error On timeout or unexpected number of responses
+ */
+template <typename Connection, ConnectionIsPlainGuard<Connection> = 0>
+void transact(
+    Connection& connection,
+    auto const& messages,
+    auto& responses,
+    std::chrono::nanoseconds const timeout = std::chrono::seconds(10))
+{
+	detail::ExecutorTransact<Connection>()(connection, messages, responses, timeout);
+}
+
+template <typename Connection, ConnectionIsWrappedGuard<Connection> = 0>
+void transact(
+    Connection& connection,
+    auto const& messages,
+    auto& responses,
+    std::chrono::nanoseconds const timeout = std::chrono::seconds(10))
+{
+	hxcomm::visit_connection(
+	    [&messages, &responses, timeout](auto& conn) {
+		    transact(conn, messages, responses, timeout);
+	    },
+	    connection);
+}
+
 } // namespace hxcomm
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace hxcomm::detail {
+
+/**
+ * Number of responses a message sent to the backend is expected to trigger.
+ * Specialized for each architecture's connection parameter in the corresponding
+ * `hxcomm/<architecture>/expected_responses.h` header.
+ * The specialization provides `size_t operator()(send_message_type const&) const`.
+ * @tparam ConnectionParameter UT message parameter of connection
+ */
+template <typename ConnectionParameter>
+struct ExpectedResponses;
+
+} // namespace hxcomm::detail
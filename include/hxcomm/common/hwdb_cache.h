@@ -0,0 +1,81 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hwdb4cpp/hwdb4cpp.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+
+namespace hxcomm {
+
+/**
+ * Process-wide cache of hwdb contents indexed by FPGA IP.
+ * Each hwdb file is parsed once and reloaded only upon modification of the file, so that
+ * constructing connections does not repeatedly parse the hwdb and scan all setup entries.
+ * Access is thread-safe.
+ */
+class HwdbCache
+{
+public:
+	typedef std::variant<hwdb4cpp::HXCubeSetupEntry, hwdb4cpp::JboaSetupEntry> setup_entry_type;
+
+	/**
+	 * Location of an FPGA in the hwdb.
+	 */
+	struct FPGALocation
+	{
+		/** Setup entry containing the FPGA. */
+		setup_entry_type setup_entry;
+		/** Index of the FPGA in the setup. */
+		size_t fcp;
+	};
+
+	/**
+	 * Get process-wide instance.
+	 * @return Cache instance
+	 */
+	static HwdbCache& get_instance() SYMBOL_VISIBLE;
+
+	/**
+	 * Find location of FPGA with given IP.
+	 * If multiple setups contain the IP, JBOA setups take precedence over HXCube setups.
+	 * @param ip IP of FPGA
+	 * @param hwdb_path Optional path to hwdb, defaults to default hwdb path
+	 * @throws std::out_of_range On IP not found in hwdb
+	 * @return Location of FPGA
+	 */
+	FPGALocation get_fpga_location(
+	    std::string const& ip, std::optional<std::string> const& hwdb_path = std::nullopt)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Drop all cached hwdb contents.
+	 */
+	void clear() SYMBOL_VISIBLE;
+
+private:
+	HwdbCache() = default;
+
+	struct Index
+	{
+		std::filesystem::file_time_type write_time;
+		std::unordered_map<uint32_t, FPGALocation> fpgas;
+	};
+
+	/**
+	 * Get index of hwdb, (re-)loading it on first access or modification.
+	 * @param path Path to hwdb
+	 * @return Index
+	 */
+	std::shared_ptr<Index const> get_index(std::string const& path);
+
+	std::mutex m_mutex;
+	std::unordered_map<std::string, std::shared_ptr<Index const>> m_indices;
+};
+
+} // namespace hxcomm
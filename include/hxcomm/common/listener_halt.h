@@ -1,12 +1,22 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <variant>
 
 namespace hxcomm {
 
 /**
- * Listener registering occurence of a halt instruction.
+ * Listener registering occurences of a halt instruction.
  * Filtering is done at compile-time for the halt message type and at runtime for the payload
  * comparing with the `halt` member of the messages instruction type.
+ * Halt messages are counted, so that multiple programs can be in flight at the same time, each
+ * registered Halt message is consumed by one reset.
+ * Threads waiting for a halt via wait() are notified on registration and on interruption.
+ * Halt messages of aborted executions can be discarded instead of being registered.
  * @tparam HaltMessageType Message type of Halt instruction
  */
 template <typename HaltMessageType>
@@ -16,7 +26,7 @@ public:
 	/**
 	 * Construct Halt listener.
 	 */
-	ListenerHalt() : m_value(false) {}
+	ListenerHalt() : m_value(0), m_discard_mutex(), m_num_to_discard(0), m_num_discarded(0) {}
 
 	/**
 	 * Operator invoked for every decoded message checking whether the message contains a Halt.
@@ -26,25 +36,168 @@ public:
 	template <typename MessageType>
 	void operator()(MessageType const& message)
 	{
-		if constexpr (std::is_same<MessageType, HaltMessageType>::value) {
-			bool expected = false;
-			m_value.compare_exchange_strong(
-			    expected, (message.decode() == MessageType::instruction_type::halt));
+		if (is_halt(message)) {
+			{
+				std::lock_guard<std::mutex> lock(m_discard_mutex);
+				if (m_num_to_discard) {
+					m_num_to_discard--;
+					m_num_discarded.fetch_add(1, std::memory_order_acq_rel);
+					return;
+				}
+				m_value.fetch_add(1, std::memory_order_acq_rel);
+			}
+			m_value.notify_all();
+		}
+	}
+
+	/**
+	 * Get whether the listener registered a not yet consumed Halt message.
+	 */
+	bool get() const { return (m_value.load(std::memory_order_acquire) & count_mask) != 0; }
+
+	/**
+	 * Block until the listener registered a not yet consumed Halt message.
+	 * Returns immediately if such a Halt message is already registered.
+	 */
+	void wait() const
+	{
+		uint64_t value = m_value.load(std::memory_order_acquire);
+		while (!(value & count_mask)) {
+			m_value.wait(value, std::memory_order_acquire);
+			value = m_value.load(std::memory_order_acquire);
+		}
+	}
+
+	/**
+	 * Get number of interruptions so far, to be supplied to wait(interrupts).
+	 * @return Number of interruptions
+	 */
+	uint64_t get_interrupts() const
+	{
+		return m_value.load(std::memory_order_acquire) >> interrupt_shift;
+	}
+
+	/**
+	 * Block until the listener registered a not yet consumed Halt message or until interrupted.
+	 * @param interrupts Number of interruptions before the waiting started
+	 * @return Whether a Halt message is registered, false if interrupted
+	 */
+	bool wait(uint64_t const interrupts) const
+	{
+		uint64_t value = m_value.load(std::memory_order_acquire);
+		while (!(value & count_mask)) {
+			if ((value >> interrupt_shift) != interrupts) {
+				return false;
+			}
+			m_value.wait(value, std::memory_order_acquire);
+			value = m_value.load(std::memory_order_acquire);
+		}
+		return true;
+	}
+
+	/**
+	 * Wake up all threads waiting via wait(interrupts).
+	 * May be called from any thread.
+	 */
+	void interrupt()
+	{
+		m_value.fetch_add(uint64_t(1) << interrupt_shift, std::memory_order_acq_rel);
+		m_value.notify_all();
+	}
+
+	/**
+	 * Consume one registered Halt message, if any.
+	 */
+	void reset()
+	{
+		uint64_t value = m_value.load(std::memory_order_acquire);
+		while ((value & count_mask) && !m_value.compare_exchange_weak(value, value - 1)) {
+		}
+	}
+
+	/**
+	 * Consume one registered Halt message or, if none is registered, discard the next Halt
+	 * message instead of registering it, e.g. the one of an aborted execution.
+	 * @return Whether a registered Halt message was consumed
+	 */
+	bool consume_or_discard()
+	{
+		std::lock_guard<std::mutex> lock(m_discard_mutex);
+		if (get()) {
+			reset();
+			return true;
 		}
+		m_num_to_discard++;
+		return false;
+	}
+
+	/**
+	 * Get whether the next Halt message is to be discarded.
+	 */
+	bool is_discarding() const
+	{
+		std::lock_guard<std::mutex> lock(m_discard_mutex);
+		return m_num_to_discard != 0;
 	}
 
 	/**
-	 * Get whether the listener registered a Halt message.
+	 * Get number of Halt messages discarded so far.
+	 * @return Number of discarded Halt messages
 	 */
-	bool get() const { return m_value.load(std::memory_order_acquire); }
+	size_t get_num_discarded() const { return m_num_discarded.load(std::memory_order_acquire); }
 
 	/**
-	 * Reset listener state to not having registered a Halt message.
+	 * Erase messages of aborted executions from the messages decoded while discarding, i.e. the
+	 * messages up to and including the discarded Halt messages or all of them if a Halt message
+	 * is still to be discarded.
+	 * To be called by the thread invoking the listener after decoding.
+	 * @tparam Queue Sequential container of message variants
+	 * @param queue Queue of decoded messages
+	 * @param begin Index of first message decoded while discarding
+	 * @param num_discarded Number of Halt messages discarded while decoding the messages
 	 */
-	void reset() { m_value = false; }
+	template <typename Queue>
+	void erase_discarded(Queue& queue, size_t const begin, size_t num_discarded) const
+	{
+		auto const first = queue.begin() + begin;
+		auto last = first;
+		for (; num_discarded; --num_discarded) {
+			last = std::find_if(last, queue.end(), [](auto const& message) {
+				return std::visit([](auto const& m) { return is_halt(m); }, message);
+			});
+			if (last == queue.end()) {
+				break;
+			}
+			++last;
+		}
+		if (is_discarding()) {
+			last = queue.end();
+		}
+		queue.erase(first, last);
+	}
 
 private:
-	std::atomic<bool> m_value;
+	template <typename MessageType>
+	static bool is_halt(MessageType const& message)
+	{
+		if constexpr (std::is_same<MessageType, HaltMessageType>::value) {
+			return message.decode() == MessageType::instruction_type::halt;
+		} else {
+			return false;
+		}
+	}
+
+	/**
+	 * The lower bits count registered Halt messages, the upper bits count interruptions, so that
+	 * waiting threads are woken up by both.
+	 */
+	static constexpr size_t interrupt_shift = 32;
+	static constexpr uint64_t count_mask = (uint64_t(1) << interrupt_shift) - 1;
+
+	std::atomic<uint64_t> m_value;
+	mutable std::mutex m_discard_mutex;
+	size_t m_num_to_discard;
+	std::atomic<size_t> m_num_discarded;
 };
 
 } // namespace hxcomm
@@ -1,23 +1,44 @@
 #pragma once
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/connection_parameter.h"
+#include "hxcomm/common/connection_time_accumulator.h"
+#include "hxcomm/common/connection_time_info.h"
 #include "hxcomm/common/decoder.h"
 #include "hxcomm/common/encoder.h"
+#include "hxcomm/common/listener_halt.h"
+#include "hxcomm/common/receive_wait_policy.h"
+#include "hxcomm/common/spsc_ring.h"
+#include "hxcomm/common/stream.h"
+#include "hxcomm/common/target.h"
 #include "hxcomm/common/utmessage.h"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
-#include <queue>
 #include <stdint.h>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace hxcomm {
 
 /**
- * Loopback connection class. Committed packets are added to a intermediate packet queue in software
- * without alteration. Every committed message can be received in order.
+ * Loopback connection class. Committed messages are encoded, transported in blocks of PHY-words
+ * through a bounded lock-free ring to a receive thread and decoded there without alteration.
+ * Every committed message can be received in order.
  * The send and receive dictionary are therefore the same.
+ * Blocks are filled and sent like the packets of ARQConnection and adding messages blocks while
+ * the ring is full, so that the connection serves as in-process baseline of the encode, transport
+ * and decode pipeline.
+ * If a halt instruction type is given, the connection supports the Stream interface and programs
+ * can be executed via execute_messages, the execution ending on receiving the looped back halt
+ * message.
  * @tparam UTMessageParameter UT message parameter
+ * @tparam HaltInstructionType Instruction type of Halt message in dictionary, void if the
+ * connection is only used via its public interface
  */
-template <typename UTMessageParameter>
+template <typename UTMessageParameter, typename HaltInstructionType = void>
 class LoopbackConnection
 {
 public:
@@ -29,19 +50,66 @@ public:
 	typedef typename UTMessageParameter::Dictionary dictionary_type;
 	typedef phyword_type subpacket_type;
 
-	typedef typename ToUTMessageVariant<
+	/**
+	 * Connection parameter with the same UT message set for sending and receiving direction.
+	 */
+	typedef ConnectionParameter<
+	    UTMessageParameter::HeaderAlignment,
+	    typename UTMessageParameter::SubwordType,
+	    typename UTMessageParameter::PhywordType,
+	    typename UTMessageParameter::Dictionary,
+	    HaltInstructionType,
 	    UTMessageParameter::HeaderAlignment,
 	    typename UTMessageParameter::SubwordType,
 	    typename UTMessageParameter::PhywordType,
-	    typename UTMessageParameter::Dictionary>::type send_message_type;
-	typedef send_message_type receive_message_type;
+	    typename UTMessageParameter::Dictionary,
+	    HaltInstructionType,
+	    void,
+	    void>
+	    connection_parameter_type;
+
+	HXCOMM_EXPOSE_MESSAGE_TYPES(connection_parameter_type)
 
 	typedef std::vector<receive_message_type> receive_queue_type;
 
+	static constexpr char name[] = "LoopbackConnection";
+
+	constexpr static auto supported_targets = {Target::hardware, Target::simulation};
+
+	/**
+	 * Number of PHY-words per block transported at once, equals the maximal number of PHY-words
+	 * in a HostARQ packet.
+	 */
+	static constexpr size_t block_size = 180;
+
+	/**
+	 * Default maximal number of blocks in transport.
+	 */
+	static constexpr size_t default_capacity = 64;
+
+	/**
+	 * Construct loopback connection.
+	 * @param capacity Maximal number of blocks in transport before adding messages blocks
+	 * @throws std::runtime_error On zero capacity
+	 */
+	explicit LoopbackConnection(size_t capacity = default_capacity);
+
+	LoopbackConnection(LoopbackConnection const&) = delete;
+	LoopbackConnection& operator=(LoopbackConnection const&) = delete;
+
 	/**
-	 * Default construct loopback connection.
+	 * Move construct loopback connection.
+	 * Messages in transport are moved, unconsumed halt messages are not.
+	 * @param other Connection to move from
 	 */
-	LoopbackConnection();
+	LoopbackConnection(LoopbackConnection&& other);
+
+	/**
+	 * Move assign loopback connection.
+	 * Messages in transport are moved, unconsumed halt messages are not.
+	 * @param other Connection to move from
+	 */
+	LoopbackConnection& operator=(LoopbackConnection&& other);
 
 	/**
 	 * Destruct loopback connection joining all receive threads.
@@ -50,12 +118,14 @@ public:
 
 	/**
 	 * Add a single UT message to the send queue.
+	 * Blocks while the transport is full.
 	 * @param message Message to add
 	 */
 	void add(send_message_type const& message);
 
 	/**
 	 * Add multiple UT messages to the send queue.
+	 * Blocks while the transport is full.
 	 * @tparam InputIterator Iterator type to sequence of messages to add
 	 * @param begin Iterator to beginning of sequence
 	 * @param end Iterator to end of sequence
@@ -64,7 +134,7 @@ public:
 	void add(InputIterator const& begin, InputIterator const& end);
 
 	/**
-	 * Send messages in send queue by moving to the intermediate queue.
+	 * Send messages in send queue by moving the partially filled block to the transport.
 	 */
 	void commit();
 
@@ -74,28 +144,165 @@ public:
 	 */
 	receive_queue_type receive_all();
 
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer);
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive();
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message);
+
+	/**
+	 * Try to receive a single UT message waiting for it to arrive.
+	 * @param message Message to receive to
+	 * @param timeout Maximal duration to wait for a message to arrive
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout);
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * Waits for messages to arrive if the receive queue is empty and no halt was received.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Maximal duration to wait for messages to arrive
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout);
+
+	/**
+	 * Get whether a halt message was received and all messages up to it were received from the
+	 * receive queue, i.e. the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const;
+
 	/**
 	 * Get whether the connection has no UT messages available to receive.
 	 * @return Boolean value
 	 */
 	bool receive_empty() const;
 
+	/**
+	 * Block until the halt message of the current program is looped back.
+	 */
+	void run_until_halt();
+
+	/**
+	 * Get internal mutex to use for mutual exclusion.
+	 * @return Mutable reference to mutex
+	 */
+	std::mutex& get_mutex();
+
+	/**
+	 * Get time information.
+	 * @return Time information
+	 */
+	ConnectionTimeInfo get_time_info() const;
+
+	/**
+	 * Get maximal number of blocks in transport.
+	 * @return Capacity
+	 */
+	size_t get_capacity() const;
+
+	/**
+	 * Set policy of the receive thread on how to wait while no blocks are in transport.
+	 * @param policy Policy to use
+	 */
+	void set_receive_wait_policy(ReceiveWaitPolicy const& policy);
+
+	/**
+	 * Get policy of the receive thread on how to wait while no blocks are in transport.
+	 * @return Policy in use
+	 */
+	ReceiveWaitPolicy get_receive_wait_policy() const;
+
 private:
-	std::mutex m_intermediate_queue_mutex;
-	std::deque<subpacket_type> m_intermediate_queue;
+	/**
+	 * Block of PHY-words transported at once.
+	 */
+	struct Block
+	{
+		std::array<subpacket_type, block_size> words;
+		size_t len = 0;
+	};
+
+	typedef SPSCRing<Block> ring_type;
+
+	struct SendQueue
+	{
+	public:
+		SendQueue(ring_type& ring, ReceiveWaiter& receive_waiter);
+
+		SendQueue(SendQueue const& other, ring_type& ring, ReceiveWaiter& receive_waiter);
 
-	typedef std::queue<subpacket_type> send_queue_type;
+		void push(subpacket_type const& subpacket);
+
+		void flush();
+
+	private:
+		/**
+		 * Add block to ring, waking up the receive thread before blocking while the ring is full.
+		 */
+		void send();
+
+		ring_type& m_ring;
+		ReceiveWaiter& m_receive_waiter;
+		Block m_block;
+	};
+
+	/**
+	 * Stop receive thread of other connection and get its ring to move from.
+	 */
+	static ring_type&& release(LoopbackConnection& other);
+
+	ring_type m_ring;
+
+	ReceiveWaiter m_receive_waiter;
+
+	typedef SendQueue send_queue_type;
 	send_queue_type m_send_queue;
 
-	Encoder<UTMessageParameter, send_queue_type> m_encoder;
+	typedef Encoder<UTMessageParameter, send_queue_type> encoder_type;
+	encoder_type m_encoder;
 
 	mutable std::mutex m_receive_queue_mutex;
+	std::condition_variable m_receive_queue_condition;
 	receive_queue_type m_receive_queue;
+	/**
+	 * Index of first message in receive queue not yet received.
+	 */
+	size_t m_receive_queue_front;
+
+	// without halt instruction type no message is registered as halt
+	typedef ListenerHalt<std::conditional_t<
+	    std::is_void_v<HaltInstructionType>,
+	    void,
+	    typename message_types::receive_halt_type>>
+	    listener_halt_type;
+	listener_halt_type m_listener_halt;
 
-	Decoder<UTMessageParameter, receive_queue_type> m_decoder;
+	typedef Decoder<UTMessageParameter, receive_queue_type, listener_halt_type> decoder_type;
+	decoder_type m_decoder;
 
 	std::atomic<bool> m_run_receive;
 
+	std::mutex m_mutex;
+
+	ConnectionTimeAccumulator m_time_accumulator;
+
 	std::thread m_worker_receive;
 	void work_receive();
 };
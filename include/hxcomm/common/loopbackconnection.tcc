@@ -1,79 +1,351 @@
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace hxcomm {
 
-template <typename UTMessageParameter>
-LoopbackConnection<UTMessageParameter>::LoopbackConnection() :
-    m_intermediate_queue_mutex(),
-    m_intermediate_queue(),
-    m_send_queue(),
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::SendQueue::SendQueue(
+    ring_type& ring, ReceiveWaiter& receive_waiter) :
+    m_ring(ring), m_receive_waiter(receive_waiter), m_block()
+{}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::SendQueue::SendQueue(
+    SendQueue const& other, ring_type& ring, ReceiveWaiter& receive_waiter) :
+    m_ring(ring), m_receive_waiter(receive_waiter), m_block(other.m_block)
+{}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::SendQueue::push(
+    subpacket_type const& subpacket)
+{
+	m_block.words[m_block.len] = subpacket;
+	m_block.len++;
+	if (m_block.len == block_size) {
+		send();
+	}
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::SendQueue::flush()
+{
+	if (m_block.len) {
+		send();
+	}
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::SendQueue::send()
+{
+	if (!m_ring.try_push(m_block)) {
+		// keep receive worker from blocking while the ring is full
+		m_receive_waiter.notify();
+		m_ring.push(m_block);
+	}
+	m_block.len = 0;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+typename LoopbackConnection<UTMessageParameter, HaltInstructionType>::ring_type&&
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::release(LoopbackConnection& other)
+{
+	if (other.m_run_receive) {
+		other.m_run_receive = false;
+		other.m_receive_waiter.notify();
+		other.m_worker_receive.join();
+	}
+	return std::move(other.m_ring);
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::LoopbackConnection(
+    size_t const capacity) :
+    m_ring(capacity),
+    m_receive_waiter(),
+    m_send_queue(m_ring, m_receive_waiter),
     m_encoder(m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
-    m_decoder(m_receive_queue),
+    m_receive_queue_front(0),
+    m_listener_halt(),
+    m_decoder(m_receive_queue, m_listener_halt),
     m_run_receive(true),
-    m_worker_receive(&LoopbackConnection<UTMessageParameter>::work_receive, this)
+    m_mutex(),
+    m_time_accumulator(),
+    m_worker_receive(&LoopbackConnection::work_receive, this)
 {}
 
-template <typename UTMessageParameter>
-LoopbackConnection<UTMessageParameter>::~LoopbackConnection()
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::LoopbackConnection(
+    LoopbackConnection&& other) :
+    m_ring(release(other)),
+    m_receive_waiter(other.m_receive_waiter.get_policy()),
+    m_send_queue(other.m_send_queue, m_ring, m_receive_waiter),
+    m_encoder(other.m_encoder, m_send_queue),
+    m_receive_queue_mutex(),
+    m_receive_queue_condition(),
+    m_receive_queue(std::move(other.m_receive_queue)),
+    m_receive_queue_front(std::exchange(other.m_receive_queue_front, 0)),
+    m_listener_halt(),
+    m_decoder(other.m_decoder, m_receive_queue, m_listener_halt),
+    m_run_receive(true),
+    m_mutex(),
+    m_time_accumulator(),
+    m_worker_receive()
+{
+	m_time_accumulator = other.m_time_accumulator;
+	m_worker_receive = std::thread(&LoopbackConnection::work_receive, this);
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>&
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::operator=(LoopbackConnection&& other)
+{
+	if (&other != this) {
+		// shutdown own thread
+		if (m_run_receive) {
+			m_run_receive = false;
+			m_receive_waiter.notify();
+			m_worker_receive.join();
+		}
+		// move ring, shuts down other thread
+		m_ring.~ring_type();
+		new (&m_ring) ring_type(release(other));
+		m_receive_waiter.set_policy(other.m_receive_waiter.get_policy());
+		m_time_accumulator = other.m_time_accumulator;
+		// move queues
+		m_send_queue.~send_queue_type();
+		new (&m_send_queue) send_queue_type(other.m_send_queue, m_ring, m_receive_waiter);
+		m_receive_queue = std::move(other.m_receive_queue);
+		m_receive_queue_front = std::exchange(other.m_receive_queue_front, 0);
+		// create encoder
+		m_encoder.~encoder_type();
+		new (&m_encoder) encoder_type(other.m_encoder, m_send_queue);
+		// create decoder
+		m_decoder.~decoder_type();
+		new (&m_decoder) decoder_type(other.m_decoder, m_receive_queue, m_listener_halt);
+		// start thread
+		m_run_receive = true;
+		m_worker_receive = std::thread(&LoopbackConnection::work_receive, this);
+	}
+	return *this;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::~LoopbackConnection()
 {
 	m_run_receive = false;
-	m_worker_receive.join();
+	m_receive_waiter.notify();
+	if (m_worker_receive.joinable()) {
+		m_worker_receive.join();
+	}
 }
 
-template <typename UTMessageParameter>
-void LoopbackConnection<UTMessageParameter>::add(send_message_type const& message)
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::add(
+    send_message_type const& message)
 {
+	// only the encoding is accounted for, not the time spent by the caller between messages
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	std::visit([this](auto const& m) { m_encoder(m); }, message);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
-template <typename UTMessageParameter>
+template <typename UTMessageParameter, typename HaltInstructionType>
 template <typename InputIterator>
-void LoopbackConnection<UTMessageParameter>::add(
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::add(
     InputIterator const& begin, InputIterator const& end)
 {
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	m_encoder(begin, end);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
-template <typename UTMessageParameter>
-void LoopbackConnection<UTMessageParameter>::commit()
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::commit()
 {
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	m_encoder.flush();
-	size_t const size = m_send_queue.size();
-	std::lock_guard<std::mutex> lock(m_intermediate_queue_mutex);
-	for (size_t i = 0; i < size; ++i) {
-		m_intermediate_queue.push_back(m_send_queue.front());
-		m_send_queue.pop();
-	}
+	m_send_queue.flush();
+	// responses are to be expected
+	m_receive_waiter.notify();
+	m_time_accumulator.commit.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
-template <typename UTMessageParameter>
-LoopbackConnection<UTMessageParameter>::receive_queue_type
-LoopbackConnection<UTMessageParameter>::receive_all()
+template <typename UTMessageParameter, typename HaltInstructionType>
+typename LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_queue_type
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_all()
 {
 	receive_queue_type all;
-	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	std::swap(all, m_receive_queue);
+	receive_into(all);
 	return all;
 }
 
-template <typename UTMessageParameter>
-void LoopbackConnection<UTMessageParameter>::work_receive()
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_into(
+    receive_queue_type& buffer)
 {
-	while (m_run_receive) {
-		std::lock_guard<std::mutex> lock(m_intermediate_queue_mutex);
-		{
-			std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-			m_decoder(m_intermediate_queue.begin(), m_intermediate_queue.end());
+	buffer.clear();
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == 0) {
+		std::swap(buffer, m_receive_queue);
+	} else {
+		buffer.assign(
+		    std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+		    std::make_move_iterator(m_receive_queue.end()));
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+typename LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_message_type
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive()
+{
+	receive_message_type message;
+	if (!try_receive(message)) {
+		throw std::runtime_error("Trying to receive from empty receive queue.");
+	}
+	return message;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+bool LoopbackConnection<UTMessageParameter, HaltInstructionType>::try_receive(
+    receive_message_type& message)
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		return false;
+	}
+	message = std::move(m_receive_queue[m_receive_queue_front]);
+	m_receive_queue_front++;
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+	return true;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+bool LoopbackConnection<UTMessageParameter, HaltInstructionType>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const timeout)
+{
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (!m_receive_queue_condition.wait_for(lock, timeout, [this] {
+			    return m_receive_queue_front != m_receive_queue.size();
+		    })) {
+			return false;
 		}
-		m_intermediate_queue.clear();
 	}
+	return try_receive(message);
 }
 
-template <typename UTMessageParameter>
-bool LoopbackConnection<UTMessageParameter>::receive_empty() const
+template <typename UTMessageParameter, typename HaltInstructionType>
+size_t LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const timeout)
 {
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
 	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	return m_receive_queue.empty();
+	m_receive_queue_condition.wait_for(lock, timeout, [this] {
+		return (m_receive_queue_front != m_receive_queue.size()) || m_listener_halt.get();
+	});
+	size_t const count = m_receive_queue.size() - m_receive_queue_front;
+	buffer.insert(
+	    buffer.end(), std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+	    std::make_move_iterator(m_receive_queue.end()));
+	m_receive_queue.clear();
+	m_receive_queue_front = 0;
+	return count;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+bool LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_halted() const
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_listener_halt.get() && (m_receive_queue_front == m_receive_queue.size());
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+bool LoopbackConnection<UTMessageParameter, HaltInstructionType>::receive_empty() const
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_receive_queue_front == m_receive_queue.size();
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::run_until_halt()
+{
+	static_assert(
+	    !std::is_void_v<HaltInstructionType>,
+	    "LoopbackConnection requires halt instruction type to run until halt.");
+
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+	{
+		// keep receive worker from blocking until halt is received
+		ReceiveWaiter::Active receive_active(m_receive_waiter);
+		m_listener_halt.wait();
+	}
+	m_listener_halt.reset();
+	m_time_accumulator.execution.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+std::mutex& LoopbackConnection<UTMessageParameter, HaltInstructionType>::get_mutex()
+{
+	return m_mutex;
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+ConnectionTimeInfo LoopbackConnection<UTMessageParameter, HaltInstructionType>::get_time_info()
+    const
+{
+	return m_time_accumulator.get();
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+size_t LoopbackConnection<UTMessageParameter, HaltInstructionType>::get_capacity() const
+{
+	return m_ring.capacity();
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::set_receive_wait_policy(
+    ReceiveWaitPolicy const& policy)
+{
+	m_receive_waiter.set_policy(policy);
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+ReceiveWaitPolicy
+LoopbackConnection<UTMessageParameter, HaltInstructionType>::get_receive_wait_policy() const
+{
+	return m_receive_waiter.get_policy();
+}
+
+template <typename UTMessageParameter, typename HaltInstructionType>
+void LoopbackConnection<UTMessageParameter, HaltInstructionType>::work_receive()
+{
+	while (m_run_receive) {
+		while (auto const* block = m_ring.front()) {
+			auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+			{
+				std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+				m_decoder(block->words.begin(), block->words.begin() + block->len);
+			}
+			m_ring.pop();
+			m_receive_queue_condition.notify_all();
+			m_time_accumulator.decode.add(
+			    ConnectionTimeAccumulator::clock_type::now() - time_begin);
+			m_receive_waiter.reset();
+		}
+		m_receive_waiter.wait();
+	}
 }
 
 } // namespace hxcomm
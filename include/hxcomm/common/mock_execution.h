@@ -0,0 +1,125 @@
+#pragma once
+#include "hate/timer.h"
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hxcomm::detail {
+
+/**
+ * Receive queue of connections mocking the execution, which fill it synchronously while
+ * processing messages and therefore need no locking.
+ * Messages are appended to the back and received from the front, which is tracked by an index
+ * instead of erasing received messages.
+ * @tparam Message Type of received messages
+ */
+template <typename Message>
+struct MockReceiveQueue
+{
+	typedef std::vector<Message> queue_type;
+
+	MockReceiveQueue() = default;
+
+	MockReceiveQueue(MockReceiveQueue&& other) :
+	    messages(std::move(other.messages)), front(std::exchange(other.front, 0))
+	{}
+
+	MockReceiveQueue& operator=(MockReceiveQueue&& other)
+	{
+		if (&other != this) {
+			messages = std::move(other.messages);
+			front = std::exchange(other.front, 0);
+		}
+		return *this;
+	}
+
+	/**
+	 * Move all messages not yet received into buffer replacing its content.
+	 * @param buffer Buffer to fill
+	 */
+	void receive_into(queue_type& buffer)
+	{
+		buffer.clear();
+		if (front == 0) {
+			std::swap(buffer, messages);
+		} else {
+			buffer.assign(
+			    std::make_move_iterator(messages.begin() + front),
+			    std::make_move_iterator(messages.end()));
+			clear();
+		}
+	}
+
+	/**
+	 * Receive first message not yet received.
+	 * @param message Message to move received message to
+	 * @return Whether a message was received
+	 */
+	bool try_receive(Message& message)
+	{
+		if (empty()) {
+			return false;
+		}
+		message = std::move(messages[front]);
+		front++;
+		if (empty()) {
+			clear();
+		}
+		return true;
+	}
+
+	/**
+	 * Append all messages not yet received to buffer.
+	 * @param buffer Buffer to append to
+	 * @return Number of appended messages
+	 */
+	size_t receive_some(queue_type& buffer)
+	{
+		size_t const count = messages.size() - front;
+		buffer.insert(
+		    buffer.end(), std::make_move_iterator(messages.begin() + front),
+		    std::make_move_iterator(messages.end()));
+		clear();
+		return count;
+	}
+
+	bool empty() const
+	{
+		return front == messages.size();
+	}
+
+	void clear()
+	{
+		messages.clear();
+		front = 0;
+	}
+
+	queue_type messages;
+	/**
+	 * Index of first message not yet received.
+	 */
+	size_t front = 0;
+};
+
+/**
+ * Wait until the given duration passed since start of the timer.
+ * Long waits are slept through and the remainder is waited actively until the time spent matches
+ * the duration.
+ * @param timer Timer started at begin of the wait
+ * @param duration Duration to wait for
+ */
+inline void wait_mocked_duration(hate::Timer const& timer, std::chrono::nanoseconds const duration)
+{
+	constexpr long max_spin_ns = 100000;
+	long const left_ns = duration.count() - timer.get_ns();
+	if (left_ns > max_spin_ns) {
+		std::this_thread::sleep_for(std::chrono::nanoseconds(left_ns - max_spin_ns));
+	}
+	while (timer.get_ns() < duration.count()) {
+	}
+}
+
+} // namespace hxcomm::detail
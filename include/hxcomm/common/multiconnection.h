@@ -3,18 +3,37 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_info.h"
+#include "hxcomm/common/connection_worker.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 
 namespace hxcomm {
 
+template <typename Connection>
+struct MultiConnection;
+
+namespace detail {
+
+template <typename Connection>
+struct ExecutorMessages;
+
+template <typename Connection>
+struct ExecutorMessages<MultiConnection<Connection>>;
+
+} // namespace detail
+
 /**
  * Vectoriced connection.
  * Holds multiple connections of a single type.
+ * Each connection is accompanied by a persistent worker thread executing programs on it, placed
+ * according to the thread placement of the connection if it provides one.
  */
 template <typename Connection>
 struct SYMBOL_VISIBLE MultiConnection
@@ -38,8 +57,10 @@ struct SYMBOL_VISIBLE MultiConnection
 
 	/**
 	 * Default constructor creates a single connection of its type.
+	 * Only available if the connection is default-constructible.
 	 */
-	MultiConnection();
+	MultiConnection()
+	    requires std::is_default_constructible_v<Connection>;
 
 	/**
 	 * Create MultiConnection (to FPGAs or Simulation) with address found in environment.
@@ -50,6 +71,7 @@ struct SYMBOL_VISIBLE MultiConnection
 
 	/**
 	 * Create Multiconnection from given vector of tuples.
+	 * The contained connections are constructed concurrently.
 	 * @param connection_inits List of connection inits for the contained SingleConnections.
 	 */
 	MultiConnection(init_parameters_type const& connection_inits);
@@ -102,6 +124,14 @@ struct SYMBOL_VISIBLE MultiConnection
 	 */
 	std::vector<ConnectionTimeInfo> get_time_info() const;
 
+	/**
+	 * Get transport-level information.
+	 * Only available if the contained connections provide it.
+	 * @return Wire information of all connections.
+	 */
+	std::vector<ConnectionWireInfo> get_wire_info() const
+	    requires requires(Connection const& connection) { connection.get_wire_info(); };
+
 	/**
 	 * Get unique identifiers from hwdb.
 	 * @param hwdb_path Path to hwdb.
@@ -131,22 +161,20 @@ struct SYMBOL_VISIBLE MultiConnection
 	std::vector<HwdbEntry> get_hwdb_entry() const;
 
 private:
+	friend detail::ExecutorMessages<MultiConnection>;
+
+	/**
+	 * Start a worker for each connection without one.
+	 */
+	void start_workers();
+
 	std::vector<Connection> m_connections;
+	std::vector<std::unique_ptr<ConnectionWorker>> m_workers;
 };
 
 template <typename Connection>
 const std::string MultiConnection<Connection>::name = std::string("Multi") + Connection::name;
 
-namespace detail {
-
-template <typename Connection>
-struct ExecutorMessages;
-
-template <typename Connection>
-struct ExecutorMessages<MultiConnection<Connection>>;
-
-} // namespace detail
-
 } // namespace hxcomm
 
 #include "hxcomm/common/multiconnection.tcc"
\ No newline at end of file
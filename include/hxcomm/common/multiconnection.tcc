@@ -3,7 +3,15 @@
 #include "hxcomm/common/multiconnection.h"
 
 #include "hxcomm/common/stream.h"
-#include <future>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <log4cxx/logger.h>
 
 #include "hxcomm/common/visit_connection.h"
@@ -48,103 +56,296 @@ struct ExecutorMessages<hxcomm::MultiConnection<Connection>>
 	 * Vector of messages given by value.
 	 */
 	return_type operator()(connection_type& multi_connection, messages_type const& messages)
+	{
+		return execute(multi_connection, messages);
+	}
+
+	/**
+	 * Vector of messages given with reference wrapper.
+	 */
+	return_type operator()(connection_type& multi_connection, message_type_wrapped const& messages)
+	{
+		return execute(multi_connection, messages);
+	}
+
+	/**
+	 * Vector of messages given by value or with reference wrapper, results handed to the callback
+	 * as soon as each sub-connection completes.
+	 */
+	template <typename Messages, typename Callback>
+	void operator()(
+	    connection_type& multi_connection, Messages const& messages, Callback&& callback)
+	{
+		execute_as_completed(multi_connection, messages, callback);
+	}
+
+	/**
+	 * Independent programs distributed to whichever sub-connection is free.
+	 */
+	return_type execute_pooled(
+	    connection_type& multi_connection, std::vector<sub_messages_type> const& programs)
 	{
 		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
 
-		if (messages.size() != multi_connection.size()) {
-			throw std::invalid_argument(
-			    "Supplied number of message lists doesn't match multi-connection size.");
+		std::vector<std::optional<sub_return_type>> results(programs.size());
+
+		// index of the next program to execute, each worker claims programs until none are left
+		std::atomic<size_t> next_program = 0;
+
+		auto execute_programs_sub_connection = [&multi_connection, &programs, &results,
+		                                        &next_program](size_t const index) {
+			size_t program = next_program.fetch_add(1, std::memory_order_relaxed);
+			try {
+				for (; program < programs.size();
+				     program = next_program.fetch_add(1, std::memory_order_relaxed)) {
+					results.at(program).emplace(
+					    execute_sub_connection(multi_connection, index, programs.at(program)));
+				}
+			} catch (...) {
+				// stop claiming further programs on all sub-connections
+				next_program.store(programs.size(), std::memory_order_relaxed);
+				throw;
+			}
+		};
+
+		auto const time_begin = multi_connection.get_time_info();
+		for (size_t i = 0; i < std::min(multi_connection.size(), programs.size()); i++) {
+			multi_connection.m_workers.at(i)->submit(
+			    [&execute_programs_sub_connection, i]() { execute_programs_sub_connection(i); });
 		}
+		wait(multi_connection);
 
-		std::vector<std::future<sub_return_type>> futures;
+		return_type result;
+		for (auto& sub_result : results) {
+			result.push_back(std::move(*sub_result));
+		}
 
-		auto execute_message_sub_connection = [&multi_connection, &messages, &log](size_t index) {
-			auto& connection = multi_connection[index];
+		auto const time_end = multi_connection.get_time_info();
+		ConnectionTimeInfo time_difference;
+		for (size_t i = 0; i < multi_connection.size(); ++i) {
+			time_difference += time_end.at(i) - time_begin.at(i);
+		}
+		HXCOMM_LOG_INFO(
+		    log, "Executed programs(" << programs.size() << ") pooled on connections("
+		                              << multi_connection.size()
+		                              << ") with accumulated time expenditure: " << std::endl
+		                              << time_difference << ".");
 
-			Stream<sub_connection_type> stream(connection);
-			auto const time_begin = connection.get_time_info();
+		return result;
+	}
 
-			stream.add(messages.at(index).begin(), messages.at(index).end());
-			stream.add(sub_send_halt_message_type());
-			stream.commit();
+private:
+	static sub_messages_type const& unwrap(sub_messages_type const& messages)
+	{
+		return messages;
+	}
 
-			stream.run_until_halt();
+	static sub_messages_type const& unwrap(
+	    std::reference_wrapper<sub_messages_type const> const& messages)
+	{
+		return messages.get();
+	}
 
-			auto responses = stream.receive_all();
-			auto const time_difference = connection.get_time_info() - time_begin;
+	/**
+	 * Execute messages on a sub-connection, to be called from the worker of the sub-connection.
+	 */
+	static sub_return_type execute_sub_connection(
+	    connection_type& multi_connection, size_t const index, sub_messages_type const& messages)
+	{
+		auto& connection = multi_connection[index];
 
-			HXCOMM_LOG_INFO(
-			    log, "Executed messages(" << messages.at(index).size() << ") and got responses("
-			                              << responses.size()
-			                              << ") with time expenditure: " << std::endl
-			                              << time_difference << " on connection " << index << ".");
+		if constexpr (requires { connection.get_thread_placement(); }) {
+			multi_connection.m_workers.at(index)->apply_placement(
+			    connection.get_thread_placement());
+		}
 
-			return std::make_pair(std::move(responses), time_difference);
-		};
+		Stream<sub_connection_type> stream(connection);
+		auto const time_begin = connection.get_time_info();
 
-		for (size_t i = 0; i < multi_connection.size(); i++) {
-			futures.push_back(std::async(std::launch::async, execute_message_sub_connection, i));
+		stream.add(messages.begin(), messages.end());
+		stream.add(sub_send_halt_message_type());
+		stream.commit();
+
+		stream.run_until_halt();
+
+		auto responses = stream.receive_all();
+		auto const time_difference = connection.get_time_info() - time_begin;
+
+		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
+		HXCOMM_LOG_INFO(
+		    log, "Executed messages(" << messages.size() << ") and got responses("
+		                              << responses.size()
+		                              << ") with time expenditure: " << std::endl
+		                              << time_difference << " on connection " << index << ".");
+
+		return {std::move(responses), time_difference};
+	}
+
+	/**
+	 * Wait for the workers of all sub-connections and rethrow the first exception, if any.
+	 */
+	static void wait(connection_type& multi_connection)
+	{
+		std::exception_ptr exception;
+		for (auto& worker : multi_connection.m_workers) {
+			try {
+				worker->wait();
+			} catch (...) {
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+		}
+		if (exception) {
+			std::rethrow_exception(exception);
 		}
+	}
+
+	/**
+	 * Execute messages on all sub-connections concurrently and return results in order of the
+	 * sub-connections.
+	 */
+	template <typename Messages>
+	static return_type execute(connection_type& multi_connection, Messages const& messages)
+	{
+		std::vector<std::optional<sub_return_type>> results(multi_connection.size());
+		execute_as_completed(
+		    multi_connection, messages, [&results](size_t const index, sub_return_type&& result) {
+			    results.at(index).emplace(std::move(result));
+		    });
 
 		return_type result;
-		for (auto& future : futures) {
-			result.push_back(future.get());
+		for (auto& sub_result : results) {
+			result.push_back(std::move(*sub_result));
 		}
-
 		return result;
 	}
 
 	/**
-	 * Vector of messages given with reference wrapper.
+	 * Execute messages on all sub-connections concurrently on their persistent workers.
+	 * The callback is invoked in the calling thread in order of completion of the
+	 * sub-connections. After the first exception of a sub-connection or the callback, the
+	 * callback is no longer invoked and all sub-connections are waited for before rethrowing it.
 	 */
-	return_type operator()(connection_type& multi_connection, message_type_wrapped const& messages)
+	template <typename Messages, typename Callback>
+	static void execute_as_completed(
+	    connection_type& multi_connection, Messages const& messages, Callback&& callback)
 	{
-		log4cxx::LoggerPtr log = log4cxx::Logger::getLogger("hxcomm.execute_messages");
-
 		if (messages.size() != multi_connection.size()) {
 			throw std::invalid_argument(
 			    "Supplied number of message lists doesn't match multi-connection size.");
 		}
 
-		std::vector<std::future<sub_return_type>> futures;
-
-		auto execute_message_sub_connection = [&multi_connection, &messages, &log](size_t index) {
-			auto& connection = multi_connection[index];
+		std::vector<std::optional<sub_return_type>> results(multi_connection.size());
 
-			Stream<sub_connection_type> stream(connection);
-			auto const time_begin = connection.get_time_info();
+		// indices of completed sub-connections in order of completion
+		std::mutex completed_mutex;
+		std::condition_variable completed_cv;
+		std::deque<size_t> completed;
 
-			stream.add(messages.at(index).get().begin(), messages.at(index).get().end());
-			stream.add(sub_send_halt_message_type());
-			stream.commit();
-
-			stream.run_until_halt();
-
-			auto responses = stream.receive_all();
-			auto const time_difference = connection.get_time_info() - time_begin;
-
-			HXCOMM_LOG_INFO(
-			    log, "Executed messages(" << messages.at(index).get().size()
-			                              << ") and got responses(" << responses.size()
-			                              << ") with time expenditure: " << std::endl
-			                              << time_difference << " on connection " << index << ".");
+		auto execute_message_sub_connection = [&multi_connection, &messages,
+		                                       &results](size_t const index) {
+			results.at(index).emplace(
+			    execute_sub_connection(multi_connection, index, unwrap(messages.at(index))));
+		};
 
-			return std::make_pair(std::move(responses), time_difference);
+		auto const complete = [&completed_mutex, &completed_cv, &completed](size_t const index) {
+			{
+				std::lock_guard<std::mutex> lock(completed_mutex);
+				completed.push_back(index);
+			}
+			completed_cv.notify_one();
 		};
 
 		for (size_t i = 0; i < multi_connection.size(); i++) {
-			futures.push_back(std::async(std::launch::async, execute_message_sub_connection, i));
+			multi_connection.m_workers.at(i)->submit(
+			    [&execute_message_sub_connection, &complete, i]() {
+				    try {
+					    execute_message_sub_connection(i);
+				    } catch (...) {
+					    complete(i);
+					    throw;
+				    }
+				    complete(i);
+			    });
 		}
 
-		return_type result;
-		for (auto& future : futures) {
-			result.push_back(future.get());
+		std::exception_ptr exception;
+		for (size_t num_completed = 0; num_completed < multi_connection.size();
+		     ++num_completed) {
+			size_t index;
+			{
+				std::unique_lock<std::mutex> lock(completed_mutex);
+				completed_cv.wait(lock, [&completed]() { return !completed.empty(); });
+				index = completed.front();
+				completed.pop_front();
+			}
+			try {
+				multi_connection.m_workers.at(index)->wait();
+				if (!exception) {
+					callback(index, std::move(*results.at(index)));
+				}
+			} catch (...) {
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+		}
+		if (exception) {
+			std::rethrow_exception(exception);
 		}
-
-		return result;
 	}
 };
 
 } // namespace detail
 
+/**
+ * Execute messages on all connections of a MultiConnection and hand the responses and time
+ * information of each connection to the callback as soon as its execution completed.
+ * This allows to process results of short executions while longer ones are still running.
+ * The callback is invoked in the calling thread, one invocation at a time.
+ *
+ * @tparam Connection Type of connections contained in the MultiConnection
+ * @param connection MultiConnection to execute messages on
+ * @param messages Messages to execute, one sequence per contained connection, given by value or
+ * with reference wrapper
+ * @param callback Callable invoked in order of completion as `callback(index, result)` with the
+ * index of the connection and the pair of its responses and time information, which the callback
+ * may move from
+ * @throws std::invalid_argument On number of message sequences not matching the number of
+ * connections
+ * @throws Exception of the first connection or callback invocation failing, after all executions
+ * completed. The callback is not invoked anymore after an exception.
+ */
+template <typename Connection>
+void execute_messages_as_completed(
+    MultiConnection<Connection>& connection, auto const& messages, auto&& callback)
+{
+	detail::ExecutorMessages<MultiConnection<Connection>>()(connection, messages, callback);
+}
+
+/**
+ * Execute independent programs on a MultiConnection, each on whichever connection is free.
+ * The workers of the connections claim the next pending program as soon as they completed their
+ * previous one, so that throughput scales with the number of connections also for programs of
+ * varying duration, in contrast to executing one program per connection in lockstep.
+ * Programs must not depend on the connection they are executed on or on the state left by other
+ * programs.
+ *
+ * @tparam Connection Type of connections contained in the MultiConnection
+ * @param connection MultiConnection to execute programs on
+ * @param programs Programs to execute
+ * @return Responses and time information for each program in order of the programs
+ * @throws Exception of the first connection failing after all running executions completed.
+ * Pending programs are not executed anymore after an exception.
+ */
+template <typename Connection>
+auto execute_messages_pooled(
+    MultiConnection<Connection>& connection,
+    std::vector<detail::execute_messages_argument_t<Connection>> const& programs)
+{
+	return detail::ExecutorMessages<MultiConnection<Connection>>().execute_pooled(
+	    connection, programs);
+}
+
 } // namespace hxcomm
\ No newline at end of file
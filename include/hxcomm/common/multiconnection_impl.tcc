@@ -1,13 +1,18 @@
+#include "hxcomm/common/construct_connections.h"
 #include "hxcomm/common/multiconnection.h"
 
-#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
 
 namespace hxcomm {
 
 template <typename Connection>
 MultiConnection<Connection>::MultiConnection()
+    requires std::is_default_constructible_v<Connection>
 {
 	m_connections.emplace_back(Connection());
+	start_workers();
 }
 
 
@@ -15,21 +20,21 @@ template <typename Connection>
 MultiConnection<Connection>::MultiConnection(std::vector<Connection>&& connections) :
     m_connections(std::move(connections))
 {
+	start_workers();
 }
 
 
 template <typename Connection>
-MultiConnection<Connection>::MultiConnection(init_parameters_type const& connection_inits)
+MultiConnection<Connection>::MultiConnection(init_parameters_type const& connection_inits) :
+    m_connections(construct_connections<Connection>(std::get<0>(connection_inits)))
 {
-	for (auto const& connection_init : get<0>(connection_inits)) {
-		m_connections.emplace_back(std::move(Connection(connection_init)));
-	}
+	start_workers();
 }
 
 
 template <typename Connection>
 MultiConnection<Connection>::MultiConnection(MultiConnection&& other) :
-    m_connections(std::move(other.m_connections))
+    m_connections(std::move(other.m_connections)), m_workers(std::move(other.m_workers))
 {
 }
 
@@ -39,11 +44,22 @@ MultiConnection<Connection>& MultiConnection<Connection>::operator=(MultiConnect
 {
 	if (this != &other) {
 		m_connections = std::move(other.m_connections);
+		m_workers = std::move(other.m_workers);
 	}
 	return *this;
 }
 
 
+template <typename Connection>
+void MultiConnection<Connection>::start_workers()
+{
+	for (size_t i = m_workers.size(); i < m_connections.size(); ++i) {
+		m_workers.push_back(
+		    std::make_unique<ConnectionWorker>("MultiConnection execute " + std::to_string(i)));
+	}
+}
+
+
 template <typename Connection>
 Connection& MultiConnection<Connection>::operator[](size_t index)
 {
@@ -68,6 +84,18 @@ std::vector<ConnectionTimeInfo> MultiConnection<Connection>::get_time_info() con
 	return time_infos;
 }
 
+template <typename Connection>
+std::vector<ConnectionWireInfo> MultiConnection<Connection>::get_wire_info() const
+    requires requires(Connection const& connection) { connection.get_wire_info(); }
+{
+	std::vector<ConnectionWireInfo> wire_infos;
+	for (auto const& connection : m_connections) {
+		wire_infos.push_back(connection.get_wire_info());
+	}
+
+	return wire_infos;
+}
+
 
 template <typename Connection>
 std::vector<std::string> MultiConnection<Connection>::get_unique_identifier(
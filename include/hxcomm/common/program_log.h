@@ -0,0 +1,233 @@
+#pragma once
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/recording_file.h"
+#include "hxcomm/common/utmessage.h"
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace hxcomm::detail {
+
+/**
+ * Layout of program log files written by RecordingConnection and read by ReplayConnection.
+ *
+ * The file starts with a RecordingFileHeader of the send and receive message variants.
+ * It is followed by one record per executed program, consisting of the number of program
+ * messages, the number of responses, the time information of the execution as nanoseconds of
+ * encoding, decoding, committing and execution, the program messages and the responses.
+ * Each message is stored as its type index followed by the words of its payload in host byte
+ * order, so that the stored program messages identify a program byte by byte.
+ * @tparam ConnectionParameter Connection parameter of recorded messages
+ */
+template <typename ConnectionParameter>
+struct ProgramLogFormat
+{
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+
+	typedef uint8_t type_index_type;
+	typedef uint64_t count_type;
+	typedef int64_t duration_type;
+	typedef RecordingFileHeader<send_message_type, receive_message_type> header_type;
+
+	static_assert(
+	    std::variant_size_v<send_message_type> <=
+	        (size_t(1) << (sizeof(type_index_type) * CHAR_BIT)),
+	    "Send message types not representable by type index.");
+	static_assert(
+	    std::variant_size_v<receive_message_type> <=
+	        (size_t(1) << (sizeof(type_index_type) * CHAR_BIT)),
+	    "Receive message types not representable by type index.");
+
+	static constexpr typename header_type::magic_type magic = {
+	    'H', 'X', 'C', 'O', 'M', 'M', 'P', 'L'};
+	static constexpr typename header_type::word_type version = 1;
+
+	/**
+	 * Size in bytes of the counts and time information preceding the messages of a record.
+	 */
+	static constexpr size_t record_header_size = 2 * sizeof(count_type) + 4 * sizeof(duration_type);
+
+	/**
+	 * Append file header.
+	 * @param bytes Buffer to append to
+	 */
+	static void encode_header(std::vector<uint8_t>& bytes)
+	{
+		auto const header = header_type::encode(magic, version);
+		bytes.insert(bytes.end(), header.begin(), header.end());
+	}
+
+	/**
+	 * Check file header.
+	 * @param position Position of header, advanced past it
+	 * @param end End of file content
+	 * @throws std::runtime_error On header not matching this format
+	 */
+	static void decode_header(uint8_t const*& position, uint8_t const* const end)
+	{
+		header_type::decode(position, end, magic, version, "Program log");
+	}
+
+	/**
+	 * Append record header.
+	 * @param bytes Buffer to append to
+	 * @param num_messages Number of program messages
+	 * @param num_responses Number of responses
+	 * @param time_info Time information of the execution
+	 */
+	static void encode_record_header(
+	    std::vector<uint8_t>& bytes,
+	    size_t const num_messages,
+	    size_t const num_responses,
+	    ConnectionTimeInfo const& time_info)
+	{
+		append_value(bytes, count_type(num_messages));
+		append_value(bytes, count_type(num_responses));
+		append_value(bytes, duration_type(time_info.encode_duration.count()));
+		append_value(bytes, duration_type(time_info.decode_duration.count()));
+		append_value(bytes, duration_type(time_info.commit_duration.count()));
+		append_value(bytes, duration_type(time_info.execution_duration.count()));
+	}
+
+	/**
+	 * Read record header.
+	 * @param position Position of record header, advanced past it
+	 * @param end End of file content
+	 * @param num_messages Number of program messages to read into
+	 * @param num_responses Number of responses to read into
+	 * @param time_info Time information of the execution to read into
+	 * @throws std::runtime_error On truncated file content
+	 */
+	static void decode_record_header(
+	    uint8_t const*& position,
+	    uint8_t const* const end,
+	    size_t& num_messages,
+	    size_t& num_responses,
+	    ConnectionTimeInfo& time_info)
+	{
+		num_messages = read_value<count_type>(position, end);
+		num_responses = read_value<count_type>(position, end);
+		time_info.encode_duration =
+		    std::chrono::nanoseconds(read_value<duration_type>(position, end));
+		time_info.decode_duration =
+		    std::chrono::nanoseconds(read_value<duration_type>(position, end));
+		time_info.commit_duration =
+		    std::chrono::nanoseconds(read_value<duration_type>(position, end));
+		time_info.execution_duration =
+		    std::chrono::nanoseconds(read_value<duration_type>(position, end));
+	}
+
+	/**
+	 * Append message.
+	 * @tparam Variant Message variant type
+	 * @param bytes Buffer to append to
+	 * @param message Message
+	 */
+	template <typename Variant>
+	static void encode(std::vector<uint8_t>& bytes, Variant const& message)
+	{
+		bytes.push_back(static_cast<type_index_type>(message.index()));
+		std::visit(
+		    [&bytes](auto const& m) {
+			    auto const payload = m.get_payload();
+			    auto const& words = payload.to_array();
+			    append(bytes, words.data(), sizeof(words));
+		    },
+		    message);
+	}
+
+	/**
+	 * Skip message.
+	 * @tparam Variant Message variant type
+	 * @param position Position of message, advanced past it
+	 * @param end End of file content
+	 * @throws std::runtime_error On truncated file content or invalid type index
+	 */
+	template <typename Variant>
+	static void skip(uint8_t const*& position, uint8_t const* const end)
+	{
+		auto const type_index = read_value<type_index_type>(position, end);
+		if (type_index >= std::variant_size_v<Variant>) {
+			throw std::runtime_error("Program log contains invalid message type.");
+		}
+		auto const size = recorded_payload_sizes<Variant>[type_index];
+		if (static_cast<size_t>(end - position) < size) {
+			throw std::runtime_error("Program log is truncated.");
+		}
+		position += size;
+	}
+
+	/**
+	 * Read message.
+	 * @tparam Variant Message variant type
+	 * @param position Position of message, advanced past it
+	 * @param end End of file content
+	 * @return Message
+	 * @throws std::runtime_error On truncated file content or invalid type index
+	 */
+	template <typename Variant>
+	static Variant decode(uint8_t const*& position, uint8_t const* const end)
+	{
+		auto const type_index = read_value<type_index_type>(position, end);
+		if (type_index >= std::variant_size_v<Variant>) {
+			throw std::runtime_error("Program log contains invalid message type.");
+		}
+		return decoders<Variant>[type_index](position, end);
+	}
+
+private:
+	template <typename Variant, typename Message>
+	static Variant decode_payload(uint8_t const*& position, uint8_t const* const end)
+	{
+		recorded_payload_words_type<Message> words;
+		read(position, end, words.data(), sizeof(words));
+		return Message(typename Message::payload_type(words));
+	}
+
+	template <typename Variant>
+	static constexpr auto decoders = []<size_t... Is>(std::index_sequence<Is...>) {
+		return std::array<Variant (*)(uint8_t const*&, uint8_t const*), sizeof...(Is)>{
+		    &decode_payload<Variant, std::variant_alternative_t<Is, Variant>>...};
+	}(std::make_index_sequence<std::variant_size_v<Variant>>{});
+
+	static void append(std::vector<uint8_t>& bytes, void const* const data, size_t const size)
+	{
+		auto const* const begin = static_cast<uint8_t const*>(data);
+		bytes.insert(bytes.end(), begin, begin + size);
+	}
+
+	template <typename T>
+	static void append_value(std::vector<uint8_t>& bytes, T const value)
+	{
+		append(bytes, &value, sizeof(value));
+	}
+
+	static void read(
+	    uint8_t const*& position, uint8_t const* const end, void* const data, size_t const size)
+	{
+		if (static_cast<size_t>(end - position) < size) {
+			throw std::runtime_error("Program log is truncated.");
+		}
+		std::memcpy(data, position, size);
+		position += size;
+	}
+
+	template <typename T>
+	static T read_value(uint8_t const*& position, uint8_t const* const end)
+	{
+		T value;
+		read(position, end, &value, sizeof(value));
+		return value;
+	}
+};
+
+} // namespace hxcomm::detail
@@ -3,6 +3,7 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/execute_messages.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/quiggeldy_future.h"
@@ -198,6 +199,17 @@ public:
 	 */
 	std::vector<ConnectionTimeInfo> get_time_info() const SYMBOL_VISIBLE;
 
+	/**
+	 * Get transport-level information of the server-side connections.
+	 * The counters are global and cumulative: they are accumulated over the executions of all
+	 * sessions of the server since its start, including reconnections of the server to the
+	 * backend. The difference of two calls therefore only reflects the executions of this
+	 * connection if no other session executed in between. Per-execution timing is available via
+	 * get_time_info().
+	 * @return Wire information
+	 */
+	std::vector<ConnectionWireInfo> get_wire_info() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get unique identifier from hwdb.
 	 * @param hwdb_path Optional path to hwdb
@@ -489,6 +489,14 @@ QuiggeldyConnection<ConnectionParameter, RcfClient>::get_remote_repo_state() con
 	    true, [](auto const& client) { return client->get_remote_repo_state(); });
 }
 
+template <typename ConnectionParameter, typename RcfClient>
+std::vector<ConnectionWireInfo> QuiggeldyConnection<ConnectionParameter, RcfClient>::get_wire_info()
+    const
+{
+	return retrying_client_invoke(
+	    true, [](auto const& client) { return client->get_wire_info(); });
+}
+
 template <typename ConnectionParameter, typename RcfClient>
 std::string QuiggeldyConnection<ConnectionParameter, RcfClient>::get_version_string() const
 {
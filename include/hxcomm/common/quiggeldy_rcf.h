@@ -1,5 +1,6 @@
 #pragma once
 #include "hate/visibility.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/sf_serialization.h"
 
@@ -7,4 +8,6 @@ namespace SF {
 
 void serialize(Archive& ar, hxcomm::HwdbEntry& value) SYMBOL_VISIBLE;
 
+void serialize(Archive& ar, hxcomm::ConnectionWireInfo& value) SYMBOL_VISIBLE;
+
 } // namespace SF
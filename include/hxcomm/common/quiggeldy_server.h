@@ -1,5 +1,6 @@
 #pragma once
 
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/quiggeldy_worker.h"
 
@@ -60,6 +61,12 @@ public:
 		    [](auto const& worker) { return worker.get_remote_repo_state(); });
 	}
 
+	std::vector<ConnectionWireInfo> get_wire_info()
+	{
+		return parent_t::visit_set_up_worker_const(
+		    [](auto const& worker) { return worker.get_wire_info(); });
+	}
+
 	std::vector<HwdbEntry> get_hwdb_entry()
 	{
 		return parent_t::visit_set_up_worker_const(
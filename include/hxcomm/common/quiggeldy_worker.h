@@ -4,6 +4,8 @@
 #include <munge.h>
 #endif
 
+#include "hxcomm/common/cancellation_token.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/multiconnection.h"
 #include "hxcomm/common/quiggeldy_interface_types.h"
@@ -140,6 +142,21 @@ public:
 	 */
 	void set_enable_mock_mode(bool mode_enable);
 
+	/**
+	 * Set duration each execution takes in mock-mode.
+	 * Mock executions can be cancelled via the cancellation token like real ones.
+	 *
+	 * @param duration Duration of mock executions, defaults to zero.
+	 */
+	void set_mock_execution_duration(std::chrono::nanoseconds duration);
+
+	/**
+	 * Get duration each execution takes in mock-mode.
+	 *
+	 * @return Duration of mock executions
+	 */
+	std::chrono::nanoseconds get_mock_execution_duration() const;
+
 	/**
 	 * Set or unset if the worker should perform its work with a license
 	 * allocation.
@@ -204,6 +221,15 @@ public:
 	 */
 	std::vector<std::string> get_remote_repo_state() const;
 
+	/**
+	 * Get transport-level information of the backend connections.
+	 * The counters are global and cumulative over the executions of all sessions since
+	 * construction of the worker, i.e. they include the backend connections released on
+	 * teardown or reconnection.
+	 * @return Wire information of all backend connections
+	 */
+	std::vector<ConnectionWireInfo> get_wire_info() const;
+
 	/**
 	 * Set the amount of time to wait, if connecting to the "real" backend fails.
 	 */
@@ -230,6 +256,46 @@ public:
 	 */
 	std::size_t get_max_num_connection_attemps() const;
 
+	/**
+	 * Set maximal duration of each execution on the backend connections, after which the
+	 * execution is aborted and the request fails.
+	 * Takes effect on the next (re-)connection to the backend.
+	 *
+	 * @param timeout Execution timeout, none for waiting indefinitely.
+	 */
+	void set_execution_timeout(std::optional<std::chrono::nanoseconds> timeout);
+
+	/**
+	 * Get maximal duration of each execution on the backend connections.
+	 *
+	 * @return Execution timeout
+	 */
+	std::optional<std::chrono::nanoseconds> get_execution_timeout() const;
+
+	/**
+	 * Get token to cancel the currently running execution from other threads, e.g. on
+	 * shutdown. The token is reset after an execution was cancelled.
+	 *
+	 * @return Cancellation token shared with the backend connections.
+	 */
+	CancellationToken get_cancellation_token() const;
+
+	/**
+	 * Set maximal duration to wait for the remaining responses of an aborted execution to be
+	 * discarded, after which the backend connections are set up anew.
+	 *
+	 * @param timeout Discard timeout
+	 */
+	void set_discard_timeout(std::chrono::nanoseconds timeout);
+
+	/**
+	 * Get maximal duration to wait for the remaining responses of an aborted execution to be
+	 * discarded.
+	 *
+	 * @return Discard timeout
+	 */
+	std::chrono::nanoseconds get_discard_timeout() const;
+
 	/**
 	 * Set slurm license to allocate.
 	 *
@@ -271,6 +337,20 @@ protected:
 	 */
 	void setup_connection();
 
+	/**
+	 * Wait for the backend connections to discard the remaining responses of an aborted
+	 * execution for at most the discard timeout.
+	 *
+	 * @return Whether all remaining responses were discarded
+	 */
+	bool wait_discarded();
+
+	/**
+	 * Add the wire information of the backend connections to the one of released connections
+	 * prior to releasing them.
+	 */
+	void accumulate_wire_info();
+
 
 	std::string get_slurm_jobname() const;
 
@@ -295,13 +375,18 @@ protected:
 	bool m_has_slurm_allocation;
 	bool m_allocate_license;
 	bool m_mock_mode;
+	std::chrono::nanoseconds m_mock_execution_duration;
 
 	std::unique_ptr<MultiConnection<Connection>> m_connection; // Vectorized connections.
+	std::vector<ConnectionWireInfo> m_released_wire_info;     // Of released connections.
 
 	log4cxx::LoggerPtr m_logger;
 	bool m_use_munge;
 	std::size_t m_max_num_connection_attempts;
 	std::chrono::milliseconds m_delay_after_connection_attempt;
+	std::optional<std::chrono::nanoseconds> m_execution_timeout;
+	std::chrono::nanoseconds m_discard_timeout;
+	CancellationToken m_cancellation_token;
 	std::set<boost::uuids::uuid> m_sessions_with_failed_reinit;
 	std::set<boost::uuids::uuid> m_sessions_with_failed_reinit_schedule_out;
 
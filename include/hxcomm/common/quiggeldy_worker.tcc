@@ -41,10 +41,14 @@ QuiggeldyWorker<Connection>::QuiggeldyWorker(
     m_connection_init(connection_init),
     m_has_slurm_allocation(false),
     m_mock_mode(false),
+    m_mock_execution_duration(0),
     m_logger(log4cxx::Logger::getLogger("hxcomm.QuiggeldyWorker")),
     m_use_munge(true),
     m_max_num_connection_attempts{10},
-    m_delay_after_connection_attempt{1s}
+    m_delay_after_connection_attempt{1s},
+    m_execution_timeout(),
+    m_discard_timeout{1s},
+    m_cancellation_token()
 {
 	if (m_logger->isEnabledFor(log4cxx::Level::getTrace())) {
 		assert(std::tuple_size<init_parameters_type>::value == 1);
@@ -168,12 +172,21 @@ void QuiggeldyWorker<Connection>::setup_connection()
 {
 	HXCOMM_LOG_TRACE(m_logger, "Setting up local connections.");
 	// Release old connection first because otherwise we might block ourselves.
+	accumulate_wire_info();
 	m_connection.reset();
 	// TODO: have the experiment control timeout (e.g. when the board is unresponsive)
 	std::size_t num_attempts = 0;
 	while (true) {
 		try {
 			auto new_connection = std::make_unique<MultiConnection<Connection>>(m_connection_init);
+			if constexpr (requires(Connection & connection) {
+				              connection.set_cancellation_token(m_cancellation_token);
+			              }) {
+				for (size_t i = 0; i < new_connection->size(); ++i) {
+					(*new_connection)[i].set_execution_timeout(m_execution_timeout);
+					(*new_connection)[i].set_cancellation_token(m_cancellation_token);
+				}
+			}
 			m_connection.swap(new_connection);
 			break;
 		} catch (std::exception& e) {
@@ -227,6 +240,7 @@ void QuiggeldyWorker<Connection>::teardown()
 {
 	HXCOMM_LOG_DEBUG(m_logger, "teardown() started..");
 	if (!m_mock_mode) {
+		accumulate_wire_info();
 		m_connection.reset();
 		if (m_allocate_license) {
 			slurm_allocation_release();
@@ -313,6 +327,16 @@ typename QuiggeldyWorker<Connection>::return_type QuiggeldyWorker<Connection>::w
 
 	if (m_mock_mode) {
 		HXCOMM_LOG_DEBUG(m_logger, "Running mock-experiment!");
+		// mock executions take the configured duration unless cancelled
+		auto const deadline = std::chrono::steady_clock::now() + m_mock_execution_duration;
+		while (std::chrono::steady_clock::now() < deadline) {
+			if (m_cancellation_token.is_cancelled()) {
+				HXCOMM_LOG_ERROR(m_logger, "Aborted mock-experiment.");
+				m_cancellation_token.reset();
+				throw ExecutionAborted("Execution was cancelled.");
+			}
+			std::this_thread::sleep_for(1ms);
+		}
 		return return_type{};
 	}
 
@@ -329,6 +353,18 @@ typename QuiggeldyWorker<Connection>::return_type QuiggeldyWorker<Connection>::w
 		}
 
 		return retval;
+	} catch (ExecutionAborted const& e) {
+		HXCOMM_LOG_ERROR(m_logger, "Aborted word execution: " << e.what());
+		m_cancellation_token.reset();
+		// the connections discard the remaining responses, a reconnect is only required if the
+		// halt response of the aborted execution does not arrive in time
+		if (!wait_discarded()) {
+			HXCOMM_LOG_WARN(
+			    m_logger, "Responses of aborted execution not discarded within "
+			                  << m_discard_timeout.count() << "ns -> resetting connection.");
+			setup_connection();
+		}
+		throw;
 	} catch (const std::exception& e) {
 		HXCOMM_LOG_ERROR(m_logger, "Error during word execution: " << e.what());
 		throw;
@@ -624,6 +660,37 @@ std::vector<std::string> QuiggeldyWorker<Connection>::get_remote_repo_state() co
 	return repo_state;
 }
 
+template <typename Connection>
+std::vector<ConnectionWireInfo> QuiggeldyWorker<Connection>::get_wire_info() const
+{
+	if (!m_connection && m_released_wire_info.empty()) {
+		throw std::runtime_error("Requested wire info of uninitialized connection.");
+	}
+	auto wire_info = m_released_wire_info;
+	if (m_connection) {
+		auto const connection_wire_info = m_connection->get_wire_info();
+		wire_info.resize(std::max(wire_info.size(), connection_wire_info.size()));
+		for (size_t i = 0; i < connection_wire_info.size(); ++i) {
+			wire_info[i] += connection_wire_info[i];
+		}
+	}
+	return wire_info;
+}
+
+template <typename Connection>
+void QuiggeldyWorker<Connection>::accumulate_wire_info()
+{
+	if (!m_connection) {
+		return;
+	}
+	auto const connection_wire_info = m_connection->get_wire_info();
+	m_released_wire_info.resize(
+	    std::max(m_released_wire_info.size(), connection_wire_info.size()));
+	for (size_t i = 0; i < connection_wire_info.size(); ++i) {
+		m_released_wire_info[i] += connection_wire_info[i];
+	}
+}
+
 template <typename Connection>
 void QuiggeldyWorker<Connection>::set_delay_after_connection_attempt(
     std::chrono::milliseconds delay)
@@ -649,6 +716,70 @@ std::size_t QuiggeldyWorker<Connection>::get_max_num_connection_attemps() const
 	return m_max_num_connection_attempts;
 }
 
+template <typename Connection>
+void QuiggeldyWorker<Connection>::set_execution_timeout(
+    std::optional<std::chrono::nanoseconds> timeout)
+{
+	m_execution_timeout = timeout;
+}
+
+template <typename Connection>
+std::optional<std::chrono::nanoseconds> QuiggeldyWorker<Connection>::get_execution_timeout() const
+{
+	return m_execution_timeout;
+}
+
+template <typename Connection>
+CancellationToken QuiggeldyWorker<Connection>::get_cancellation_token() const
+{
+	return m_cancellation_token;
+}
+
+template <typename Connection>
+void QuiggeldyWorker<Connection>::set_mock_execution_duration(
+    std::chrono::nanoseconds const duration)
+{
+	m_mock_execution_duration = duration;
+}
+
+template <typename Connection>
+std::chrono::nanoseconds QuiggeldyWorker<Connection>::get_mock_execution_duration() const
+{
+	return m_mock_execution_duration;
+}
+
+template <typename Connection>
+void QuiggeldyWorker<Connection>::set_discard_timeout(std::chrono::nanoseconds const timeout)
+{
+	m_discard_timeout = timeout;
+}
+
+template <typename Connection>
+std::chrono::nanoseconds QuiggeldyWorker<Connection>::get_discard_timeout() const
+{
+	return m_discard_timeout;
+}
+
+template <typename Connection>
+bool QuiggeldyWorker<Connection>::wait_discarded()
+{
+	if constexpr (requires(Connection & connection) {
+		              connection.wait_discarded(std::chrono::nanoseconds());
+	              }) {
+		auto const deadline = std::chrono::steady_clock::now() + m_discard_timeout;
+		for (size_t i = 0; i < m_connection->size(); ++i) {
+			auto const remaining = std::max(
+			    std::chrono::nanoseconds(0),
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(
+			        deadline - std::chrono::steady_clock::now()));
+			if (!(*m_connection)[i].wait_discarded(remaining)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 template <typename Connection>
 std::string QuiggeldyWorker<Connection>::get_slurm_jobname() const
 {
@@ -0,0 +1,159 @@
+#pragma once
+#include "hate/visibility.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+
+namespace hxcomm {
+
+/**
+ * Policy of receive worker threads on how to wait while no data is available from the backend.
+ */
+struct ReceiveWaitPolicy
+{
+	enum class Mode
+	{
+		spin,       /* poll continuously, lowest latency at the cost of one core per connection */
+		spin_yield, /* poll continuously for spin_count polls, then yield after each poll */
+		block       /* poll, yield and then block with exponentially growing timeout up to
+		               max_wait, woken up immediately on activity of the connection */
+	};
+
+	/**
+	 * Waiting mode.
+	 */
+	Mode mode = Mode::block;
+
+	/**
+	 * Number of polls without available data before yielding to other threads.
+	 */
+	size_t spin_count = 10000;
+
+	/**
+	 * Number of yielding polls without available data before blocking.
+	 * Only used in Mode::block.
+	 */
+	size_t yield_count = 1000;
+
+	/**
+	 * Maximal duration of a single blocking wait.
+	 * Only used in Mode::block. Bounds the receive latency of data arriving while the
+	 * connection is idle.
+	 */
+	std::chrono::microseconds max_wait{10000};
+
+	/**
+	 * Get policy from environment.
+	 * The mode is read from HXCOMM_RECEIVE_WAIT_POLICY, one of {spin,spin_yield,block}, defaults
+	 * to block if not set.
+	 * @throws std::runtime_error On unknown mode in environment
+	 * @return Policy
+	 */
+	static ReceiveWaitPolicy from_env() SYMBOL_VISIBLE;
+
+	bool operator==(ReceiveWaitPolicy const& other) const SYMBOL_VISIBLE;
+	bool operator!=(ReceiveWaitPolicy const& other) const SYMBOL_VISIBLE;
+
+	friend std::ostream& operator<<(std::ostream& os, ReceiveWaitPolicy const& policy)
+	    SYMBOL_VISIBLE;
+};
+
+std::ostream& operator<<(std::ostream& os, ReceiveWaitPolicy::Mode const& mode) SYMBOL_VISIBLE;
+
+
+/**
+ * Waiter implementing a receive wait policy for a single receive worker thread.
+ * The worker calls wait() for every poll without available data and reset() after having
+ * processed data. Other threads signal upcoming activity (e.g. after sending data to which
+ * responses are expected) via notify() and keep the worker from blocking during executions via
+ * an Active scope.
+ */
+class ReceiveWaiter
+{
+public:
+	/**
+	 * Construct waiter with policy.
+	 * @param policy Policy to use
+	 */
+	ReceiveWaiter(ReceiveWaitPolicy const& policy = ReceiveWaitPolicy::from_env()) SYMBOL_VISIBLE;
+
+	ReceiveWaiter(ReceiveWaiter const&) = delete;
+	ReceiveWaiter& operator=(ReceiveWaiter const&) = delete;
+
+	/**
+	 * Set policy.
+	 * The policy change is picked up by the worker with its next wait() call.
+	 * @param policy Policy to use
+	 */
+	void set_policy(ReceiveWaitPolicy const& policy) SYMBOL_VISIBLE;
+
+	/**
+	 * Get policy.
+	 * @return Policy in use
+	 */
+	ReceiveWaitPolicy get_policy() const SYMBOL_VISIBLE;
+
+	/**
+	 * Wait once after a poll without available data.
+	 * To be called from the worker thread only.
+	 */
+	void wait() SYMBOL_VISIBLE;
+
+	/**
+	 * Reset waiting state after data was processed.
+	 * To be called from the worker thread only.
+	 */
+	void reset() SYMBOL_VISIBLE;
+
+	/**
+	 * Wake up the worker and restart its waiting state from polling.
+	 * May be called from any thread.
+	 */
+	void notify() SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of waits which blocked the worker until notification or timeout.
+	 * @return Number of blocking waits since construction
+	 */
+	size_t get_num_blocking_waits() const SYMBOL_VISIBLE;
+
+	/**
+	 * Scope during which the worker is expected to receive data soon.
+	 * On construction the worker is woken up and it does not block during the lifetime of the
+	 * scope.
+	 */
+	class Active
+	{
+	public:
+		Active(ReceiveWaiter& waiter) SYMBOL_VISIBLE;
+		~Active() SYMBOL_VISIBLE;
+
+		Active(Active const&) = delete;
+		Active& operator=(Active const&) = delete;
+
+	private:
+		ReceiveWaiter& m_waiter;
+	};
+
+private:
+	static constexpr std::chrono::microseconds initial_wait{1};
+
+	std::atomic<ReceiveWaitPolicy::Mode> m_mode;
+	std::atomic<size_t> m_spin_count;
+	std::atomic<size_t> m_yield_count;
+	std::atomic<std::chrono::microseconds::rep> m_max_wait;
+
+	size_t m_idle_count;
+	std::chrono::microseconds m_current_wait;
+
+	std::atomic<size_t> m_active;
+	std::atomic<bool> m_notified;
+	std::atomic<size_t> m_num_blocking_waits;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+};
+
+} // namespace hxcomm
@@ -0,0 +1,155 @@
+#pragma once
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <unistd.h>
+
+namespace hxcomm::detail {
+
+/**
+ * Words of the payload of a message as stored in recording files, i.e. in host byte order.
+ * @tparam Message Message type
+ */
+template <typename Message>
+using recorded_payload_words_type = std::remove_cvref_t<
+    decltype(std::declval<typename Message::payload_type const&>().to_array())>;
+
+/**
+ * Size in bytes of the stored payload of each message type of a variant by type index.
+ * @tparam Variant Message variant type
+ */
+template <typename Variant>
+constexpr auto recorded_payload_sizes = []<size_t... Is>(std::index_sequence<Is...>) {
+	return std::array<size_t, sizeof...(Is)>{
+	    sizeof(recorded_payload_words_type<std::variant_alternative_t<Is, Variant>>)...};
+}(std::make_index_sequence<std::variant_size_v<Variant>>{});
+
+/**
+ * Header of the files written by ResponseSink and RecordingConnection.
+ * It consists of a magic identifying the kind of file, the format version and, for each message
+ * variant, the number of message types followed by the size in bytes of the stored payload of
+ * each type, so that files recorded with different message types are rejected.
+ * @tparam Variants Message variant types stored in the file
+ */
+template <typename... Variants>
+struct RecordingFileHeader
+{
+	typedef uint32_t word_type;
+	typedef std::array<char, 8> magic_type;
+
+	/**
+	 * Encode header.
+	 * @param magic Magic of the kind of file
+	 * @param version Format version
+	 * @return Header bytes
+	 */
+	static std::vector<uint8_t> encode(magic_type const& magic, word_type const version)
+	{
+		auto const types = type_table();
+		std::vector<uint8_t> bytes(
+		    sizeof(magic) + sizeof(version) + types.size() * sizeof(word_type));
+		auto* position = bytes.data();
+		auto const append = [&position](void const* const data, size_t const size) {
+			std::memcpy(position, data, size);
+			position += size;
+		};
+		append(magic.data(), sizeof(magic));
+		append(&version, sizeof(version));
+		append(types.data(), types.size() * sizeof(word_type));
+		return bytes;
+	}
+
+	/**
+	 * Check header.
+	 * @param position Position of header, advanced past it
+	 * @param end End of file content
+	 * @param magic Expected magic of the kind of file
+	 * @param version Expected format version
+	 * @param name Name of the file used in error messages
+	 * @throws std::runtime_error On truncated file content or header not matching
+	 */
+	static void decode(
+	    uint8_t const*& position,
+	    uint8_t const* const end,
+	    magic_type const& magic,
+	    word_type const version,
+	    std::string const& name)
+	{
+		auto const read = [&](void* const data, size_t const size) {
+			if (static_cast<size_t>(end - position) < size) {
+				throw std::runtime_error(name + " is truncated.");
+			}
+			std::memcpy(data, position, size);
+			position += size;
+		};
+
+		magic_type file_magic;
+		read(file_magic.data(), sizeof(file_magic));
+		if (file_magic != magic) {
+			throw std::runtime_error(name + " has unknown format.");
+		}
+		word_type file_version;
+		read(&file_version, sizeof(file_version));
+		if (file_version != version) {
+			throw std::runtime_error(
+			    name + " has unsupported format version " + std::to_string(file_version) + ".");
+		}
+		for (auto const word : type_table()) {
+			word_type file_word;
+			read(&file_word, sizeof(file_word));
+			if (file_word != word) {
+				throw std::runtime_error(name + " was recorded with different message types.");
+			}
+		}
+	}
+
+private:
+	static std::vector<word_type> type_table()
+	{
+		std::vector<word_type> words;
+		auto const append = [&words]<typename Variant>(std::type_identity<Variant>) {
+			words.push_back(std::variant_size_v<Variant>);
+			for (auto const size : recorded_payload_sizes<Variant>) {
+				words.push_back(size);
+			}
+		};
+		(append(std::type_identity<Variants>{}), ...);
+		return words;
+	}
+};
+
+/**
+ * Write all bytes to a file descriptor, continuing after partial writes and interruptions by
+ * signals.
+ * @param fd File descriptor
+ * @param data Bytes to write
+ * @param size Number of bytes to write
+ * @return Zero on success, errno of the failed write otherwise
+ */
+inline int write_all(int const fd, void const* const data, size_t const size)
+{
+	auto const* position = static_cast<uint8_t const*>(data);
+	size_t remaining = size;
+	while (remaining) {
+		auto const written = ::write(fd, position, remaining);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return errno;
+		}
+		position += written;
+		remaining -= written;
+	}
+	return 0;
+}
+
+} // namespace hxcomm::detail
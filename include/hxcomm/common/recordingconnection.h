@@ -0,0 +1,317 @@
+#pragma once
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/hwdb_entry.h"
+#include "hxcomm/common/program_log.h"
+#include "hxcomm/common/stream.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace hxcomm {
+
+template <typename Connection>
+struct MultiConnection;
+
+/**
+ * Connection wrapping another connection and recording each executed program to a program log.
+ * A program consists of all messages added after the previous program up to and including its
+ * halt message, so that pipelined programs are recorded separately. Once both its execution is
+ * finished and its halt response is received, the program is written to the log together with
+ * its responses and the time information spent on it by the wrapped connection since the end of
+ * the previous program or its first message.
+ * Programs in flight when an execution fails with an exception are not recorded.
+ * Recorded programs can be executed without hardware by a ReplayConnection.
+ * @tparam Connection Wrapped connection type
+ */
+template <typename Connection>
+class RecordingConnection
+{
+public:
+	typedef Connection connection_type;
+	typedef typename Connection::message_types::connection_parameter_type connection_parameter_type;
+
+	HXCOMM_EXPOSE_MESSAGE_TYPES(connection_parameter_type)
+
+	// Needs to be specified for each connection type to be able to construct a MultiConnection of
+	// that type.
+	using init_parameters_type =
+	    std::tuple<typename Connection::init_parameters_type, std::string>;
+
+	static const std::string name;
+
+	/**
+	 * Construct recording connection wrapping a connection.
+	 * @param connection Connection to wrap
+	 * @param path Path of the program log to create
+	 * @throws std::runtime_error On failure to create the program log
+	 */
+	RecordingConnection(Connection&& connection, std::string const& path);
+
+	/**
+	 * Construct recording connection from parameter tuple.
+	 * @param params Parameters of the wrapped connection and path of the program log
+	 */
+	RecordingConnection(init_parameters_type const& params);
+
+	RecordingConnection(RecordingConnection const&) = delete;
+	RecordingConnection& operator=(RecordingConnection const&) = delete;
+	RecordingConnection(RecordingConnection&& other);
+	RecordingConnection& operator=(RecordingConnection&& other);
+
+	/**
+	 * Close the program log discarding a not yet finished program.
+	 */
+	~RecordingConnection();
+
+	static constexpr auto supported_targets = Connection::supported_targets;
+	typedef typename Connection::receive_queue_type receive_queue_type;
+
+	/**
+	 * Get time information of the wrapped connection.
+	 * @return Time information
+	 */
+	ConnectionTimeInfo get_time_info() const;
+
+	/**
+	 * Get unique identifier of the wrapped connection.
+	 * @param hwdb_path Optional path to hwdb
+	 * @return Unique identifier
+	 */
+	std::string get_unique_identifier(std::optional<std::string> hwdb_path = std::nullopt) const;
+
+	/**
+	 * Get hwdb entry of the wrapped connection.
+	 * @return Hwdb entry
+	 */
+	HwdbEntry get_hwdb_entry() const;
+
+	/**
+	 * Get bitfile information of the wrapped connection.
+	 * @return Bitfile info
+	 */
+	std::string get_bitfile_info() const;
+
+	/**
+	 * Get server-side remote repository state information of the wrapped connection.
+	 * @return Repository state
+	 */
+	std::string get_remote_repo_state() const;
+
+	/**
+	 * Get path of the program log.
+	 * @return Path
+	 */
+	std::string const& get_path() const;
+
+	/**
+	 * Get number of programs written to the program log.
+	 * @return Number of programs
+	 */
+	size_t get_num_recorded_programs() const;
+
+private:
+	friend MultiConnection<RecordingConnection>;
+
+	friend Stream<RecordingConnection>;
+
+	typedef detail::ProgramLogFormat<connection_parameter_type> format_type;
+
+	/**
+	 * Add a single UT message to the send queue.
+	 * @param message Message to add
+	 */
+	void add(send_message_type const& message);
+
+	/**
+	 * Add multiple UT messages to the send queue.
+	 * @tparam InputIterator Iterator type to sequence of messages to add
+	 * @param begin Iterator to beginning of sequence
+	 * @param end Iterator to end of sequence
+	 */
+	template <typename InputIterator>
+	void add(InputIterator const& begin, InputIterator const& end);
+
+	/**
+	 * Send messages in send queue.
+	 */
+	void commit();
+
+	/**
+	 * Receive all UT messages.
+	 * @return Received messages
+	 */
+	receive_queue_type receive_all();
+
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer);
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive();
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message);
+
+	/**
+	 * Try to receive a single UT message waiting at most for the given duration.
+	 * @param message Message to receive to
+	 * @param timeout Maximal duration to wait for a message
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout);
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Maximal duration to wait for the first message
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout);
+
+	/**
+	 * Get whether the halt response was received and all messages up to it were received.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const;
+
+	/**
+	 * Get whether the connection has no UT messages available to receive.
+	 * @return Boolean value
+	 */
+	bool receive_empty() const;
+
+	/**
+	 * Start execution and wait until halt instruction.
+	 */
+	void run_until_halt();
+
+	/**
+	 * Get internal mutex to use for mutual exclusion.
+	 * @return Mutable reference to mutex
+	 */
+	std::mutex& get_mutex();
+
+	/**
+	 * Release the stream of the other connection and move its wrapped connection.
+	 * @param other Connection to move from
+	 * @return Rvalue reference to wrapped connection of other
+	 */
+	static Connection&& release(RecordingConnection& other);
+
+	/**
+	 * Append messages to the program in progress, starting a new program after each halt
+	 * message.
+	 * @param begin Iterator to beginning of sequence
+	 * @param end Iterator to end of sequence
+	 */
+	template <typename InputIterator>
+	void record_program(InputIterator const& begin, InputIterator const& end);
+
+	/**
+	 * Append received messages to the responses of the first program without halt response.
+	 * @param begin Iterator to beginning of sequence
+	 * @param end Iterator to end of sequence
+	 */
+	template <typename InputIterator>
+	void record_responses(InputIterator const& begin, InputIterator const& end);
+
+	/**
+	 * Write finished programs to the program log, expects lock of m_record_mutex.
+	 * A program is finished if both its execution is finished and its halt response is
+	 * received.
+	 */
+	void write_finished();
+
+	/**
+	 * Discard all not yet written programs, expects lock of m_record_mutex.
+	 */
+	void discard();
+
+	/**
+	 * Open program log and write its header.
+	 */
+	void open();
+
+	/**
+	 * Close program log.
+	 */
+	void close();
+
+	Connection m_connection;
+	/**
+	 * Stream of the wrapped connection held for the lifetime of the wrapper, since the wrapped
+	 * connection is accessed concurrently, e.g. while run_until_halt() is in progress.
+	 */
+	std::unique_ptr<Stream<Connection>> m_stream;
+
+	std::string m_path;
+	int m_fd;
+	size_t m_num_recorded_programs;
+
+	/**
+	 * Program of which messages and responses are stored in program log format.
+	 */
+	struct Program
+	{
+		std::vector<uint8_t> messages;
+		size_t num_messages = 0;
+		std::vector<uint8_t> responses;
+		size_t num_responses = 0;
+	};
+
+	/**
+	 * Program in progress, which is not yet terminated by a halt message.
+	 */
+	Program m_program;
+	/**
+	 * Programs terminated by a halt message in order of submission, of which the first
+	 * m_num_halt_received ones received their halt response.
+	 */
+	std::deque<Program> m_programs;
+	size_t m_num_halt_received;
+	/**
+	 * Number of finished run_until_halt() invocations of programs not yet written.
+	 */
+	size_t m_num_run_finished;
+	/**
+	 * Time information at the beginning of the first not yet written program.
+	 */
+	std::optional<ConnectionTimeInfo> m_time_begin;
+
+	std::mutex m_record_mutex;
+	std::mutex m_mutex;
+};
+
+template <typename Connection>
+const std::string RecordingConnection<Connection>::name =
+    std::string("Recording") + Connection::name;
+
+namespace detail {
+
+template <typename Connection>
+struct executes_on_commit<RecordingConnection<Connection>> : executes_on_commit<Connection>
+{};
+
+} // namespace detail
+
+} // namespace hxcomm
+
+#include "hxcomm/common/recordingconnection.tcc"
@@ -0,0 +1,348 @@
+#include "hxcomm/common/recordingconnection.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hxcomm {
+
+template <typename Connection>
+RecordingConnection<Connection>::RecordingConnection(
+    Connection&& connection, std::string const& path) :
+    m_connection(std::move(connection)),
+    m_stream(std::make_unique<Stream<Connection>>(m_connection)),
+    m_path(path),
+    m_fd(-1),
+    m_num_recorded_programs(0),
+    m_program(),
+    m_programs(),
+    m_num_halt_received(0),
+    m_num_run_finished(0),
+    m_time_begin(),
+    m_record_mutex(),
+    m_mutex()
+{
+	open();
+}
+
+template <typename Connection>
+RecordingConnection<Connection>::RecordingConnection(init_parameters_type const& params) :
+    RecordingConnection(Connection(std::get<0>(params)), std::get<1>(params))
+{}
+
+template <typename Connection>
+Connection&& RecordingConnection<Connection>::release(RecordingConnection& other)
+{
+	other.m_stream.reset();
+	return std::move(other.m_connection);
+}
+
+template <typename Connection>
+RecordingConnection<Connection>::RecordingConnection(RecordingConnection&& other) :
+    m_connection(release(other)),
+    m_stream(std::make_unique<Stream<Connection>>(m_connection)),
+    m_path(std::move(other.m_path)),
+    m_fd(std::exchange(other.m_fd, -1)),
+    m_num_recorded_programs(other.m_num_recorded_programs),
+    m_program(std::exchange(other.m_program, Program())),
+    m_programs(std::move(other.m_programs)),
+    m_num_halt_received(std::exchange(other.m_num_halt_received, 0)),
+    m_num_run_finished(std::exchange(other.m_num_run_finished, 0)),
+    m_time_begin(std::exchange(other.m_time_begin, std::nullopt)),
+    m_record_mutex(),
+    m_mutex()
+{}
+
+template <typename Connection>
+RecordingConnection<Connection>& RecordingConnection<Connection>::operator=(
+    RecordingConnection&& other)
+{
+	if (this != &other) {
+		close();
+		m_stream.reset();
+		m_connection = release(other);
+		m_stream = std::make_unique<Stream<Connection>>(m_connection);
+		m_path = std::move(other.m_path);
+		m_fd = std::exchange(other.m_fd, -1);
+		m_num_recorded_programs = other.m_num_recorded_programs;
+		m_program = std::exchange(other.m_program, Program());
+		m_programs = std::move(other.m_programs);
+		m_num_halt_received = std::exchange(other.m_num_halt_received, 0);
+		m_num_run_finished = std::exchange(other.m_num_run_finished, 0);
+		m_time_begin = std::exchange(other.m_time_begin, std::nullopt);
+	}
+	return *this;
+}
+
+template <typename Connection>
+RecordingConnection<Connection>::~RecordingConnection()
+{
+	close();
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::open()
+{
+	m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0) {
+		throw std::runtime_error(
+		    "RecordingConnection failed to open " + m_path + ": " + std::strerror(errno));
+	}
+	std::vector<uint8_t> header;
+	format_type::encode_header(header);
+	if (auto const error = detail::write_all(m_fd, header.data(), header.size()); error) {
+		close();
+		throw std::runtime_error(
+		    "RecordingConnection failed to write to " + m_path + ": " + std::strerror(error));
+	}
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::close()
+{
+	if (m_fd >= 0) {
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+template <typename Connection>
+ConnectionTimeInfo RecordingConnection<Connection>::get_time_info() const
+{
+	return m_connection.get_time_info();
+}
+
+template <typename Connection>
+std::string RecordingConnection<Connection>::get_unique_identifier(
+    std::optional<std::string> hwdb_path) const
+{
+	return m_connection.get_unique_identifier(hwdb_path);
+}
+
+template <typename Connection>
+HwdbEntry RecordingConnection<Connection>::get_hwdb_entry() const
+{
+	return m_connection.get_hwdb_entry();
+}
+
+template <typename Connection>
+std::string RecordingConnection<Connection>::get_bitfile_info() const
+{
+	return m_connection.get_bitfile_info();
+}
+
+template <typename Connection>
+std::string RecordingConnection<Connection>::get_remote_repo_state() const
+{
+	return m_connection.get_remote_repo_state();
+}
+
+template <typename Connection>
+std::string const& RecordingConnection<Connection>::get_path() const
+{
+	return m_path;
+}
+
+template <typename Connection>
+size_t RecordingConnection<Connection>::get_num_recorded_programs() const
+{
+	return m_num_recorded_programs;
+}
+
+template <typename Connection>
+template <typename InputIterator>
+void RecordingConnection<Connection>::record_program(
+    InputIterator const& begin, InputIterator const& end)
+{
+	std::lock_guard<std::mutex> lock(m_record_mutex);
+	if (!m_time_begin) {
+		m_time_begin = m_connection.get_time_info();
+	}
+	for (auto it = begin; it != end; ++it) {
+		format_type::encode(m_program.messages, *it);
+		m_program.num_messages++;
+		auto const* const halt = std::get_if<send_halt_message_type>(&*it);
+		if (halt && (halt->decode() == send_halt_message_type::instruction_type::halt)) {
+			m_programs.push_back(std::exchange(m_program, Program()));
+		}
+	}
+}
+
+template <typename Connection>
+template <typename InputIterator>
+void RecordingConnection<Connection>::record_responses(
+    InputIterator const& begin, InputIterator const& end)
+{
+	typedef typename message_types::receive_halt_type receive_halt_type;
+
+	std::lock_guard<std::mutex> lock(m_record_mutex);
+	for (auto it = begin; it != end; ++it) {
+		auto& program = (m_num_halt_received < m_programs.size())
+		                    ? m_programs[m_num_halt_received]
+		                    : m_program;
+		format_type::encode(program.responses, *it);
+		program.num_responses++;
+		auto const* const halt = std::get_if<receive_halt_type>(&*it);
+		if (halt && (halt->decode() == receive_halt_type::instruction_type::halt) &&
+		    (&program != &m_program)) {
+			m_num_halt_received++;
+		}
+	}
+	write_finished();
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::write_finished()
+{
+	std::vector<uint8_t> records;
+	while (m_num_halt_received && m_num_run_finished) {
+		auto const& program = m_programs.front();
+		auto const time_end = m_connection.get_time_info();
+		format_type::encode_record_header(
+		    records, program.num_messages, program.num_responses,
+		    time_end - m_time_begin.value_or(time_end));
+		records.insert(records.end(), program.messages.begin(), program.messages.end());
+		records.insert(records.end(), program.responses.begin(), program.responses.end());
+		m_programs.pop_front();
+		m_num_halt_received--;
+		m_num_run_finished--;
+		m_num_recorded_programs++;
+		// subsequent programs begin with the end of the current one, as for pipelined execution
+		if (m_programs.empty() && !m_program.num_messages) {
+			m_time_begin.reset();
+		} else {
+			m_time_begin = time_end;
+		}
+	}
+
+	if (auto const error = detail::write_all(m_fd, records.data(), records.size()); error) {
+		throw std::runtime_error(
+		    "RecordingConnection failed to write to " + m_path + ": " + std::strerror(error));
+	}
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::discard()
+{
+	m_program = Program();
+	m_programs.clear();
+	m_num_halt_received = 0;
+	m_num_run_finished = 0;
+	m_time_begin.reset();
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::add(send_message_type const& message)
+{
+	record_program(&message, &message + 1);
+	m_stream->add(message);
+}
+
+template <typename Connection>
+template <typename InputIterator>
+void RecordingConnection<Connection>::add(InputIterator const& begin, InputIterator const& end)
+{
+	record_program(begin, end);
+	m_stream->add(begin, end);
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::commit()
+{
+	m_stream->commit();
+}
+
+template <typename Connection>
+typename RecordingConnection<Connection>::receive_queue_type
+RecordingConnection<Connection>::receive_all()
+{
+	auto responses = m_stream->receive_all();
+	record_responses(responses.begin(), responses.end());
+	return responses;
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::receive_into(receive_queue_type& buffer)
+{
+	m_stream->receive_into(buffer);
+	record_responses(buffer.begin(), buffer.end());
+}
+
+template <typename Connection>
+typename RecordingConnection<Connection>::receive_message_type
+RecordingConnection<Connection>::receive()
+{
+	auto message = m_stream->receive();
+	record_responses(&message, &message + 1);
+	return message;
+}
+
+template <typename Connection>
+bool RecordingConnection<Connection>::try_receive(receive_message_type& message)
+{
+	if (!m_stream->try_receive(message)) {
+		return false;
+	}
+	record_responses(&message, &message + 1);
+	return true;
+}
+
+template <typename Connection>
+bool RecordingConnection<Connection>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const timeout)
+{
+	if (!m_stream->try_receive(message, timeout)) {
+		return false;
+	}
+	record_responses(&message, &message + 1);
+	return true;
+}
+
+template <typename Connection>
+size_t RecordingConnection<Connection>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const timeout)
+{
+	auto const begin = buffer.size();
+	auto const num_received = m_stream->receive_some(buffer, timeout);
+	record_responses(buffer.begin() + begin, buffer.end());
+	return num_received;
+}
+
+template <typename Connection>
+bool RecordingConnection<Connection>::receive_halted() const
+{
+	return m_stream->receive_halted();
+}
+
+template <typename Connection>
+bool RecordingConnection<Connection>::receive_empty() const
+{
+	return m_stream->receive_empty();
+}
+
+template <typename Connection>
+void RecordingConnection<Connection>::run_until_halt()
+{
+	try {
+		m_stream->run_until_halt();
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(m_record_mutex);
+		discard();
+		throw;
+	}
+	std::lock_guard<std::mutex> lock(m_record_mutex);
+	m_num_run_finished++;
+	write_finished();
+}
+
+template <typename Connection>
+std::mutex& RecordingConnection<Connection>::get_mutex()
+{
+	return m_mutex;
+}
+
+} // namespace hxcomm
@@ -0,0 +1,287 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/hwdb_entry.h"
+#include "hxcomm/common/mock_execution.h"
+#include "hxcomm/common/program_log.h"
+#include "hxcomm/common/stream.h"
+#include "hxcomm/common/target.h"
+#include "hxcomm/common/utmessage.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace hxcomm {
+
+template <typename Connection>
+struct MultiConnection;
+
+/**
+ * Connection serving the responses of programs recorded by a RecordingConnection.
+ * Each program, i.e. all messages up to and including a halt message, is looked up in the
+ * program log on adding its halt message and its recorded responses are served.
+ * Programs recorded multiple times are served their recordings in recorded order, starting over
+ * after the last one.
+ * The execution waits for the recorded execution duration scaled by the time scale, the
+ * other durations of the recorded time information are reported scaled without waiting.
+ * @tparam ConnectionParameter UT message parameter for connection
+ */
+template <typename ConnectionParameter>
+class ReplayConnection
+{
+public:
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+
+	// Needs to be specified for each connection type to be able to construct a MultiConnection of
+	// that type.
+	using init_parameters_type = std::tuple<std::string, double>;
+
+	static constexpr char name[] = "ReplayConnection";
+
+	/**
+	 * Construct replay connection from parameter tuple.
+	 * @param params Path of the program log and time scale
+	 */
+	ReplayConnection(init_parameters_type const& params);
+
+	/**
+	 * Construct replay connection.
+	 * @param path Path of the program log written by a RecordingConnection
+	 * @param time_scale Factor to scale the recorded durations with, zero to not wait at all
+	 * @throws std::runtime_error On failure to read the program log or invalid content
+	 */
+	explicit ReplayConnection(std::string const& path, double time_scale = 1.) SYMBOL_VISIBLE;
+
+	ReplayConnection(ReplayConnection const&) = delete;
+	ReplayConnection& operator=(ReplayConnection const&) = delete;
+	ReplayConnection(ReplayConnection&& other) SYMBOL_VISIBLE;
+	ReplayConnection& operator=(ReplayConnection&& other) SYMBOL_VISIBLE;
+	~ReplayConnection() = default;
+
+	constexpr static auto supported_targets = {Target::hardware, Target::simulation};
+	typedef std::vector<receive_message_type> receive_queue_type;
+
+	/**
+	 * Get time information.
+	 * @return Time information
+	 */
+	ConnectionTimeInfo get_time_info() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get unique identifier from hwdb.
+	 * @param hwdb_path Optional path to hwdb
+	 * @return Unique identifier
+	 */
+	std::string get_unique_identifier(std::optional<std::string> hwdb_path = std::nullopt) const
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get hwdb entry.
+	 * @return Hwdb entry
+	 */
+	HwdbEntry get_hwdb_entry() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get bitfile information.
+	 * Returns "replay" for ReplayConnection
+	 * @return Bitfile info
+	 */
+	std::string get_bitfile_info() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get server-side remote repository state information.
+	 * Only non-empty for QuiggeldyConnection.
+	 * @return Repository state
+	 */
+	std::string get_remote_repo_state() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get path of the program log.
+	 * @return Path
+	 */
+	std::string const& get_path() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of programs in the program log.
+	 * @return Number of programs
+	 */
+	size_t get_num_programs() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set factor to scale the recorded durations with.
+	 * Applies to programs added afterwards.
+	 * @param value Non-negative factor, zero to not wait at all
+	 * @throws std::invalid_argument On negative factor
+	 */
+	void set_time_scale(double value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get factor to scale the recorded durations with.
+	 * @return Factor
+	 */
+	double get_time_scale() const SYMBOL_VISIBLE;
+
+private:
+	friend MultiConnection<ReplayConnection<ConnectionParameter>>;
+
+	friend Stream<ReplayConnection>;
+	/**
+	 * Add a single UT message to the send queue.
+	 * @param message Message to add
+	 * @throws std::runtime_error On halt message ending a program not found in the program log
+	 */
+	void add(send_message_type const& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Add multiple UT messages to the send queue.
+	 * @tparam InputIterator Iterator type to sequence of messages to add
+	 * @param begin Iterator to beginning of sequence
+	 * @param end Iterator to end of sequence
+	 * @throws std::runtime_error On halt message ending a program not found in the program log
+	 */
+	template <typename InputIterator>
+	void add(InputIterator const& begin, InputIterator const& end);
+
+	/**
+	 * Send messages in send queue.
+	 */
+	void commit() SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages.
+	 * @return Received messages
+	 */
+	receive_queue_type receive_all() SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer) SYMBOL_VISIBLE;
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive() SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * Responses are served on adding messages, therefore no waiting is performed.
+	 * @param message Message to receive to
+	 * @param timeout Unused
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * Responses are served on adding messages, therefore no waiting is performed.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Unused
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the halt response was served and all messages up to it were received from
+	 * the receive queue, i.e. the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the connection has no UT messages available to receive.
+	 * @return Boolean value
+	 */
+	bool receive_empty() const SYMBOL_VISIBLE;
+
+	/**
+	 * Wait for the scaled recorded execution duration of the next program.
+	 * @throws std::runtime_error On no program ended by a halt message
+	 */
+	void run_until_halt() SYMBOL_VISIBLE;
+
+	/**
+	 * Get internal mutex to use for mutual exclusion.
+	 * @return Mutable reference to mutex
+	 */
+	std::mutex& get_mutex() SYMBOL_VISIBLE;
+
+	typedef detail::ProgramLogFormat<ConnectionParameter> format_type;
+
+	/**
+	 * Recorded execution of a program.
+	 */
+	struct Record
+	{
+		receive_queue_type responses;
+		ConnectionTimeInfo time_info;
+	};
+
+	/**
+	 * Recorded executions of a program and index of the one to serve next.
+	 */
+	struct Entry
+	{
+		std::vector<Record> records;
+		size_t next = 0;
+	};
+
+	/**
+	 * Hash of the program messages stored in program log format.
+	 */
+	struct ProgramHash
+	{
+		size_t operator()(std::vector<uint8_t> const& program) const;
+	};
+
+	/**
+	 * Append message to the program in progress and serve the program if it ends.
+	 * @param message Message to append
+	 */
+	void process(send_message_type const& message);
+
+	std::string m_path;
+	double m_time_scale;
+	std::unordered_map<std::vector<uint8_t>, Entry, ProgramHash> m_programs;
+	size_t m_num_programs;
+
+	/**
+	 * Messages of the program in progress in program log format.
+	 */
+	std::vector<uint8_t> m_program;
+	detail::MockReceiveQueue<receive_message_type> m_receive_queue;
+
+	/**
+	 * Scaled recorded time information of served programs not yet consumed by
+	 * `run_until_halt()`.
+	 */
+	std::deque<ConnectionTimeInfo> m_halt;
+
+	std::mutex m_mutex;
+
+	ConnectionTimeInfo m_time_info;
+};
+
+} // namespace hxcomm
+
+#include "hxcomm/common/replayconnection.tcc"
@@ -0,0 +1,13 @@
+namespace hxcomm {
+
+template <typename ConnectionParameter>
+template <typename InputIterator>
+void ReplayConnection<ConnectionParameter>::add(
+    InputIterator const& begin, InputIterator const& end)
+{
+	for (auto it = begin; it != end; ++it) {
+		process(*it);
+	}
+}
+
+} // namespace hxcomm
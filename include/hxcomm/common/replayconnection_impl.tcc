@@ -0,0 +1,290 @@
+#include "hate/timer.h"
+#include "hxcomm/common/hwdb_entry.h"
+#include "hxcomm/common/replayconnection.h"
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace hxcomm {
+
+template <typename ConnectionParameter>
+size_t ReplayConnection<ConnectionParameter>::ProgramHash::operator()(
+    std::vector<uint8_t> const& program) const
+{
+	return std::hash<std::string_view>()(
+	    std::string_view(reinterpret_cast<char const*>(program.data()), program.size()));
+}
+
+template <typename ConnectionParameter>
+ReplayConnection<ConnectionParameter>::ReplayConnection(init_parameters_type const& params) :
+    ReplayConnection(std::get<0>(params), std::get<1>(params))
+{}
+
+template <typename ConnectionParameter>
+ReplayConnection<ConnectionParameter>::ReplayConnection(
+    std::string const& path, double const time_scale) :
+    m_path(path),
+    m_time_scale(1.),
+    m_programs(),
+    m_num_programs(0),
+    m_program(),
+    m_receive_queue(),
+    m_halt(),
+    m_mutex(),
+    m_time_info()
+{
+	set_time_scale(time_scale);
+
+	std::ifstream file(m_path, std::ios::binary);
+	if (!file) {
+		throw std::runtime_error("ReplayConnection failed to open " + m_path + ".");
+	}
+	std::vector<uint8_t> const content(
+	    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	auto const* position = content.data();
+	auto const* const end = content.data() + content.size();
+	format_type::decode_header(position, end);
+	while (position != end) {
+		size_t num_messages;
+		size_t num_responses;
+		Record record;
+		format_type::decode_record_header(
+		    position, end, num_messages, num_responses, record.time_info);
+		auto const* const program_begin = position;
+		for (size_t i = 0; i < num_messages; ++i) {
+			format_type::template skip<send_message_type>(position, end);
+		}
+		std::vector<uint8_t> program(program_begin, position);
+		record.responses.reserve(num_responses);
+		for (size_t i = 0; i < num_responses; ++i) {
+			record.responses.push_back(
+			    format_type::template decode<receive_message_type>(position, end));
+		}
+		m_programs[std::move(program)].records.push_back(std::move(record));
+		m_num_programs++;
+	}
+}
+
+template <typename ConnectionParameter>
+ReplayConnection<ConnectionParameter>::ReplayConnection(ReplayConnection&& other) :
+    m_path(std::move(other.m_path)),
+    m_time_scale(other.m_time_scale),
+    m_programs(std::move(other.m_programs)),
+    m_num_programs(std::exchange(other.m_num_programs, 0)),
+    m_program(std::move(other.m_program)),
+    m_receive_queue(std::move(other.m_receive_queue)),
+    m_halt(std::move(other.m_halt)),
+    m_mutex(),
+    m_time_info(other.m_time_info)
+{}
+
+template <typename ConnectionParameter>
+ReplayConnection<ConnectionParameter>& ReplayConnection<ConnectionParameter>::operator=(
+    ReplayConnection&& other)
+{
+	if (&other == this) {
+		return *this;
+	}
+	m_path = std::move(other.m_path);
+	m_time_scale = other.m_time_scale;
+	m_programs = std::move(other.m_programs);
+	m_num_programs = std::exchange(other.m_num_programs, 0);
+	m_program = std::move(other.m_program);
+	m_receive_queue = std::move(other.m_receive_queue);
+	m_halt = std::move(other.m_halt);
+	m_time_info = other.m_time_info;
+	return *this;
+}
+
+template <typename ConnectionParameter>
+std::mutex& ReplayConnection<ConnectionParameter>::get_mutex()
+{
+	return m_mutex;
+}
+
+template <typename ConnectionParameter>
+ConnectionTimeInfo ReplayConnection<ConnectionParameter>::get_time_info() const
+{
+	return m_time_info;
+}
+
+template <typename ConnectionParameter>
+std::string ReplayConnection<ConnectionParameter>::get_unique_identifier(
+    std::optional<std::string> /* hwdb_path */) const
+{
+	return "replay";
+}
+
+template <typename ConnectionParameter>
+HwdbEntry ReplayConnection<ConnectionParameter>::get_hwdb_entry() const
+{
+	return ZeroMockEntry();
+}
+
+template <typename ConnectionParameter>
+std::string ReplayConnection<ConnectionParameter>::get_bitfile_info() const
+{
+	return "replay";
+}
+
+template <typename ConnectionParameter>
+std::string ReplayConnection<ConnectionParameter>::get_remote_repo_state() const
+{
+	return "";
+}
+
+template <typename ConnectionParameter>
+std::string const& ReplayConnection<ConnectionParameter>::get_path() const
+{
+	return m_path;
+}
+
+template <typename ConnectionParameter>
+size_t ReplayConnection<ConnectionParameter>::get_num_programs() const
+{
+	return m_num_programs;
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::set_time_scale(double const value)
+{
+	if (!(value >= 0.)) {
+		throw std::invalid_argument("ReplayConnection requires non-negative time scale.");
+	}
+	m_time_scale = value;
+}
+
+template <typename ConnectionParameter>
+double ReplayConnection<ConnectionParameter>::get_time_scale() const
+{
+	return m_time_scale;
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::process(send_message_type const& message)
+{
+	format_type::encode(m_program, message);
+	auto const* const halt = std::get_if<send_halt_message_type>(&message);
+	if (!halt || (halt->decode() != send_halt_message_type::instruction_type::halt)) {
+		return;
+	}
+
+	auto const it = m_programs.find(m_program);
+	if (it == m_programs.end()) {
+		m_program.clear();
+		throw std::runtime_error(
+		    "ReplayConnection found no recording of program in " + m_path + ".");
+	}
+	m_program.clear();
+
+	auto& entry = it->second;
+	auto const& record = entry.records.at(entry.next);
+	entry.next = (entry.next + 1) % entry.records.size();
+
+	m_receive_queue.messages.insert(
+	    m_receive_queue.messages.end(), record.responses.begin(), record.responses.end());
+
+	auto const scale = [this](std::chrono::nanoseconds const duration) {
+		return std::chrono::nanoseconds(
+		    std::llround(static_cast<double>(duration.count()) * m_time_scale));
+	};
+	ConnectionTimeInfo time_info;
+	time_info.encode_duration = scale(record.time_info.encode_duration);
+	time_info.decode_duration = scale(record.time_info.decode_duration);
+	time_info.commit_duration = scale(record.time_info.commit_duration);
+	time_info.execution_duration = scale(record.time_info.execution_duration);
+	m_halt.push_back(time_info);
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::add(send_message_type const& message)
+{
+	process(message);
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::commit()
+{
+	// nothing to do here
+}
+
+template <typename ConnectionParameter>
+typename ReplayConnection<ConnectionParameter>::receive_queue_type
+ReplayConnection<ConnectionParameter>::receive_all()
+{
+	receive_queue_type all;
+	receive_into(all);
+	return all;
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::receive_into(receive_queue_type& buffer)
+{
+	m_receive_queue.receive_into(buffer);
+}
+
+template <typename ConnectionParameter>
+typename ReplayConnection<ConnectionParameter>::receive_message_type
+ReplayConnection<ConnectionParameter>::receive()
+{
+	receive_message_type message;
+	if (!try_receive(message)) {
+		throw std::runtime_error("Trying to receive from empty receive queue.");
+	}
+	return message;
+}
+
+template <typename ConnectionParameter>
+bool ReplayConnection<ConnectionParameter>::try_receive(receive_message_type& message)
+{
+	return m_receive_queue.try_receive(message);
+}
+
+template <typename ConnectionParameter>
+bool ReplayConnection<ConnectionParameter>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const /* timeout */)
+{
+	return try_receive(message);
+}
+
+template <typename ConnectionParameter>
+size_t ReplayConnection<ConnectionParameter>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const /* timeout */)
+{
+	return m_receive_queue.receive_some(buffer);
+}
+
+template <typename ConnectionParameter>
+bool ReplayConnection<ConnectionParameter>::receive_halted() const
+{
+	return !m_halt.empty() && m_receive_queue.empty();
+}
+
+template <typename ConnectionParameter>
+bool ReplayConnection<ConnectionParameter>::receive_empty() const
+{
+	return m_receive_queue.empty();
+}
+
+template <typename ConnectionParameter>
+void ReplayConnection<ConnectionParameter>::run_until_halt()
+{
+	hate::Timer timer;
+
+	if (m_halt.empty()) {
+		throw std::runtime_error("Reached end of program without halt instruction!");
+	}
+
+	auto time_info = m_halt.front();
+	m_halt.pop_front();
+
+	detail::wait_mocked_duration(timer, time_info.execution_duration);
+	time_info.execution_duration = std::chrono::nanoseconds(timer.get_ns());
+	m_time_info += time_info;
+}
+
+} // namespace hxcomm
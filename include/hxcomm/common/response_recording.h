@@ -0,0 +1,185 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/recording_file.h"
+#include "hxcomm/common/utmessage.h"
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace hxcomm {
+
+namespace detail {
+
+/**
+ * Layout of response recording files written by ResponseSink and read by ResponseRecording.
+ *
+ * The file starts with a RecordingFileHeader of the receive message variant.
+ * It is followed by blocks of messages in order of arrival, each consisting of the number of
+ * messages, the number of messages per type, a column of the type index of each message and a
+ * column of the payloads for each type with at least one message.
+ * Payloads are stored as words of the message's payload type in host byte order.
+ * @tparam ConnectionParameter Connection parameter of recorded messages
+ */
+template <typename ConnectionParameter>
+struct ResponseRecordingFormat
+{
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+
+	typedef uint8_t type_index_type;
+	typedef uint64_t count_type;
+	typedef RecordingFileHeader<receive_message_type> header_type;
+
+	static constexpr size_t num_types = std::variant_size_v<receive_message_type>;
+
+	static_assert(
+	    num_types <= (size_t(1) << (sizeof(type_index_type) * CHAR_BIT)),
+	    "Message types not representable by type index.");
+
+	static constexpr typename header_type::magic_type magic = {
+	    'H', 'X', 'C', 'O', 'M', 'M', 'R', 'R'};
+	static constexpr typename header_type::word_type version = 1;
+
+	/**
+	 * Size in bytes of the stored payload of a message type.
+	 */
+	template <typename Message>
+	static constexpr size_t payload_size = sizeof(recorded_payload_words_type<Message>);
+
+	/**
+	 * Index of a message type in the receive message variant.
+	 */
+	template <typename Message>
+	static constexpr size_t type_index = []<size_t... Is>(std::index_sequence<Is...>) {
+		return (
+		    (std::is_same_v<Message, std::variant_alternative_t<Is, receive_message_type>> ? Is
+		                                                                                   : 0) +
+		    ...);
+	}(std::make_index_sequence<num_types>{});
+
+	/**
+	 * Size in bytes of the stored payload of each message type by type index.
+	 */
+	static constexpr std::array<size_t, num_types> payload_sizes =
+	    recorded_payload_sizes<receive_message_type>;
+};
+
+} // namespace detail
+
+/**
+ * Read-only memory-mapped view of responses recorded to a file by a ResponseSink.
+ * Messages of a single type can be iterated without touching the payloads of other types, since
+ * payloads are stored in columns per type.
+ * @tparam ConnectionParameter Connection parameter of recorded messages
+ */
+template <typename ConnectionParameter>
+class ResponseRecording
+{
+public:
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+	typedef std::vector<receive_message_type> receive_queue_type;
+
+	/**
+	 * Map recording file.
+	 * All blocks are validated against the file size and their per-type counts, so that reading
+	 * never accesses memory outside the mapping.
+	 * @param path Path to file written by a ResponseSink
+	 * @throws std::runtime_error On failure to map the file or invalid file content
+	 */
+	explicit ResponseRecording(std::string const& path);
+
+	ResponseRecording(ResponseRecording const&) = delete;
+	ResponseRecording& operator=(ResponseRecording const&) = delete;
+	ResponseRecording(ResponseRecording&& other) noexcept;
+	ResponseRecording& operator=(ResponseRecording&& other) noexcept;
+
+	/**
+	 * Unmap recording file.
+	 */
+	~ResponseRecording();
+
+	/**
+	 * Get path of the recording file.
+	 * @return Path
+	 */
+	std::string const& get_path() const;
+
+	/**
+	 * Get total number of recorded messages.
+	 * @return Number of messages
+	 */
+	size_t size() const;
+
+	/**
+	 * Get number of blocks of messages.
+	 * @return Number of blocks
+	 */
+	size_t num_blocks() const;
+
+	/**
+	 * Decode all messages of a block in order of arrival.
+	 * @param index Index of block
+	 * @param buffer Buffer to append decoded messages to
+	 * @throws std::out_of_range On block index out of range
+	 */
+	void read_block(size_t index, receive_queue_type& buffer) const;
+
+	/**
+	 * Decode all recorded messages in order of arrival.
+	 * Only advisable for recordings fitting into memory.
+	 * @return Messages
+	 */
+	receive_queue_type read_all() const;
+
+	/**
+	 * Get number of recorded messages of a type.
+	 * @tparam Message Message type
+	 * @return Number of messages
+	 */
+	template <typename Message>
+	size_t count() const;
+
+	/**
+	 * Invoke function on all recorded messages of a type in order of arrival.
+	 * @tparam Message Message type
+	 * @param function Function invoked as `function(message)`
+	 */
+	template <typename Message, typename Function>
+	void for_each(Function&& function) const;
+
+private:
+	typedef detail::ResponseRecordingFormat<ConnectionParameter> format_type;
+
+	/**
+	 * Location of the columns of a block within the mapped file.
+	 */
+	struct Block
+	{
+		size_t num_messages;
+		uint8_t const* type_indices;
+		std::array<size_t, format_type::num_types> counts;
+		std::array<uint8_t const*, format_type::num_types> payloads;
+	};
+
+	template <typename Message>
+	static Message decode(uint8_t const* payload);
+
+	template <typename Message>
+	static void decode_into(uint8_t const* payload, receive_queue_type& buffer);
+
+	std::string m_path;
+	void* m_data;
+	size_t m_size;
+	std::vector<Block> m_blocks;
+	size_t m_num_messages;
+};
+
+} // namespace hxcomm
+
+#include "hxcomm/common/response_recording.tcc"
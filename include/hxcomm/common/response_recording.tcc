@@ -0,0 +1,49 @@
+#include <cstring>
+
+namespace hxcomm {
+
+template <typename ConnectionParameter>
+template <typename Message>
+Message ResponseRecording<ConnectionParameter>::decode(uint8_t const* const payload)
+{
+	detail::recorded_payload_words_type<Message> words;
+	std::memcpy(words.data(), payload, sizeof(words));
+	return Message(typename Message::payload_type(words));
+}
+
+template <typename ConnectionParameter>
+template <typename Message>
+void ResponseRecording<ConnectionParameter>::decode_into(
+    uint8_t const* const payload, receive_queue_type& buffer)
+{
+	buffer.emplace_back(decode<Message>(payload));
+}
+
+template <typename ConnectionParameter>
+template <typename Message>
+size_t ResponseRecording<ConnectionParameter>::count() const
+{
+	constexpr size_t type_index = format_type::template type_index<Message>;
+	size_t count = 0;
+	for (auto const& block : m_blocks) {
+		count += block.counts[type_index];
+	}
+	return count;
+}
+
+template <typename ConnectionParameter>
+template <typename Message, typename Function>
+void ResponseRecording<ConnectionParameter>::for_each(Function&& function) const
+{
+	constexpr size_t type_index = format_type::template type_index<Message>;
+	constexpr size_t payload_size = format_type::template payload_size<Message>;
+	for (auto const& block : m_blocks) {
+		auto const* payload = block.payloads[type_index];
+		for (size_t i = 0; i < block.counts[type_index]; ++i) {
+			function(decode<Message>(payload));
+			payload += payload_size;
+		}
+	}
+}
+
+} // namespace hxcomm
@@ -0,0 +1,199 @@
+#include "hxcomm/common/response_recording.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hxcomm {
+
+template <typename ConnectionParameter>
+ResponseRecording<ConnectionParameter>::ResponseRecording(std::string const& path) :
+    m_path(path), m_data(nullptr), m_size(0), m_blocks(), m_num_messages(0)
+{
+	int const fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error(
+		    "ResponseRecording failed to open " + path + ": " + std::strerror(errno));
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0) {
+		auto const error = errno;
+		close(fd);
+		throw std::runtime_error(
+		    "ResponseRecording failed to stat " + path + ": " + std::strerror(error));
+	}
+	m_size = status.st_size;
+	if (m_size) {
+		m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	auto const error = errno;
+	close(fd);
+	if (m_data == MAP_FAILED) {
+		m_data = nullptr;
+		throw std::runtime_error(
+		    "ResponseRecording failed to map " + path + ": " + std::strerror(error));
+	}
+	// sequential access is expected when reading whole columns
+	if (m_data) {
+		madvise(m_data, m_size, MADV_SEQUENTIAL);
+	}
+
+	auto const* const begin = static_cast<uint8_t const*>(m_data);
+	auto const* const end = begin + m_size;
+	auto const* position = begin;
+	auto const read = [&](void* value, size_t const size) {
+		if (static_cast<size_t>(end - position) < size) {
+			throw std::runtime_error("ResponseRecording got truncated file: " + m_path);
+		}
+		std::memcpy(value, position, size);
+		position += size;
+	};
+	auto const skip = [&](size_t const size) {
+		if (static_cast<size_t>(end - position) < size) {
+			throw std::runtime_error("ResponseRecording got truncated file: " + m_path);
+		}
+		auto const* const skipped = position;
+		position += size;
+		return skipped;
+	};
+
+	try {
+		format_type::header_type::decode(
+		    position, end, format_type::magic, format_type::version,
+		    "ResponseRecording file " + m_path);
+
+		while (position != end) {
+			Block block;
+			typename format_type::count_type num_messages;
+			read(&num_messages, sizeof(num_messages));
+			block.num_messages = num_messages;
+			size_t num_counted = 0;
+			for (auto& count : block.counts) {
+				typename format_type::count_type value;
+				read(&value, sizeof(value));
+				count = value;
+				num_counted += count;
+			}
+			if (num_counted != block.num_messages) {
+				throw std::runtime_error("ResponseRecording got inconsistent block: " + m_path);
+			}
+			block.type_indices =
+			    skip(block.num_messages * sizeof(typename format_type::type_index_type));
+			// the type indices are to match the counts, since they select the payload columns
+			// read from by read_block
+			std::array<size_t, format_type::num_types> num_indexed{};
+			for (size_t i = 0; i < block.num_messages; ++i) {
+				auto const type_index = block.type_indices[i];
+				if (type_index >= format_type::num_types) {
+					throw std::runtime_error(
+					    "ResponseRecording got invalid message type: " + m_path);
+				}
+				num_indexed[type_index]++;
+			}
+			if (num_indexed != block.counts) {
+				throw std::runtime_error("ResponseRecording got inconsistent block: " + m_path);
+			}
+			for (size_t i = 0; i < format_type::num_types; ++i) {
+				block.payloads[i] = skip(block.counts[i] * format_type::payload_sizes[i]);
+			}
+			m_num_messages += block.num_messages;
+			m_blocks.push_back(block);
+		}
+	} catch (...) {
+		if (m_data) {
+			munmap(m_data, m_size);
+		}
+		throw;
+	}
+}
+
+template <typename ConnectionParameter>
+ResponseRecording<ConnectionParameter>::ResponseRecording(ResponseRecording&& other) noexcept :
+    m_path(std::move(other.m_path)),
+    m_data(std::exchange(other.m_data, nullptr)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_blocks(std::move(other.m_blocks)),
+    m_num_messages(std::exchange(other.m_num_messages, 0))
+{}
+
+template <typename ConnectionParameter>
+ResponseRecording<ConnectionParameter>& ResponseRecording<ConnectionParameter>::operator=(
+    ResponseRecording&& other) noexcept
+{
+	if (this != &other) {
+		if (m_data) {
+			munmap(m_data, m_size);
+		}
+		m_path = std::move(other.m_path);
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_blocks = std::move(other.m_blocks);
+		m_num_messages = std::exchange(other.m_num_messages, 0);
+	}
+	return *this;
+}
+
+template <typename ConnectionParameter>
+ResponseRecording<ConnectionParameter>::~ResponseRecording()
+{
+	if (m_data) {
+		munmap(m_data, m_size);
+	}
+}
+
+template <typename ConnectionParameter>
+std::string const& ResponseRecording<ConnectionParameter>::get_path() const
+{
+	return m_path;
+}
+
+template <typename ConnectionParameter>
+size_t ResponseRecording<ConnectionParameter>::size() const
+{
+	return m_num_messages;
+}
+
+template <typename ConnectionParameter>
+size_t ResponseRecording<ConnectionParameter>::num_blocks() const
+{
+	return m_blocks.size();
+}
+
+template <typename ConnectionParameter>
+void ResponseRecording<ConnectionParameter>::read_block(
+    size_t const index, receive_queue_type& buffer) const
+{
+	typedef void (*decode_into_type)(uint8_t const*, receive_queue_type&);
+	constexpr auto decode_into_table = []<size_t... Is>(std::index_sequence<Is...>) {
+		return std::array<decode_into_type, format_type::num_types>{
+		    &decode_into<std::variant_alternative_t<Is, receive_message_type>>...};
+	}(std::make_index_sequence<format_type::num_types>{});
+
+	auto const& block = m_blocks.at(index);
+	auto payloads = block.payloads;
+	buffer.reserve(buffer.size() + block.num_messages);
+	// type indices and payload column sizes are validated on construction
+	for (size_t i = 0; i < block.num_messages; ++i) {
+		auto const type_index = block.type_indices[i];
+		decode_into_table[type_index](payloads[type_index], buffer);
+		payloads[type_index] += format_type::payload_sizes[type_index];
+	}
+}
+
+template <typename ConnectionParameter>
+typename ResponseRecording<ConnectionParameter>::receive_queue_type
+ResponseRecording<ConnectionParameter>::read_all() const
+{
+	receive_queue_type all;
+	all.reserve(m_num_messages);
+	for (size_t i = 0; i < m_blocks.size(); ++i) {
+		read_block(i, all);
+	}
+	return all;
+}
+
+} // namespace hxcomm
@@ -0,0 +1,186 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/response_recording.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hxcomm {
+
+/**
+ * Receive sink writing responses to an append-only file instead of keeping them in memory, e.g.
+ * for recordings exceeding the host's memory.
+ * It is used as callback of execute_messages or execute_messages_streaming and finished into a
+ * memory-mapped ResponseRecording afterwards.
+ * Responses are collected in a bounded number of blocks in memory, which are written by a
+ * dedicated write thread, so that the receiving thread does not wait for disk I/O as long as
+ * the disk keeps up on average. If all blocks are in use, the sink either waits (stall) or drops
+ * responses depending on its configuration.
+ * Exceptions of the write thread are rethrown on the next call or on finish().
+ * Only a single producer thread is supported.
+ * @tparam ConnectionParameter Connection parameter of recorded messages
+ */
+template <typename ConnectionParameter>
+class ResponseSink
+{
+public:
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+	typedef std::vector<receive_message_type> receive_queue_type;
+	typedef ResponseRecording<ConnectionParameter> recording_type;
+
+	/**
+	 * Configuration of the sink.
+	 */
+	struct Config
+	{
+		/** Number of messages per block written to the file at once. */
+		size_t block_size = 1 << 16;
+		/** Number of blocks in memory, bounding the memory footprint of the sink. */
+		size_t num_blocks = 8;
+		/** Whether to drop responses instead of waiting while all blocks are in use. */
+		bool drop_on_overflow = false;
+	};
+
+	/**
+	 * Statistics of the sink.
+	 */
+	struct Statistics
+	{
+		/** Number of messages written to the file. */
+		size_t num_messages = 0;
+		/** Number of blocks written to the file. */
+		size_t num_blocks = 0;
+		/** Number of messages dropped since all blocks were in use. */
+		size_t num_dropped_messages = 0;
+		/** Number of times the producer waited since all blocks were in use. */
+		size_t num_stalls = 0;
+		/** Accumulated duration the producer waited. */
+		std::chrono::nanoseconds stall_duration{0};
+	};
+
+	/**
+	 * Create or truncate file and start write thread.
+	 * @param path Path of the recording file
+	 * @param config Configuration
+	 * @throws std::runtime_error On failure to open the file or invalid configuration
+	 */
+	ResponseSink(std::string const& path, Config const& config);
+
+	/**
+	 * Create or truncate file with default configuration and start write thread.
+	 * @param path Path of the recording file
+	 * @throws std::runtime_error On failure to open the file
+	 */
+	explicit ResponseSink(std::string const& path);
+
+	ResponseSink(ResponseSink const&) = delete;
+	ResponseSink& operator=(ResponseSink const&) = delete;
+
+	/**
+	 * Write remaining responses and close the file, if not already finished.
+	 */
+	~ResponseSink();
+
+	/**
+	 * Append responses to the recording.
+	 * The responses are left unchanged, they are cleared by the callers of callbacks.
+	 * @param responses Responses to append
+	 * @throws std::runtime_error On sink already finished or on failure of the write thread
+	 */
+	void operator()(receive_queue_type const& responses);
+
+	/**
+	 * Write remaining responses, close the file and map it for reading.
+	 * @return Recording of all appended responses
+	 * @throws std::runtime_error On sink already finished or on failure of the write thread
+	 */
+	recording_type finish();
+
+	/**
+	 * Get statistics of the sink.
+	 * @return Statistics
+	 */
+	Statistics get_statistics() const;
+
+	/**
+	 * Get path of the recording file.
+	 * @return Path
+	 */
+	std::string const& get_path() const;
+
+private:
+	typedef detail::ResponseRecordingFormat<ConnectionParameter> format_type;
+
+	/**
+	 * Messages collected in columns.
+	 */
+	struct Block
+	{
+		std::vector<typename format_type::type_index_type> type_indices;
+		std::array<std::vector<uint8_t>, format_type::num_types> payloads;
+
+		void clear();
+	};
+
+	/**
+	 * Acquire a free block for filling.
+	 * @return Whether a block was acquired, false if it has to be dropped
+	 */
+	bool acquire();
+
+	/**
+	 * Hand the filled block to the write thread.
+	 */
+	void submit();
+
+	/**
+	 * Stop write thread and close file.
+	 */
+	void stop();
+
+	void work_write();
+
+	/**
+	 * Write all bytes to the file.
+	 */
+	void write(void const* data, size_t size);
+
+	/**
+	 * Rethrow exception of write thread, expects lock of m_mutex.
+	 */
+	void rethrow();
+
+	std::string m_path;
+	Config m_config;
+	int m_fd;
+
+	/**
+	 * Ring buffer of blocks, of which m_size blocks starting at m_front are to be written and
+	 * the one at m_back is filled if m_filling is set.
+	 */
+	std::vector<Block> m_blocks;
+	size_t m_front;
+	size_t m_size;
+	size_t m_back;
+	bool m_filling;
+	bool m_run;
+	std::exception_ptr m_exception;
+
+	Statistics m_statistics;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition_write;
+	std::condition_variable m_condition_submit;
+
+	std::thread m_worker_write;
+};
+
+} // namespace hxcomm
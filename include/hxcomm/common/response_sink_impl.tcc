@@ -0,0 +1,257 @@
+#include "hxcomm/common/response_sink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hxcomm {
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::Block::clear()
+{
+	// capacity is kept for reuse
+	type_indices.clear();
+	for (auto& payload : payloads) {
+		payload.clear();
+	}
+}
+
+template <typename ConnectionParameter>
+ResponseSink<ConnectionParameter>::ResponseSink(std::string const& path, Config const& config) :
+    m_path(path),
+    m_config(config),
+    m_fd(-1),
+    m_blocks(),
+    m_front(0),
+    m_size(0),
+    m_back(0),
+    m_filling(false),
+    m_run(true),
+    m_exception(),
+    m_statistics(),
+    m_mutex(),
+    m_condition_write(),
+    m_condition_submit(),
+    m_worker_write()
+{
+	if ((m_config.block_size == 0) || (m_config.num_blocks == 0)) {
+		throw std::runtime_error("ResponseSink requires non-zero block size and number of blocks.");
+	}
+	m_blocks.resize(m_config.num_blocks);
+	for (auto& block : m_blocks) {
+		block.type_indices.reserve(m_config.block_size);
+	}
+
+	m_fd = open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0) {
+		throw std::runtime_error(
+		    "ResponseSink failed to open " + m_path + ": " + std::strerror(errno));
+	}
+	try {
+		auto const header =
+		    format_type::header_type::encode(format_type::magic, format_type::version);
+		write(header.data(), header.size());
+	} catch (...) {
+		close(m_fd);
+		throw;
+	}
+	m_worker_write = std::thread(&ResponseSink<ConnectionParameter>::work_write, this);
+}
+
+template <typename ConnectionParameter>
+ResponseSink<ConnectionParameter>::ResponseSink(std::string const& path) :
+    ResponseSink(path, Config())
+{}
+
+template <typename ConnectionParameter>
+ResponseSink<ConnectionParameter>::~ResponseSink()
+{
+	if (m_worker_write.joinable()) {
+		if (m_filling) {
+			submit();
+		}
+		stop();
+	}
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::operator()(receive_queue_type const& responses)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		rethrow();
+		if (!m_worker_write.joinable()) {
+			throw std::runtime_error("ResponseSink used after finish().");
+		}
+	}
+	for (auto it = responses.begin(); it != responses.end(); ++it) {
+		if (!m_filling && !acquire()) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_statistics.num_dropped_messages += responses.end() - it;
+			return;
+		}
+		// the write thread only accesses the first m_size blocks, so the filled block is free
+		auto& block = m_blocks[m_back];
+		auto const type_index = it->index();
+		block.type_indices.push_back(
+		    static_cast<typename format_type::type_index_type>(type_index));
+		std::visit(
+		    [&block, type_index](auto const& message) {
+			    auto const payload = message.get_payload();
+			    auto const& words = payload.to_array();
+			    auto const* const bytes = reinterpret_cast<uint8_t const*>(words.data());
+			    block.payloads[type_index].insert(
+			        block.payloads[type_index].end(), bytes, bytes + sizeof(words));
+		    },
+		    *it);
+		if (block.type_indices.size() == m_config.block_size) {
+			submit();
+		}
+	}
+}
+
+template <typename ConnectionParameter>
+bool ResponseSink<ConnectionParameter>::acquire()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_size == m_blocks.size()) {
+		if (m_config.drop_on_overflow) {
+			return false;
+		}
+		auto const time_begin = std::chrono::steady_clock::now();
+		m_condition_submit.wait(
+		    lock, [this] { return (m_size < m_blocks.size()) || m_exception; });
+		m_statistics.num_stalls++;
+		m_statistics.stall_duration += std::chrono::steady_clock::now() - time_begin;
+		rethrow();
+	}
+	m_back = (m_front + m_size) % m_blocks.size();
+	m_filling = true;
+	return true;
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::submit()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_size++;
+		m_filling = false;
+	}
+	m_condition_write.notify_one();
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_run = false;
+	}
+	m_condition_write.notify_one();
+	m_worker_write.join();
+	close(m_fd);
+	m_fd = -1;
+}
+
+template <typename ConnectionParameter>
+typename ResponseSink<ConnectionParameter>::recording_type
+ResponseSink<ConnectionParameter>::finish()
+{
+	if (!m_worker_write.joinable()) {
+		throw std::runtime_error("ResponseSink already finished.");
+	}
+	if (m_filling) {
+		submit();
+	}
+	stop();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		rethrow();
+	}
+	return recording_type(m_path);
+}
+
+template <typename ConnectionParameter>
+typename ResponseSink<ConnectionParameter>::Statistics
+ResponseSink<ConnectionParameter>::get_statistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_statistics;
+}
+
+template <typename ConnectionParameter>
+std::string const& ResponseSink<ConnectionParameter>::get_path() const
+{
+	return m_path;
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::write(void const* const data, size_t const size)
+{
+	if (auto const error = detail::write_all(m_fd, data, size); error) {
+		throw std::runtime_error(
+		    "ResponseSink failed to write to " + m_path + ": " + std::strerror(error));
+	}
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::rethrow()
+{
+	if (m_exception) {
+		std::rethrow_exception(std::exchange(m_exception, nullptr));
+	}
+}
+
+template <typename ConnectionParameter>
+void ResponseSink<ConnectionParameter>::work_write()
+{
+	std::array<typename format_type::count_type, 1 + format_type::num_types> block_header;
+	// the file is unusable after a failed write, further blocks are discarded
+	bool failed = false;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_condition_write.wait(lock, [this] { return m_size || !m_run; });
+		if (!m_size) {
+			break;
+		}
+		auto& block = m_blocks[m_front];
+		lock.unlock();
+		try {
+			if (failed) {
+				throw std::runtime_error(
+				    "ResponseSink discarded block after failed write to " + m_path + ".");
+			}
+			block_header[0] = block.type_indices.size();
+			for (size_t i = 0; i < format_type::num_types; ++i) {
+				block_header[1 + i] = block.payloads[i].size() / format_type::payload_sizes[i];
+			}
+			write(block_header.data(), sizeof(block_header));
+			write(
+			    block.type_indices.data(),
+			    block.type_indices.size() * sizeof(typename format_type::type_index_type));
+			for (auto const& payload : block.payloads) {
+				write(payload.data(), payload.size());
+			}
+			lock.lock();
+			m_statistics.num_messages += block.type_indices.size();
+			m_statistics.num_blocks++;
+		} catch (...) {
+			lock.lock();
+			failed = true;
+			if (!m_exception) {
+				m_exception = std::current_exception();
+			}
+		}
+		block.clear();
+		m_front = (m_front + 1) % m_blocks.size();
+		m_size--;
+		m_condition_submit.notify_one();
+	}
+}
+
+} // namespace hxcomm
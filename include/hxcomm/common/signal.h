@@ -6,6 +6,9 @@ namespace hxcomm {
 
 /**
  * Class overriding the SIGINT and the SIGTERM signal handler to a exit handler during life-time.
+ * Instances are reference counted process-wide, the handlers are only altered on construction of
+ * the first and destruction of the last instance, so that connections can hold an instance for
+ * their whole life-time instead of installing handlers for every execution.
  */
 class SignalOverrideIntTerm
 {
@@ -15,15 +18,16 @@ public:
 	 */
 	SignalOverrideIntTerm() SYMBOL_VISIBLE;
 
+	SignalOverrideIntTerm(SignalOverrideIntTerm const&) SYMBOL_VISIBLE;
+	SignalOverrideIntTerm& operator=(SignalOverrideIntTerm const&) = default;
+
 	/**
 	 * Destruct signal override with cleanup of signal handlers.
 	 */
 	~SignalOverrideIntTerm() SYMBOL_VISIBLE;
 
 private:
-	typedef decltype(signal(SIGINT, SIG_IGN)) signal_handler_type;
-	signal_handler_type m_previous_handler_sigint;
-	signal_handler_type m_previous_handler_sigterm;
+	static void acquire();
 };
 
 } // namespace hxcomm
@@ -1,28 +1,35 @@
 #pragma once
 #include "flange/simulator_client.h"
 #include "hate/visibility.h"
+#include "hxcomm/common/cancellation_token.h"
+#include "hxcomm/common/chunked_send_queue.h"
 #include "hxcomm/common/connect_to_remote_parameter_defs.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_registry.h"
+#include "hxcomm/common/connection_time_accumulator.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_accumulator.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/decoder.h"
 #include "hxcomm/common/encoder.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/listener_halt.h"
+#include "hxcomm/common/receive_wait_policy.h"
 #include "hxcomm/common/signal.h"
 #include "hxcomm/common/stream.h"
 #include "hxcomm/common/target.h"
+#include "hxcomm/common/thread_placement.h"
 #include "hxcomm/common/utmessage.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <stddef.h>
 #include <stdint.h>
 #include <thread>
 #include <type_traits>
-#include <unistd.h>
 #include <vector>
 
 
@@ -41,8 +48,9 @@ struct MultiConnection;
  * Establish and hold Simulation connection to FPGA.
  * Provide convenience functions for sending and receiving UT messages.
  * @tparam ConnectionParameter UT message parameter for connection
+ * @tparam SimulatorClient Client of the simulation server, exchangeable for testing
  */
-template <typename ConnectionParameter>
+template <typename ConnectionParameter, typename SimulatorClient = flange::SimulatorClient>
 class SimConnection
 {
 public:
@@ -129,6 +137,27 @@ public:
 	 */
 	ConnectionTimeInfo get_time_info() const SYMBOL_VISIBLE;
 
+	/**
+	 * Get transport-level information of transfers to and from the simulator.
+	 * @return Wire information
+	 */
+	ConnectionWireInfo get_wire_info() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set maximal number of words sent to the simulator in a single transfer on commit.
+	 * Larger chunks reduce the number of remote procedure calls to the simulator at the cost of
+	 * a larger temporary copy per transfer.
+	 * @param value Number of words
+	 * @throws std::runtime_error On zero number of words
+	 */
+	void set_send_chunk_size(size_t value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get maximal number of words sent to the simulator in a single transfer on commit.
+	 * @return Number of words
+	 */
+	size_t get_send_chunk_size() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get unique identifier from hwdb.
 	 * @param hwdb_path Optional path to hwdb
@@ -157,8 +186,76 @@ public:
 	 */
 	std::string get_remote_repo_state() const SYMBOL_VISIBLE;
 
+	/**
+	 * Set placement of the receive thread onto CPU cores and its scheduling policy.
+	 * Safe to call concurrently to executions.
+	 * @param placement Thread placement
+	 */
+	void set_thread_placement(ThreadPlacement const& placement) SYMBOL_VISIBLE;
+
+	/**
+	 * Get placement of the receive thread onto CPU cores and its scheduling policy.
+	 * Defaults to the placement found in the environment.
+	 * @return Thread placement
+	 */
+	ThreadPlacement get_thread_placement() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set policy of the receive worker on how to wait while no data is available.
+	 * @param policy Receive wait policy
+	 */
+	void set_receive_wait_policy(ReceiveWaitPolicy const& policy) SYMBOL_VISIBLE;
+
+	/**
+	 * Get policy of the receive worker on how to wait while no data is available.
+	 * Defaults to the policy found in the environment.
+	 * @return Receive wait policy
+	 */
+	ReceiveWaitPolicy get_receive_wait_policy() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set maximal duration of executions, after which run_until_halt aborts the execution.
+	 * Responses of an aborted execution arriving later are discarded, so that the connection
+	 * stays usable without reconnect.
+	 * Not to be called during an execution.
+	 * @param timeout Execution timeout, none for waiting indefinitely
+	 */
+	void set_execution_timeout(std::optional<std::chrono::nanoseconds> timeout) SYMBOL_VISIBLE;
+
+	/**
+	 * Get maximal duration of executions.
+	 * Defaults to none.
+	 * @return Execution timeout
+	 */
+	std::optional<std::chrono::nanoseconds> get_execution_timeout() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set token to cancel executions from other threads.
+	 * A cancelled token aborts running and future executions in run_until_halt until reset.
+	 * Not to be called during an execution.
+	 * @param token Cancellation token
+	 */
+	void set_cancellation_token(CancellationToken const& token) SYMBOL_VISIBLE;
+
+	/**
+	 * Get token to cancel executions from other threads.
+	 * Defaults to a token owned by the connection.
+	 * @return Cancellation token sharing its state with the one of the connection
+	 */
+	CancellationToken get_cancellation_token() const SYMBOL_VISIBLE;
+
+	/**
+	 * Wait until the remaining responses of aborted executions are discarded, i.e. their halt
+	 * responses arrived.
+	 * Responses only arrive while the simulation runs, therefore the simulation is run until
+	 * then.
+	 * @param timeout Maximal duration to wait for
+	 * @return Whether no responses of aborted executions are outstanding anymore
+	 */
+	bool wait_discarded(std::chrono::nanoseconds timeout) SYMBOL_VISIBLE;
+
 private:
-	friend MultiConnection<SimConnection<ConnectionParameter>>;
+	friend MultiConnection<SimConnection>;
 	/**
 	 * Registry of open SimConnections.
 	 */
@@ -193,6 +290,57 @@ private:
 	 */
 	receive_queue_type receive_all() SYMBOL_VISIBLE;
 
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * The storage of the buffer is exchanged with the one of the receive queue, so that reusing
+	 * the buffer for subsequent receives keeps the allocated capacity of both.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer) SYMBOL_VISIBLE;
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive() SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message waiting for at most the given duration.
+	 * @param message Message to receive to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * If no message is available, wait for at most the given duration for at least one message or
+	 * the halt response to arrive.
+	 * The simulation only progresses during run_until_halt(), which therefore has to run
+	 * concurrently to receive responses during execution.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the halt response was received and all messages up to it were received from the
+	 * receive queue, i.e. the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get whether the connection has no UT messages available to receive.
 	 * @return Boolean value
@@ -202,16 +350,26 @@ private:
 	/**
 	 * Start simulation and wait until halt instruction is received from simulation.
 	 * @throws std::runtime_error Simulation already running
+	 * @throws ExecutionAborted On cancellation or exceeded execution timeout
 	 */
 	void run_until_halt() SYMBOL_VISIBLE;
 
+	/**
+	 * Abort the execution by discarding its responses received so far and its remaining
+	 * responses including the halt response, unless the halt response was received in the
+	 * meantime.
+	 * @param cancelled Whether the execution was cancelled instead of exceeding its deadline
+	 * @throws ExecutionAborted If the execution was aborted
+	 */
+	void abort_execution(bool cancelled);
+
 	/**
 	 * Get internal mutex to use for mutual exclusion.
 	 * @return Mutable reference to mutex
 	 */
 	std::mutex& get_mutex() SYMBOL_VISIBLE;
 
-	std::unique_ptr<flange::SimulatorClient> m_sim;
+	std::unique_ptr<SimulatorClient> m_sim;
 
 	typedef flange::SimulatorEvent::al_data_t::value_type subpacket_type;
 
@@ -222,14 +380,19 @@ private:
 	    std::is_same<subpacket_type, typename ConnectionParameter::Receive::PhywordType>::value,
 	    "flange al_data_t does not match receive PhyWord type.");
 
-	typedef std::queue<subpacket_type> send_queue_type;
+	typedef ChunkedSendQueue<flange::SimulatorEvent::al_data_t> send_queue_type;
 	send_queue_type m_send_queue;
 
 	typedef Encoder<typename ConnectionParameter::Send, send_queue_type> encoder_type;
 	encoder_type m_encoder;
 
 	mutable std::mutex m_receive_queue_mutex;
+	std::condition_variable m_receive_queue_condition;
 	receive_queue_type m_receive_queue;
+	/**
+	 * Index of first message in receive queue not yet received.
+	 */
+	size_t m_receive_queue_front;
 
 	typedef ListenerHalt<UTMessage<
 	    ConnectionParameter::Receive::HeaderAlignment,
@@ -246,22 +409,42 @@ private:
 
 	std::atomic<bool> m_run_receive;
 
-	void work_receive(flange::SimulatorClient& sim);
+	mutable std::mutex m_thread_placement_mutex;
+	ThreadPlacement m_thread_placement;
+
+	ReceiveWaiter m_receive_waiter;
+
+	/**
+	 * Deadline of the running execution observed by the receive worker, which interrupts
+	 * run_until_halt on cancellation or exceeded deadline.
+	 */
+	std::atomic<std::chrono::steady_clock::time_point> m_execution_deadline;
+	std::atomic<bool> m_execution_running;
+
+	/**
+	 * Interrupt waiting for the halt response of a running execution, if it is cancelled or
+	 * exceeded its deadline.
+	 */
+	void check_execution_abort();
+
+	void work_receive(SimulatorClient& sim);
 	std::thread m_worker_receive;
 
-	std::mutex m_runnable_mutex;
+	mutable std::mutex m_runnable_mutex;
 
 	std::mutex m_mutex;
 
-	typedef std::atomic<std::chrono::nanoseconds::rep> duration_type;
-	duration_type m_encode_duration{};
-	duration_type m_decode_duration{};
-	duration_type m_commit_duration{};
-	duration_type m_execution_duration{};
+	ConnectionTimeAccumulator m_time_accumulator;
+	ConnectionWireAccumulator m_wire_accumulator;
 
 	bool m_terminate_on_destruction;
 	log4cxx::LoggerPtr m_logger;
 
+	SignalOverrideIntTerm m_signal_override;
+
+	CancellationToken m_cancellation_token;
+	std::optional<std::chrono::nanoseconds> m_execution_timeout;
+
 	struct ResetHaltListener
 	{
 		listener_halt_type& listener;
@@ -276,12 +459,11 @@ private:
 
 	struct ScopedSimulationRun
 	{
-		flange::SimulatorClient& client;
+		SimulatorClient& client;
 		std::unique_lock<std::mutex> lock;
-		SignalOverrideIntTerm signal_override;
 
-		ScopedSimulationRun(flange::SimulatorClient& client, std::mutex& mutex) :
-		    client(client), lock(mutex), signal_override()
+		ScopedSimulationRun(SimulatorClient& client, std::mutex& mutex) :
+		    client(client), lock(mutex)
 		{
 			if (client.get_runnable()) {
 				throw std::runtime_error("Trying to start already running simulation.");
@@ -301,10 +483,20 @@ private:
 	};
 
 	static_assert(
-	    std::is_same_v<flange::SimulatorClient::port_t, port_t>, "Flange port type changed!");
-	static_assert(std::is_same_v<flange::SimulatorClient::ip_t, ip_t>, "Flange ip type changed!");
+	    std::is_same_v<typename SimulatorClient::port_t, port_t>, "Flange port type changed!");
+	static_assert(
+	    std::is_same_v<typename SimulatorClient::ip_t, ip_t>, "Flange ip type changed!");
 };
 
+namespace detail {
+
+// Indicate that the simulation only progresses during run_until_halt.
+template <typename ConnectionParameter, typename SimulatorClient>
+struct executes_on_commit<SimConnection<ConnectionParameter, SimulatorClient>> : std::false_type
+{};
+
+} // namespace detail
+
 } // namespace hxcomm
 
 #include "hxcomm/common/simconnection.tcc"
@@ -1,14 +1,13 @@
-#include "hate/timer.h"
-
 namespace hxcomm {
 
-template <typename ConnectionParameter>
+template <typename ConnectionParameter, typename SimulatorClient>
 template <typename InputIterator>
-void SimConnection<ConnectionParameter>::add(InputIterator const& begin, InputIterator const& end)
+void SimConnection<ConnectionParameter, SimulatorClient>::add(
+    InputIterator const& begin, InputIterator const& end)
 {
-	hate::Timer timer;
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	m_encoder(begin, end);
-	m_encode_duration.fetch_add(timer.get_ns(), std::memory_order_relaxed);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
 } // namespace hxcomm
@@ -1,94 +1,126 @@
-#include "hate/timer.h"
 #include "hxcomm/common/logger.h"
 #include "hxcomm/common/sim_parameters.h"
 #include <stdexcept>
 
 namespace hxcomm {
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>::SimConnection(init_parameters_type const& params) :
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>::SimConnection(
+    init_parameters_type const& params) :
     SimConnection(std::get<0>(params), std::get<1>(params))
 {
 }
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>::SimConnection(
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>::SimConnection(
     ip_t ip, port_t port, bool enable_terminate_on_destruction) :
     m_registry(std::make_unique<Registry>(std::tuple{ip, port})),
-    m_sim(std::make_unique<flange::SimulatorClient>(ip, port)),
+    m_sim(std::make_unique<SimulatorClient>(ip, port)),
     m_send_queue(),
     m_encoder(m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt),
     m_run_receive(true),
+    m_thread_placement_mutex(),
+    m_thread_placement(ThreadPlacement::from_env()),
+    m_receive_waiter(),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false),
     m_worker_receive([ip, port, this]() {
-	    thread_local flange::SimulatorClient local_sim(ip, port);
+	    thread_local SimulatorClient local_sim(ip, port);
 	    work_receive(local_sim);
     }),
     m_runnable_mutex(),
     m_terminate_on_destruction(enable_terminate_on_destruction),
-    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection"))
+    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection")),
+    m_signal_override(),
+    m_cancellation_token(),
+    m_execution_timeout()
 {
 	HXCOMM_LOG_TRACE(m_logger, "SimConnection(): Sim connection started.");
+	m_thread_placement.apply(m_worker_receive.native_handle(), "SimConnection receive");
 
 	// reset synplify wrapper to align behavior to ARQ FPGA reset of ARQConnection.
 	assert(m_sim);
 	m_sim->issue_reset();
 }
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>::SimConnection(bool enable_terminate_on_destruction) :
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>::SimConnection(
+    bool enable_terminate_on_destruction) :
     m_registry(std::make_unique<Registry>(get_sim_parameters())),
-    m_sim(std::make_unique<flange::SimulatorClient>(
+    m_sim(std::make_unique<SimulatorClient>(
         std::get<0>(m_registry->m_parameters), std::get<1>(m_registry->m_parameters))),
     m_send_queue(),
     m_encoder(m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt),
     m_run_receive(true),
+    m_thread_placement_mutex(),
+    m_thread_placement(ThreadPlacement::from_env()),
+    m_receive_waiter(),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false),
     m_worker_receive([&]() {
-	    thread_local flange::SimulatorClient local_sim(
+	    thread_local SimulatorClient local_sim(
 	        std::get<0>(m_registry->m_parameters), std::get<1>(m_registry->m_parameters));
 	    work_receive(local_sim);
     }),
     m_runnable_mutex(),
     m_terminate_on_destruction(enable_terminate_on_destruction),
-    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection"))
+    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection")),
+    m_signal_override(),
+    m_cancellation_token(),
+    m_execution_timeout()
 {
 	HXCOMM_LOG_TRACE(m_logger, "SimConnection(): Sim connection started.");
+	m_thread_placement.apply(m_worker_receive.native_handle(), "SimConnection receive");
 
 	// reset synplify wrapper to align behavior to ARQ FPGA reset of ARQConnection.
 	assert(m_sim);
 	m_sim->issue_reset();
 }
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>::SimConnection(SimConnection&& other) :
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>::SimConnection(SimConnection&& other) :
     m_registry(),
     m_sim(),
     m_send_queue(),
     m_encoder(other.m_encoder, m_send_queue),
     m_receive_queue_mutex(),
+    m_receive_queue_condition(),
     m_receive_queue(),
+    m_receive_queue_front(0),
     m_listener_halt(),
     m_decoder(m_receive_queue, m_listener_halt), // temporary
     m_run_receive(true),
+    m_thread_placement_mutex(),
+    m_thread_placement(other.get_thread_placement()),
+    m_receive_waiter(other.m_receive_waiter.get_policy()),
+    m_execution_deadline(std::chrono::steady_clock::time_point::max()),
+    m_execution_running(false),
     m_worker_receive(),
     m_runnable_mutex(),
     m_terminate_on_destruction(false),
-    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection"))
+    m_logger(log4cxx::Logger::getLogger("hxcomm.SimConnection")),
+    m_signal_override(),
+    m_cancellation_token(other.m_cancellation_token),
+    m_execution_timeout(other.m_execution_timeout)
 {
 	// shutdown other threads
 	other.m_run_receive = false;
+	other.m_receive_waiter.notify();
 	other.m_worker_receive.join();
-	m_encode_duration = other.m_encode_duration.load(std::memory_order_relaxed);
-	m_decode_duration = other.m_decode_duration.load(std::memory_order_relaxed);
-	m_commit_duration = other.m_commit_duration.load(std::memory_order_relaxed);
-	m_execution_duration = other.m_execution_duration.load(std::memory_order_relaxed);
+	m_time_accumulator = other.m_time_accumulator;
+	m_wire_accumulator = other.m_wire_accumulator;
 	// move registry
 	m_registry = std::move(other.m_registry);
 	// move simulator client
@@ -97,39 +129,45 @@ SimConnection<ConnectionParameter>::SimConnection(SimConnection&& other) :
 	m_send_queue = std::move(other.m_send_queue);
 	m_receive_queue.~receive_queue_type();
 	new (&m_receive_queue) decltype(m_receive_queue)(std::move(other.m_receive_queue));
+	m_receive_queue_front = other.m_receive_queue_front;
 	// create decoder
 	m_decoder.~decoder_type();
 	new (&m_decoder) decltype(m_decoder)(other.m_decoder, m_receive_queue, m_listener_halt);
 	//
 	m_worker_receive = std::thread([&]() {
-		thread_local flange::SimulatorClient local_sim(
+		thread_local SimulatorClient local_sim(
 		    std::get<0>(m_registry->m_parameters), std::get<1>(m_registry->m_parameters));
 		work_receive(local_sim);
 	});
+	m_thread_placement.apply(m_worker_receive.native_handle(), "SimConnection receive");
 
 	HXCOMM_LOG_TRACE(m_logger, "SimConnection(): Sim connection started.");
 }
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>& SimConnection<ConnectionParameter>::operator=(
-    SimConnection&& other)
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>&
+SimConnection<ConnectionParameter, SimulatorClient>::operator=(SimConnection&& other)
 {
 	if (&other != this) {
 		// shutdown own threads
 		if (m_run_receive) {
 			m_run_receive = false;
+			m_receive_waiter.notify();
 			m_worker_receive.join();
 		}
 		m_run_receive = static_cast<bool>(other.m_run_receive);
 		// shutdown other threads
 		if (other.m_run_receive) {
 			other.m_run_receive = false;
+			other.m_receive_waiter.notify();
 			other.m_worker_receive.join();
 		}
-		m_encode_duration = other.m_encode_duration.load(std::memory_order_relaxed);
-		m_decode_duration = other.m_decode_duration.load(std::memory_order_relaxed);
-		m_commit_duration = other.m_commit_duration.load(std::memory_order_relaxed);
-		m_execution_duration = other.m_execution_duration.load(std::memory_order_relaxed);
+		m_receive_waiter.set_policy(other.m_receive_waiter.get_policy());
+		m_time_accumulator = other.m_time_accumulator;
+		m_wire_accumulator = other.m_wire_accumulator;
+		m_thread_placement = other.get_thread_placement();
+		m_cancellation_token = other.m_cancellation_token;
+		m_execution_timeout = other.m_execution_timeout;
 		// move registry
 		m_registry = std::move(other.m_registry);
 		// move simulation client
@@ -138,6 +176,7 @@ SimConnection<ConnectionParameter>& SimConnection<ConnectionParameter>::operator
 		m_send_queue = std::move(other.m_send_queue);
 		m_receive_queue.~receive_queue_type();
 		new (&m_receive_queue) decltype(m_receive_queue)(std::move(other.m_receive_queue));
+		m_receive_queue_front = other.m_receive_queue_front;
 		// create decoder
 		m_decoder.~decoder_type();
 		new (&m_decoder) decltype(m_decoder)(other.m_decoder, m_receive_queue, m_listener_halt);
@@ -146,19 +185,21 @@ SimConnection<ConnectionParameter>& SimConnection<ConnectionParameter>::operator
 		new (&m_encoder) encoder_type(other.m_encoder, m_send_queue);
 		// create and start thread
 		m_worker_receive = std::thread([&]() {
-			thread_local flange::SimulatorClient local_sim(
+			thread_local SimulatorClient local_sim(
 			    std::get<0>(m_registry->m_parameters), std::get<1>(m_registry->m_parameters));
 			work_receive(local_sim);
 		});
+		m_thread_placement.apply(m_worker_receive.native_handle(), "SimConnection receive");
 	}
 	return *this;
 }
 
-template <typename ConnectionParameter>
-SimConnection<ConnectionParameter>::~SimConnection()
+template <typename ConnectionParameter, typename SimulatorClient>
+SimConnection<ConnectionParameter, SimulatorClient>::~SimConnection()
 {
 	HXCOMM_LOG_TRACE(m_logger, "~SimConnection(): Stopping Sim connection.");
 	m_run_receive = false;
+	m_receive_waiter.notify();
 	if (m_worker_receive.joinable()) {
 		m_worker_receive.join();
 	}
@@ -170,133 +211,393 @@ SimConnection<ConnectionParameter>::~SimConnection()
 	}
 }
 
-template <typename ConnectionParameter>
-std::mutex& SimConnection<ConnectionParameter>::get_mutex()
+template <typename ConnectionParameter, typename SimulatorClient>
+std::mutex& SimConnection<ConnectionParameter, SimulatorClient>::get_mutex()
 {
 	return m_mutex;
 }
 
-template <typename ConnectionParameter>
-void SimConnection<ConnectionParameter>::add(send_message_type const& message)
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::add(send_message_type const& message)
 {
-	hate::Timer timer;
+	// only the encoding is accounted for, not the time spent by the caller between messages
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	std::visit([this](auto const& m) { m_encoder(m); }, message);
-	m_encode_duration.fetch_add(timer.get_ns(), std::memory_order_relaxed);
+	m_time_accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
-template <typename ConnectionParameter>
-void SimConnection<ConnectionParameter>::commit()
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::commit()
 {
-	hate::Timer timer;
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	m_encoder.flush();
 	HXCOMM_LOG_DEBUG(m_logger, "commit(): Commiting " << m_send_queue.size() << " word(s).");
 	if (!m_sim) {
 		throw std::runtime_error("Unexpected access to moved-from object.");
 	}
-	while (!m_send_queue.empty()) {
-		m_sim->send({m_send_queue.front()});
-		m_send_queue.pop();
-	}
-	m_commit_duration.fetch_add(timer.get_ns(), std::memory_order_relaxed);
+	// commit is allowed concurrently to run_until_halt for streaming of messages
+	std::lock_guard<std::mutex> const lock(m_runnable_mutex);
+	m_send_queue.flush([this](auto const& chunk) {
+		auto const time_send_begin = ConnectionWireAccumulator::clock_type::now();
+		m_sim->send(chunk);
+		m_wire_accumulator.add_sent(
+		    chunk.size(), m_send_queue.get_chunk_size(),
+		    ConnectionWireAccumulator::clock_type::now() - time_send_begin);
+	});
+	// responses are to be expected once the simulation runs
+	m_receive_waiter.notify();
+	m_time_accumulator.commit.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
 }
 
-template <typename ConnectionParameter>
-typename SimConnection<ConnectionParameter>::receive_queue_type
-SimConnection<ConnectionParameter>::receive_all()
+template <typename ConnectionParameter, typename SimulatorClient>
+typename SimConnection<ConnectionParameter, SimulatorClient>::receive_queue_type
+SimConnection<ConnectionParameter, SimulatorClient>::receive_all()
 {
 	receive_queue_type all;
-	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	std::swap(all, m_receive_queue);
+	receive_into(all);
 	return all;
 }
 
-template <typename ConnectionParameter>
-void SimConnection<ConnectionParameter>::work_receive(flange::SimulatorClient& local_sim)
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::receive_into(receive_queue_type& buffer)
+{
+	buffer.clear();
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == 0) {
+		std::swap(buffer, m_receive_queue);
+	} else {
+		buffer.assign(
+		    std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+		    std::make_move_iterator(m_receive_queue.end()));
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+typename SimConnection<ConnectionParameter, SimulatorClient>::receive_message_type
+SimConnection<ConnectionParameter, SimulatorClient>::receive()
+{
+	receive_message_type message;
+	if (!try_receive(message)) {
+		throw std::runtime_error("Trying to receive from empty receive queue.");
+	}
+	return message;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+bool SimConnection<ConnectionParameter, SimulatorClient>::try_receive(receive_message_type& message)
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		return false;
+	}
+	message = std::move(m_receive_queue[m_receive_queue_front]);
+	m_receive_queue_front++;
+	if (m_receive_queue_front == m_receive_queue.size()) {
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
+	}
+	return true;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+bool SimConnection<ConnectionParameter, SimulatorClient>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const timeout)
+{
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (!m_receive_queue_condition.wait_for(lock, timeout, [this] {
+			    return m_receive_queue_front != m_receive_queue.size();
+		    })) {
+			return false;
+		}
+	}
+	return try_receive(message);
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+size_t SimConnection<ConnectionParameter, SimulatorClient>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const timeout)
+{
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	m_receive_queue_condition.wait_for(lock, timeout, [this] {
+		return (m_receive_queue_front != m_receive_queue.size()) || m_listener_halt.get();
+	});
+	size_t const count = m_receive_queue.size() - m_receive_queue_front;
+	buffer.insert(
+	    buffer.end(), std::make_move_iterator(m_receive_queue.begin() + m_receive_queue_front),
+	    std::make_move_iterator(m_receive_queue.end()));
+	m_receive_queue.clear();
+	m_receive_queue_front = 0;
+	return count;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+bool SimConnection<ConnectionParameter, SimulatorClient>::receive_halted() const
+{
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_listener_halt.get() && (m_receive_queue_front == m_receive_queue.size());
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::work_receive(SimulatorClient& local_sim)
 {
 	while (m_run_receive) {
 		while (local_sim.receive_data_available() && m_run_receive) {
-			hate::Timer timer;
+			auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 			auto const words = local_sim.receive();
-			m_decoder(words.begin(), words.end());
-			m_decode_duration.fetch_add(timer.get_ns(), std::memory_order_release);
+			m_wire_accumulator.add_received(words.size());
+			{
+				std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+				bool const discarding = m_listener_halt.is_discarding();
+				size_t const num_discarded = m_listener_halt.get_num_discarded();
+				size_t const size = m_receive_queue.size();
+				m_decoder(words.begin(), words.end());
+				if (discarding) {
+					m_listener_halt.erase_discarded(
+					    m_receive_queue, size,
+					    m_listener_halt.get_num_discarded() - num_discarded);
+				}
+			}
+			m_receive_queue_condition.notify_all();
+			m_time_accumulator.decode.add(
+			    ConnectionTimeAccumulator::clock_type::now() - time_begin);
+			m_receive_waiter.reset();
+			check_execution_abort();
 		}
+		check_execution_abort();
+		m_receive_waiter.wait();
 	}
 }
 
-template <typename ConnectionParameter>
-bool SimConnection<ConnectionParameter>::receive_empty() const
+template <typename ConnectionParameter, typename SimulatorClient>
+bool SimConnection<ConnectionParameter, SimulatorClient>::receive_empty() const
 {
 	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
-	return m_receive_queue.empty();
+	return m_receive_queue_front == m_receive_queue.size();
 }
 
-template <typename ConnectionParameter>
-void SimConnection<ConnectionParameter>::run_until_halt()
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::run_until_halt()
 {
 	ResetHaltListener reset(m_listener_halt);
-	hate::Timer timer;
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
 	if (!m_sim) {
 		throw std::runtime_error("Unexpected access to moved-from object.");
 	}
-	ScopedSimulationRun run(*m_sim, m_runnable_mutex);
+	m_execution_deadline.store(
+	    m_execution_timeout ? (std::chrono::steady_clock::now() + *m_execution_timeout)
+	                        : std::chrono::steady_clock::time_point::max(),
+	    std::memory_order_relaxed);
+	auto const interrupts = m_listener_halt.get_interrupts();
+	bool halted;
+	{
+		// keep receive worker from blocking until halt is received
+		ReceiveWaiter::Active receive_active(m_receive_waiter);
+		ScopedSimulationRun run(*m_sim, m_runnable_mutex);
+		m_execution_running.store(true, std::memory_order_release);
+
+		// woken up by the receive worker upon decoding the halt response or upon interruption
+		// by cancellation or exceeded deadline
+		halted = m_listener_halt.wait(interrupts);
+		m_execution_running.store(false, std::memory_order_release);
+	}
+	if (!halted) {
+		abort_execution(m_cancellation_token.is_cancelled());
+	}
+	m_time_accumulator.execution.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+}
 
-	constexpr size_t wait_period = 10000;
-	while (!m_listener_halt.get()) {
-		int ret = usleep(wait_period);
-		if ((ret != 0) && errno != EINTR) {
-			throw std::runtime_error("Error during usleep call.");
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::check_execution_abort()
+{
+	if (!m_execution_running.load(std::memory_order_acquire)) {
+		return;
+	}
+	if (!m_cancellation_token.is_cancelled() &&
+	    (std::chrono::steady_clock::now() <
+	     m_execution_deadline.load(std::memory_order_relaxed))) {
+		return;
+	}
+	// only interrupt once per execution
+	if (m_execution_running.exchange(false, std::memory_order_acq_rel)) {
+		m_listener_halt.interrupt();
+	}
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::abort_execution(bool const cancelled)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (m_listener_halt.consume_or_discard()) {
+			// the halt response arrived in the meantime, the execution is complete
+			return;
 		}
+		// responses of the aborted execution are not to be received, the ones still to arrive
+		// in later simulation runs are discarded by the receive worker up to and including the
+		// halt response
+		m_receive_queue.clear();
+		m_receive_queue_front = 0;
 	}
-	m_execution_duration.fetch_add(timer.get_ns(), std::memory_order_relaxed);
+	HXCOMM_LOG_WARN(
+	    m_logger, "run_until_halt(): Execution aborted, discarding its remaining responses.");
+	throw ExecutionAborted(
+	    cancelled ? "Execution was cancelled." : "Execution exceeded its timeout.");
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+ConnectionTimeInfo SimConnection<ConnectionParameter, SimulatorClient>::get_time_info() const
+{
+	return m_time_accumulator.get();
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+ConnectionWireInfo SimConnection<ConnectionParameter, SimulatorClient>::get_wire_info() const
+{
+	return m_wire_accumulator.get();
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_receive_wait_policy(
+    ReceiveWaitPolicy const& policy)
+{
+	m_receive_waiter.set_policy(policy);
+	HXCOMM_LOG_DEBUG(m_logger, "set_receive_wait_policy(): Using " << policy << ".");
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+ReceiveWaitPolicy
+SimConnection<ConnectionParameter, SimulatorClient>::get_receive_wait_policy() const
+{
+	return m_receive_waiter.get_policy();
 }
 
-template <typename ConnectionParameter>
-ConnectionTimeInfo SimConnection<ConnectionParameter>::get_time_info() const
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_send_chunk_size(size_t const value)
 {
-	return ConnectionTimeInfo{
-	    std::chrono::nanoseconds(m_encode_duration.load(std::memory_order_relaxed)),
-	    std::chrono::nanoseconds(m_decode_duration.load(std::memory_order_acquire)),
-	    std::chrono::nanoseconds(m_commit_duration.load(std::memory_order_relaxed)),
-	    std::chrono::nanoseconds(m_execution_duration.load(std::memory_order_relaxed))};
+	std::lock_guard<std::mutex> const lock(m_runnable_mutex);
+	m_send_queue.set_chunk_size(value);
 }
 
-template <typename ConnectionParameter>
-void SimConnection<ConnectionParameter>::set_enable_terminate_on_destruction(bool const value)
+template <typename ConnectionParameter, typename SimulatorClient>
+size_t SimConnection<ConnectionParameter, SimulatorClient>::get_send_chunk_size() const
+{
+	std::lock_guard<std::mutex> const lock(m_runnable_mutex);
+	return m_send_queue.get_chunk_size();
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_enable_terminate_on_destruction(
+    bool const value)
 {
 	m_terminate_on_destruction = value;
 }
 
-template <typename ConnectionParameter>
-bool SimConnection<ConnectionParameter>::get_enable_terminate_on_destruction() const
+template <typename ConnectionParameter, typename SimulatorClient>
+bool
+SimConnection<ConnectionParameter, SimulatorClient>::get_enable_terminate_on_destruction() const
 {
 	return m_terminate_on_destruction;
 }
 
-template <typename ConnectionParameter>
-std::string SimConnection<ConnectionParameter>::get_unique_identifier(
+template <typename ConnectionParameter, typename SimulatorClient>
+std::string SimConnection<ConnectionParameter, SimulatorClient>::get_unique_identifier(
     std::optional<std::string>) const
 {
 	// TODO: make unique
 	return "simulation";
 }
 
-template <typename ConnectionParameter>
-HwdbEntry SimConnection<ConnectionParameter>::get_hwdb_entry() const
+template <typename ConnectionParameter, typename SimulatorClient>
+HwdbEntry SimConnection<ConnectionParameter, SimulatorClient>::get_hwdb_entry() const
 {
 	// TODO: make unique
 	return SimulationEntry{};
 }
 
-template <typename ConnectionParameter>
-std::string SimConnection<ConnectionParameter>::get_bitfile_info() const
+template <typename ConnectionParameter, typename SimulatorClient>
+std::string SimConnection<ConnectionParameter, SimulatorClient>::get_bitfile_info() const
 {
 	return "simulation";
 }
 
-template <typename ConnectionParameter>
-std::string SimConnection<ConnectionParameter>::get_remote_repo_state() const
+template <typename ConnectionParameter, typename SimulatorClient>
+std::string SimConnection<ConnectionParameter, SimulatorClient>::get_remote_repo_state() const
 {
 	return "";
 }
 
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_thread_placement(
+    ThreadPlacement const& placement)
+{
+	std::lock_guard<std::mutex> lock(m_thread_placement_mutex);
+	m_thread_placement = placement;
+	if (m_worker_receive.joinable()) {
+		m_thread_placement.apply(m_worker_receive.native_handle(), "SimConnection receive");
+	}
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+ThreadPlacement SimConnection<ConnectionParameter, SimulatorClient>::get_thread_placement() const
+{
+	std::lock_guard<std::mutex> lock(m_thread_placement_mutex);
+	return m_thread_placement;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_execution_timeout(
+    std::optional<std::chrono::nanoseconds> const timeout)
+{
+	m_execution_timeout = timeout;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+std::optional<std::chrono::nanoseconds>
+SimConnection<ConnectionParameter, SimulatorClient>::get_execution_timeout() const
+{
+	return m_execution_timeout;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+void SimConnection<ConnectionParameter, SimulatorClient>::set_cancellation_token(
+    CancellationToken const& token)
+{
+	m_cancellation_token = token;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+CancellationToken
+SimConnection<ConnectionParameter, SimulatorClient>::get_cancellation_token() const
+{
+	return m_cancellation_token;
+}
+
+template <typename ConnectionParameter, typename SimulatorClient>
+bool SimConnection<ConnectionParameter, SimulatorClient>::wait_discarded(
+    std::chrono::nanoseconds const timeout)
+{
+	if (!m_sim) {
+		throw std::runtime_error("Unexpected access to moved-from object.");
+	}
+	{
+		std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+		if (!m_listener_halt.is_discarding()) {
+			return true;
+		}
+	}
+
+	// aborted executions only progress while the simulation runs, keep receive worker from
+	// blocking until their halt responses are received
+	ReceiveWaiter::Active receive_active(m_receive_waiter);
+	ScopedSimulationRun run(*m_sim, m_runnable_mutex);
+	std::unique_lock<std::mutex> lock(m_receive_queue_mutex);
+	return m_receive_queue_condition.wait_for(
+	    lock, timeout, [this] { return !m_listener_halt.is_discarding(); });
+}
+
 } // namespace hxcomm
@@ -0,0 +1,103 @@
+#pragma once
+#include "hxcomm/common/connection_time_accumulator.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace hxcomm {
+
+/**
+ * Bounded lock-free ring buffer of elements passed from a single producer thread to a single
+ * consumer thread.
+ * Pushing blocks while the ring is full, so that the producer is throttled to the rate of the
+ * consumer. The consumer accesses the oldest element in place via front() and releases it via
+ * pop(), waiting for elements to arrive is left to the consumer.
+ * @tparam T Element type
+ */
+template <typename T>
+class SPSCRing
+{
+public:
+	typedef T value_type;
+
+	/**
+	 * Construct ring.
+	 * @param capacity Maximal number of elements in the ring
+	 * @throws std::runtime_error On zero capacity
+	 */
+	explicit SPSCRing(size_t capacity);
+
+	SPSCRing(SPSCRing const&) = delete;
+	SPSCRing& operator=(SPSCRing const&) = delete;
+
+	/**
+	 * Move construct ring.
+	 * Neither ring is allowed to be accessed by other threads during the move.
+	 * @param other Ring to move from
+	 */
+	SPSCRing(SPSCRing&& other);
+
+	/**
+	 * Add element to the ring if it is not full.
+	 * To be called from the producer thread only.
+	 * @param value Element to add
+	 * @return Whether the element was added
+	 */
+	bool try_push(value_type const& value);
+
+	/**
+	 * Add element to the ring.
+	 * Blocks while the ring is full.
+	 * To be called from the producer thread only.
+	 * @param value Element to add
+	 */
+	void push(value_type const& value);
+
+	/**
+	 * Get oldest element in the ring.
+	 * To be called from the consumer thread only.
+	 * @return Pointer to oldest element or nullptr if the ring is empty
+	 */
+	value_type* front();
+
+	/**
+	 * Remove oldest element from the ring, waking up a blocked producer.
+	 * To be called from the consumer thread only and only if the ring is not empty.
+	 */
+	void pop();
+
+	/**
+	 * Get whether the ring contains no elements.
+	 * @return Boolean value
+	 */
+	bool empty() const;
+
+	/**
+	 * Get maximal number of elements in the ring.
+	 * @return Capacity
+	 */
+	size_t capacity() const;
+
+private:
+	std::vector<value_type> m_elements;
+
+	/**
+	 * Number of elements pushed so far, written by the producer.
+	 * The producer caches the number of popped elements to only reload it once the ring appears
+	 * to be full.
+	 */
+	alignas(ConnectionTimeAccumulator::cache_line_size) std::atomic<size_t> m_head;
+	size_t m_tail_cache;
+
+	/**
+	 * Number of elements popped so far, written by the consumer.
+	 * The consumer caches the number of pushed elements to only reload it once the ring appears
+	 * to be empty.
+	 */
+	alignas(ConnectionTimeAccumulator::cache_line_size) std::atomic<size_t> m_tail;
+	size_t m_head_cache;
+};
+
+} // namespace hxcomm
+
+#include "hxcomm/common/spsc_ring.tcc"
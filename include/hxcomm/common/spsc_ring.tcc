@@ -0,0 +1,80 @@
+#include <stdexcept>
+#include <utility>
+
+namespace hxcomm {
+
+template <typename T>
+SPSCRing<T>::SPSCRing(size_t const capacity) :
+    m_elements(capacity), m_head(0), m_tail_cache(0), m_tail(0), m_head_cache(0)
+{
+	if (capacity == 0) {
+		throw std::runtime_error("SPSCRing requires non-zero capacity.");
+	}
+}
+
+template <typename T>
+SPSCRing<T>::SPSCRing(SPSCRing&& other) :
+    m_elements(std::move(other.m_elements)),
+    m_head(other.m_head.load(std::memory_order_acquire)),
+    m_tail_cache(other.m_tail_cache),
+    m_tail(other.m_tail.load(std::memory_order_acquire)),
+    m_head_cache(other.m_head_cache)
+{}
+
+template <typename T>
+bool SPSCRing<T>::try_push(value_type const& value)
+{
+	size_t const head = m_head.load(std::memory_order_relaxed);
+	if (head - m_tail_cache == m_elements.size()) {
+		m_tail_cache = m_tail.load(std::memory_order_acquire);
+		if (head - m_tail_cache == m_elements.size()) {
+			return false;
+		}
+	}
+	m_elements[head % m_elements.size()] = value;
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+void SPSCRing<T>::push(value_type const& value)
+{
+	while (!try_push(value)) {
+		// woken up by the consumer popping an element
+		m_tail.wait(m_tail_cache, std::memory_order_acquire);
+	}
+}
+
+template <typename T>
+typename SPSCRing<T>::value_type* SPSCRing<T>::front()
+{
+	size_t const tail = m_tail.load(std::memory_order_relaxed);
+	if (tail == m_head_cache) {
+		m_head_cache = m_head.load(std::memory_order_acquire);
+		if (tail == m_head_cache) {
+			return nullptr;
+		}
+	}
+	return &m_elements[tail % m_elements.size()];
+}
+
+template <typename T>
+void SPSCRing<T>::pop()
+{
+	m_tail.fetch_add(1, std::memory_order_release);
+	m_tail.notify_one();
+}
+
+template <typename T>
+bool SPSCRing<T>::empty() const
+{
+	return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
+
+template <typename T>
+size_t SPSCRing<T>::capacity() const
+{
+	return m_elements.size();
+}
+
+} // namespace hxcomm
@@ -2,8 +2,10 @@
 #include "hate/type_list.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/execute_messages_types.h"
+#include <chrono>
 #include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace hxcomm {
 
@@ -147,6 +149,21 @@ public:
 		return m_connection.receive_all();
 	}
 
+	/**
+	 * Receive all UT messages into a buffer replacing its content.
+	 * If supported by the connection, the storage of the buffer is exchanged with the one of the
+	 * connection's receive queue, so that reusing the buffer keeps the allocated capacity of both.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(auto& buffer)
+	{
+		if constexpr (requires { m_connection.receive_into(buffer); }) {
+			m_connection.receive_into(buffer);
+		} else {
+			buffer = m_connection.receive_all();
+		}
+	}
+
 	/**
 	 * Try to receive a single UT message.
 	 * @param message Message to receive to
@@ -157,6 +174,40 @@ public:
 		return m_connection.try_receive(message);
 	}
 
+	/**
+	 * Try to receive a single UT message waiting for at most the given duration.
+	 * @param message Message to receive to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds const timeout)
+	{
+		return m_connection.try_receive(message, timeout);
+	}
+
+	/**
+	 * Receive all available UT messages by appending them to a buffer.
+	 * If no message is available, wait for at most the given duration for at least one message or
+	 * the halt response to arrive.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Maximal duration to wait for a message to become available
+	 * @return Number of received messages
+	 */
+	size_t receive_some(auto& buffer, std::chrono::nanoseconds const timeout)
+	{
+		return m_connection.receive_some(buffer, timeout);
+	}
+
+	/**
+	 * Get whether the halt response was received and all messages up to it were received, i.e.
+	 * the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const
+	{
+		return m_connection.receive_halted();
+	}
+
 	/**
 	 * Get whether the connection has no UT messages available to receive.
 	 * @return Boolean value
@@ -174,6 +225,33 @@ public:
 		m_connection.run_until_halt();
 	};
 
+	/**
+	 * Whether the connection implements transact().
+	 */
+	static constexpr bool supports_transact = requires(
+	    connection_type& connection,
+	    std::vector<send_message_type> const& messages,
+	    typename connection_type::receive_queue_type& responses) {
+		connection.transact(messages, responses, size_t(), std::chrono::nanoseconds());
+	};
+
+	/**
+	 * Send messages and wait for the given number of responses without halt handling.
+	 * Only available if supports_transact is true.
+	 * @param messages Messages to send
+	 * @param responses Buffer to receive responses into, replacing its content
+	 * @param num_responses Number of responses to wait for
+	 * @param timeout Maximal duration to wait for the responses
+	 */
+	void transact(
+	    auto const& messages,
+	    auto& responses,
+	    size_t const num_responses,
+	    std::chrono::nanoseconds const timeout)
+	{
+		m_connection.transact(messages, responses, num_responses, timeout);
+	}
+
 protected:
 	connection_type& m_connection;
 	std::unique_lock<std::mutex> m_connection_lock;
@@ -185,6 +263,10 @@ template <typename Connection, typename = void>
 struct supports_full_stream_interface : std::true_type
 {};
 
+template <typename Connection, typename = void>
+struct executes_on_commit : std::true_type
+{};
+
 } // namespace detail
 
 /**
@@ -196,4 +278,13 @@ template <typename Connection>
 using supports_full_stream_interface =
     detail::supports_full_stream_interface<std::decay_t<Connection>>;
 
+/**
+ * Helper function to distinguish between connections whose backend starts execution as soon as
+ * messages are committed and those only executing during run_until_halt.
+ * Only the former allow to overlap encoding and transmission of a program with the execution of
+ * the previous one.
+ */
+template <typename Connection>
+using executes_on_commit = detail::executes_on_commit<std::decay_t<Connection>>;
+
 } // namespace hxcomm
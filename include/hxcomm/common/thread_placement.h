@@ -0,0 +1,98 @@
+#pragma once
+#include "hate/visibility.h"
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hxcomm {
+
+/**
+ * Placement of connection threads onto CPU cores and their scheduling policy.
+ * Pinning receive threads to dedicated cores and using real-time scheduling reduces jitter in
+ * receive latency on busy nodes.
+ */
+struct ThreadPlacement
+{
+	/**
+	 * CPU cores to restrict threads to, no restriction if empty.
+	 */
+	std::vector<size_t> cpus;
+
+	/**
+	 * Priority of SCHED_FIFO real-time scheduling, default scheduling policy if not set.
+	 */
+	std::optional<int> sched_fifo_priority;
+
+	/**
+	 * Get placement from environment.
+	 * The cores are read from HXCOMM_THREAD_CPUS and HXCOMM_THREAD_NUMA_NODES as lists of the
+	 * form "0-3,8", the cores of the given NUMA nodes are added to the given cores.
+	 * The SCHED_FIFO priority is read from HXCOMM_THREAD_SCHED_FIFO_PRIORITY.
+	 * Defaults to no restriction and default scheduling policy if not set.
+	 * @throws std::runtime_error On invalid values in environment
+	 * @return Placement
+	 */
+	static ThreadPlacement from_env() SYMBOL_VISIBLE;
+
+	/**
+	 * Get placement from string representations.
+	 * @param cpus List of cores of the form "0-3,8"
+	 * @param numa_nodes List of NUMA nodes of the form "0-1", whose cores are added
+	 * @param sched_fifo_priority SCHED_FIFO priority, empty for default scheduling policy
+	 * @throws std::runtime_error On invalid values or unknown NUMA node
+	 * @return Placement
+	 */
+	static ThreadPlacement from_string(
+	    std::string const& cpus,
+	    std::string const& numa_nodes,
+	    std::string const& sched_fifo_priority) SYMBOL_VISIBLE;
+
+	/**
+	 * Get effective placement of a thread.
+	 * @param thread Native handle of thread
+	 * @throws std::runtime_error On failure to query placement
+	 * @return Placement
+	 */
+	static ThreadPlacement get(std::thread::native_handle_type thread) SYMBOL_VISIBLE;
+
+	/**
+	 * Apply placement to a thread and log the effective placement.
+	 * Failure to apply the placement, e.g. due to missing privileges for real-time scheduling,
+	 * is logged as warning but does not throw.
+	 * @param thread Native handle of thread
+	 * @param name Name of thread used in logging
+	 */
+	void apply(std::thread::native_handle_type thread, std::string const& name) const
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Apply placement to the calling thread and log the effective placement.
+	 * @param name Name of thread used in logging
+	 */
+	void apply(std::string const& name) const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether placement leaves threads unrestricted with default scheduling policy.
+	 * @return Boolean value
+	 */
+	bool is_default() const SYMBOL_VISIBLE;
+
+	bool operator==(ThreadPlacement const& other) const SYMBOL_VISIBLE;
+	bool operator!=(ThreadPlacement const& other) const SYMBOL_VISIBLE;
+
+	friend std::ostream& operator<<(std::ostream& os, ThreadPlacement const& placement)
+	    SYMBOL_VISIBLE;
+};
+
+/**
+ * Parse list of non-negative integers of the form "0-3,8".
+ * @param list List to parse
+ * @throws std::runtime_error On invalid list
+ * @return Sorted unique integers
+ */
+std::vector<size_t> parse_integer_list(std::string const& list) SYMBOL_VISIBLE;
+
+} // namespace hxcomm
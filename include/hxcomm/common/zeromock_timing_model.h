@@ -0,0 +1,122 @@
+#pragma once
+#include "hate/type_list.h"
+#include "hxcomm/common/connection.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <variant>
+
+namespace hxcomm {
+
+/**
+ * Model of the execution time of programs processed by ZeroMockConnection.
+ * Each message contributes its instruction-specific cost to the modelled time. The
+ * dictionary-specific message processing further advances the modelled time on timing
+ * instructions, e.g. to wait for a timer value or for responses to reads.
+ * @tparam ConnectionParameter Connection parameter of modelled messages
+ */
+template <typename ConnectionParameter>
+struct ZeroMockTimingModel
+{
+	HXCOMM_EXPOSE_MESSAGE_TYPES(ConnectionParameter)
+
+	static constexpr size_t num_types = std::variant_size_v<send_message_type>;
+
+	/**
+	 * Modelled duration of processing a message without instruction-specific cost.
+	 */
+	std::chrono::nanoseconds default_cost{8};
+
+	/**
+	 * Instruction-specific modelled durations of processing a message by index of the
+	 * instruction in the send dictionary, overriding the default cost if set.
+	 */
+	std::array<std::optional<std::chrono::nanoseconds>, num_types> costs{};
+
+	/**
+	 * Duration of a tick of the timer used by timing instructions.
+	 */
+	std::chrono::nanoseconds timer_tick{8};
+
+	/**
+	 * Latency from issuing a read to the arrival of its response.
+	 * Awaited by barriers on the read's channel and at the end of the program.
+	 */
+	std::chrono::nanoseconds read_latency{0};
+
+	/**
+	 * Whether to report the modelled execution duration without waiting for it to pass.
+	 * Otherwise, run_until_halt() waits until the time spent matches the modelled duration.
+	 */
+	bool virtual_time = false;
+
+	/**
+	 * Set modelled duration of processing a message of an instruction.
+	 * @tparam Instruction Instruction type of send dictionary
+	 * @param cost Modelled duration
+	 */
+	template <typename Instruction>
+	void set_cost(std::chrono::nanoseconds const cost)
+	{
+		costs[hate::index_type_list_by_type<
+		    Instruction, typename ConnectionParameter::Send::Dictionary>::value] = cost;
+	}
+
+	/**
+	 * Get modelled duration of processing a message of an instruction.
+	 * @tparam Instruction Instruction type of send dictionary
+	 * @return Modelled duration
+	 */
+	template <typename Instruction>
+	std::chrono::nanoseconds get_cost() const
+	{
+		return costs[hate::index_type_list_by_type<
+		                 Instruction, typename ConnectionParameter::Send::Dictionary>::value]
+		    .value_or(default_cost);
+	}
+
+	/**
+	 * Get modelled duration of processing a message.
+	 * @param message Message
+	 * @return Modelled duration
+	 */
+	std::chrono::nanoseconds get_cost(send_message_type const& message) const
+	{
+		return costs[message.index()].value_or(default_cost);
+	}
+};
+
+namespace detail {
+
+/**
+ * Modelled time of the program processed by ZeroMockConnection since its last execution.
+ */
+struct ZeroMockClock
+{
+	/**
+	 * Modelled time at which the next message is processed.
+	 */
+	std::chrono::nanoseconds now{0};
+
+	/**
+	 * Modelled time of the last reset of the timer used by timing instructions.
+	 */
+	std::chrono::nanoseconds timer_origin{0};
+
+	/**
+	 * Modelled time at which the responses to all issued reads have arrived.
+	 */
+	std::chrono::nanoseconds responses_done{0};
+};
+
+/**
+ * Modelled durations of the programs processed up to their halt instruction, which were not yet
+ * executed, in order of their halt instructions.
+ */
+typedef std::deque<std::chrono::nanoseconds> ZeroMockHaltQueue;
+
+} // namespace detail
+
+} // namespace hxcomm
@@ -3,9 +3,12 @@
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_time_info.h"
 #include "hxcomm/common/hwdb_entry.h"
+#include "hxcomm/common/mock_execution.h"
 #include "hxcomm/common/stream.h"
 #include "hxcomm/common/target.h"
 #include "hxcomm/common/utmessage.h"
+#include "hxcomm/common/zeromock_timing_model.h"
+#include <chrono>
 #include <cstddef>
 #include <mutex>
 #include <optional>
@@ -30,8 +33,11 @@ struct ZeroMockProcessMessage;
 
 /**
  * Connection returning zero'ed data on read requests, discarding all other messages.
+ * Optionally, a register file model serves read requests with previously written data instead.
  * We do not model experiment prebuffering, i.e. only message processing contributes
  * to the `execution_duration` measurement.
+ * The execution time is given by a timing model, which is either waited for or, in virtual time,
+ * only reported as `execution_duration`.
  * @tparam ConnectionParameter UT message parameter for connection
  */
 template <typename ConnectionParameter>
@@ -44,6 +50,8 @@ public:
 	// that type.
 	using init_parameters_type = std::tuple<long>;
 
+	typedef ZeroMockTimingModel<ConnectionParameter> timing_model_type;
+
 	static constexpr char name[] = "ZeroMockConnection";
 
 	/**
@@ -63,6 +71,12 @@ public:
 	 */
 	ZeroMockConnection(long ns_per_message = 8 /* ns/Message for 125M Messages/s */) SYMBOL_VISIBLE;
 
+	/**
+	 * Construct zero mock connection with timing model.
+	 * @param timing_model Model of the execution time of processed messages
+	 */
+	explicit ZeroMockConnection(timing_model_type const& timing_model) SYMBOL_VISIBLE;
+
 	ZeroMockConnection(ZeroMockConnection const&) = delete;
 	ZeroMockConnection& operator=(ZeroMockConnection const&) = delete;
 	ZeroMockConnection(ZeroMockConnection&& other) SYMBOL_VISIBLE;
@@ -106,6 +120,33 @@ public:
 	 */
 	std::string get_remote_repo_state() const SYMBOL_VISIBLE;
 
+	/**
+	 * Set model of the execution time of processed messages.
+	 * Applies to messages added afterwards.
+	 * @param timing_model Timing model
+	 */
+	void set_timing_model(timing_model_type const& timing_model) SYMBOL_VISIBLE;
+
+	/**
+	 * Get model of the execution time of processed messages.
+	 * @return Timing model
+	 */
+	timing_model_type const& get_timing_model() const SYMBOL_VISIBLE;
+
+	/**
+	 * Set whether to model the register file behind read and write accesses, so that reads
+	 * return the values written before instead of zero.
+	 * Disabled by default. Disabling discards the modelled register contents.
+	 * @param value Boolean value
+	 */
+	void set_enable_register_file(bool value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the register file behind read and write accesses is modelled.
+	 * @return Boolean value
+	 */
+	bool get_enable_register_file() const SYMBOL_VISIBLE;
+
 private:
 	friend MultiConnection<ZeroMockConnection<ConnectionParameter>>;
 
@@ -136,6 +177,55 @@ private:
 	 */
 	receive_queue_type receive_all() SYMBOL_VISIBLE;
 
+	/**
+	 * Receive all UT messages currently in the receive queue into a buffer replacing its content.
+	 * The storage of the buffer is exchanged with the one of the receive queue, so that reusing
+	 * the buffer for subsequent receives keeps the allocated capacity of both.
+	 * @param buffer Buffer to receive messages into
+	 */
+	void receive_into(receive_queue_type& buffer) SYMBOL_VISIBLE;
+
+	/**
+	 * Receive a single UT message.
+	 * @throws std::runtime_error On empty receive queue
+	 * @return Received message
+	 */
+	receive_message_type receive() SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * @param message Message to receive to
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Try to receive a single UT message.
+	 * Responses are generated on adding messages, therefore no waiting is performed.
+	 * @param message Message to receive to
+	 * @param timeout Unused
+	 * @return Boolean value whether receive was successful
+	 */
+	bool try_receive(receive_message_type& message, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Receive all UT messages currently in the receive queue by appending them to a buffer.
+	 * Responses are generated on adding messages, therefore no waiting is performed.
+	 * @param buffer Buffer to append received messages to
+	 * @param timeout Unused
+	 * @return Number of received messages
+	 */
+	size_t receive_some(receive_queue_type& buffer, std::chrono::nanoseconds timeout)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the halt response was generated and all messages up to it were received from
+	 * the receive queue, i.e. the end of the response stream of the current execution is reached.
+	 * @return Boolean value
+	 */
+	bool receive_halted() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get whether the connection has no UT messages available to receive.
 	 * @return Boolean value
@@ -155,22 +245,27 @@ private:
 
 	typedef std::vector<send_message_type> send_queue_type;
 	send_queue_type m_send_queue;
-	receive_queue_type m_receive_queue;
+	detail::MockReceiveQueue<receive_message_type> m_receive_queue;
 
-	bool m_halt;
-	long m_ns_per_message;
+	/**
+	 * Modelled durations of the processed programs not yet consumed by `run_until_halt()`.
+	 * Each halt instruction closes the program processed before it, so that pipelined programs
+	 * are executed with their individual durations.
+	 */
+	detail::ZeroMockHaltQueue m_halt;
 
-	detail::ZeroMockProcessMessage<ConnectionParameter> m_process_message;
+	timing_model_type m_timing_model;
+	/**
+	 * Modelled time of the messages processed since the last halt instruction.
+	 */
+	detail::ZeroMockClock m_clock;
+
+	typedef detail::ZeroMockProcessMessage<ConnectionParameter> process_message_type;
+	process_message_type m_process_message;
 	std::mutex m_mutex;
 
 	ConnectionTimeInfo m_time_info;
 	ConnectionTimeInfo m_last_time_info;
-	/**
-	 * Message count since last `run_until_halt()` invokation used to calculate the amount of
-	 * time to spend in the current invokation in order to match specified rate of processed UT
-	 * messages.
-	 */
-	size_t m_last_message_count;
 };
 
 } // namespace hxcomm
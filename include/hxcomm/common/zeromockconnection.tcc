@@ -10,11 +10,15 @@ void ZeroMockConnection<ConnectionParameter>::add(
 	hate::Timer timer;
 	// reserve enough for common use case in execute_messages
 	size_t const messages_size = std::distance(begin, end);
-	m_receive_queue.reserve(m_receive_queue.size() + messages_size + 1 /* halt */);
+	m_receive_queue.messages.reserve(
+	    m_receive_queue.messages.size() + messages_size + 1 /* halt */);
 	for (auto it = begin; it != end; ++it) {
+		m_clock.now += m_timing_model.get_cost(*it);
 		m_process_message(*it);
 	}
-	m_last_message_count += messages_size;
+	if (m_timing_model.virtual_time) {
+		return;
+	}
 	std::chrono::nanoseconds duration(timer.get_ns());
 	m_time_info.execution_duration += duration;
 }
@@ -12,14 +12,21 @@ ZeroMockConnection<ConnectionParameter>::ZeroMockConnection(init_parameters_type
 
 template <typename ConnectionParameter>
 ZeroMockConnection<ConnectionParameter>::ZeroMockConnection(long const ns_per_message) :
+    ZeroMockConnection(timing_model_type{.default_cost = std::chrono::nanoseconds(ns_per_message)})
+{
+}
+
+template <typename ConnectionParameter>
+ZeroMockConnection<ConnectionParameter>::ZeroMockConnection(
+    timing_model_type const& timing_model) :
     m_send_queue(),
     m_receive_queue(),
-    m_halt(false),
-    m_ns_per_message(ns_per_message),
-    m_process_message(m_receive_queue, m_halt),
+    m_halt(),
+    m_timing_model(timing_model),
+    m_clock(),
+    m_process_message(m_receive_queue.messages, m_halt, m_timing_model, m_clock),
     m_time_info(),
-    m_last_time_info(),
-    m_last_message_count(0)
+    m_last_time_info()
 {
 }
 
@@ -29,11 +36,12 @@ ZeroMockConnection<ConnectionParameter>::ZeroMockConnection(ZeroMockConnection&&
     m_send_queue(std::move(other.m_send_queue)),
     m_receive_queue(std::move(other.m_receive_queue)),
     m_halt(other.m_halt),
-    m_ns_per_message(other.m_ns_per_message),
-    m_process_message(m_receive_queue, m_halt),
+    m_timing_model(other.m_timing_model),
+    m_clock(other.m_clock),
+    m_process_message(
+        other.m_process_message, m_receive_queue.messages, m_halt, m_timing_model, m_clock),
     m_time_info(other.m_time_info),
-    m_last_time_info(other.m_last_time_info),
-    m_last_message_count(other.m_last_message_count)
+    m_last_time_info(other.m_last_time_info)
 {
 }
 
@@ -41,13 +49,19 @@ template <typename ConnectionParameter>
 ZeroMockConnection<ConnectionParameter>& ZeroMockConnection<ConnectionParameter>::operator=(
     ZeroMockConnection&& other)
 {
+	if (&other == this) {
+		return *this;
+	}
 	m_send_queue = std::move(other.m_send_queue);
 	m_receive_queue = std::move(other.m_receive_queue);
 	m_halt = other.m_halt;
-	m_ns_per_message = other.m_ns_per_message;
+	m_timing_model = other.m_timing_model;
+	m_clock = other.m_clock;
+	m_process_message.~process_message_type();
+	new (&m_process_message) process_message_type(
+	    other.m_process_message, m_receive_queue.messages, m_halt, m_timing_model, m_clock);
 	m_time_info = other.m_time_info;
 	m_last_time_info = other.m_last_time_info;
-	m_last_message_count = other.m_last_message_count;
 	return *this;
 }
 
@@ -90,12 +104,42 @@ std::string ZeroMockConnection<ConnectionParameter>::get_remote_repo_state() con
 	return "";
 }
 
+template <typename ConnectionParameter>
+void ZeroMockConnection<ConnectionParameter>::set_timing_model(
+    timing_model_type const& timing_model)
+{
+	m_timing_model = timing_model;
+}
+
+template <typename ConnectionParameter>
+typename ZeroMockConnection<ConnectionParameter>::timing_model_type const&
+ZeroMockConnection<ConnectionParameter>::get_timing_model() const
+{
+	return m_timing_model;
+}
+
+template <typename ConnectionParameter>
+void ZeroMockConnection<ConnectionParameter>::set_enable_register_file(bool const value)
+{
+	m_process_message.set_enable_register_file(value);
+}
+
+template <typename ConnectionParameter>
+bool ZeroMockConnection<ConnectionParameter>::get_enable_register_file() const
+{
+	return m_process_message.get_enable_register_file();
+}
+
 template <typename ConnectionParameter>
 void ZeroMockConnection<ConnectionParameter>::add(send_message_type const& message)
 {
+	m_clock.now += m_timing_model.get_cost(message);
+	if (m_timing_model.virtual_time) {
+		m_process_message(message);
+		return;
+	}
 	hate::Timer timer;
 	m_process_message(message);
-	m_last_message_count++;
 	std::chrono::nanoseconds duration(timer.get_ns());
 	m_time_info.execution_duration += duration;
 }
@@ -111,10 +155,53 @@ typename ZeroMockConnection<ConnectionParameter>::receive_queue_type
 ZeroMockConnection<ConnectionParameter>::receive_all()
 {
 	receive_queue_type all;
-	std::swap(all, m_receive_queue);
+	receive_into(all);
 	return all;
 }
 
+template <typename ConnectionParameter>
+void ZeroMockConnection<ConnectionParameter>::receive_into(receive_queue_type& buffer)
+{
+	m_receive_queue.receive_into(buffer);
+}
+
+template <typename ConnectionParameter>
+typename ZeroMockConnection<ConnectionParameter>::receive_message_type
+ZeroMockConnection<ConnectionParameter>::receive()
+{
+	receive_message_type message;
+	if (!try_receive(message)) {
+		throw std::runtime_error("Trying to receive from empty receive queue.");
+	}
+	return message;
+}
+
+template <typename ConnectionParameter>
+bool ZeroMockConnection<ConnectionParameter>::try_receive(receive_message_type& message)
+{
+	return m_receive_queue.try_receive(message);
+}
+
+template <typename ConnectionParameter>
+bool ZeroMockConnection<ConnectionParameter>::try_receive(
+    receive_message_type& message, std::chrono::nanoseconds const /* timeout */)
+{
+	return try_receive(message);
+}
+
+template <typename ConnectionParameter>
+size_t ZeroMockConnection<ConnectionParameter>::receive_some(
+    receive_queue_type& buffer, std::chrono::nanoseconds const /* timeout */)
+{
+	return m_receive_queue.receive_some(buffer);
+}
+
+template <typename ConnectionParameter>
+bool ZeroMockConnection<ConnectionParameter>::receive_halted() const
+{
+	return !m_halt.empty() && m_receive_queue.empty();
+}
+
 template <typename ConnectionParameter>
 bool ZeroMockConnection<ConnectionParameter>::receive_empty() const
 {
@@ -127,22 +214,22 @@ void ZeroMockConnection<ConnectionParameter>::run_until_halt()
 {
 	hate::Timer timer;
 
-	if (!m_halt) {
+	if (m_halt.empty()) {
 		throw std::runtime_error("Reached end of program without halt instruction!");
 	}
 
-	m_halt = false;
+	auto const expected = m_halt.front();
+	m_halt.pop_front();
 
-	long const expected = m_last_message_count * m_ns_per_message;
-	m_last_message_count = 0;
-
-	long const until_now =
-	    (m_time_info.execution_duration - m_last_time_info.execution_duration).count();
-	long const left_ns = expected - until_now;
-
-	// wait until time spent matches Messages rate
-	while (timer.get_ns() < left_ns) {
+	if (m_timing_model.virtual_time) {
+		m_time_info.execution_duration += expected;
+		m_last_time_info = m_time_info;
+		return;
 	}
+
+	// wait for the modelled time not yet spent, e.g. modelled by timing instructions
+	auto const until_now = m_time_info.execution_duration - m_last_time_info.execution_duration;
+	detail::wait_mocked_duration(timer, expected - until_now);
 	m_time_info.execution_duration += std::chrono::nanoseconds(timer.get_ns());
 	m_last_time_info = m_time_info;
 }
@@ -3,6 +3,7 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/arqconnection.h"
 #include "hxcomm/vx/connection_parameter.h"
+#include "hxcomm/vx/expected_responses.h"
 
 namespace hxcomm::vx {
 
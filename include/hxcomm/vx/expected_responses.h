@@ -0,0 +1,44 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/connection.h"
+#include "hxcomm/common/expected_responses.h"
+#include "hxcomm/vx/connection_parameter.h"
+#include "hxcomm/vx/utmessage.h"
+#include <cstddef>
+
+namespace hxcomm::detail {
+
+template <>
+struct ExpectedResponses<hxcomm::vx::ConnectionParameter>
+{
+	HXCOMM_EXPOSE_MESSAGE_TYPES(hxcomm::vx::ConnectionParameter)
+
+	/**
+	 * Get number of responses the message triggers.
+	 * Loopback messages, JTAG data messages keeping the response and Omnibus reads trigger one
+	 * response each.
+	 * @param message Message to send
+	 * @return Number of responses
+	 */
+	size_t operator()(send_message_type const& message) const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the JTAG data message keeps its response.
+	 * @param message Message to send
+	 * @return Boolean value
+	 */
+	static bool has_response(
+	    hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::to_fpga_jtag::Data> const& message)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the Omnibus address message is a read.
+	 * @param message Message to send
+	 * @return Boolean value
+	 */
+	static bool has_response(
+	    hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::omnibus_to_fpga::Address> const&
+	        message) SYMBOL_VISIBLE;
+};
+
+} // namespace hxcomm::detail
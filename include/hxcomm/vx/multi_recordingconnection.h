@@ -0,0 +1,20 @@
+#pragma once
+
+#include "hxcomm/common/multiconnection.h"
+#include "hxcomm/vx/recordingconnection.h"
+#include "hxcomm/vx/simconnection.h"
+#include "hxcomm/vx/zeromockconnection.h"
+#ifdef WITH_HXCOMM_HOSTARQ
+#include "hxcomm/vx/arqconnection.h"
+#endif
+
+namespace hxcomm::vx {
+
+/**
+ * MultiConnection of recording connections.
+ * It is instantiated for the ZeroMock, Sim and ARQ connections.
+ */
+template <typename Connection>
+using MultiRecordingConnection = hxcomm::MultiConnection<RecordingConnection<Connection>>;
+
+} // namespace hxcomm::vx
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "hxcomm/common/multiconnection.h"
+#include "hxcomm/vx/replayconnection.h"
+
+namespace hxcomm::vx {
+
+using MultiReplayConnection = hxcomm::MultiConnection<ReplayConnection>;
+
+} // namespace hxcomm::vx
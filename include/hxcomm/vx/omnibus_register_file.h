@@ -0,0 +1,99 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/vx/utmessage.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace hxcomm::vx {
+
+/**
+ * Sparse model of the omnibus address space, initially reading zero.
+ * Words are stored in pages allocated on first write to any of their addresses. The most
+ * recently accessed page is cached, so that sequential accesses do not need a lookup.
+ * Omnibus to FPGA messages are processed as by the FPGA: An address message either reads or
+ * selects the address to write the data of the following data message to with its byte enables.
+ */
+class OmnibusRegisterFile
+{
+public:
+	typedef uint32_t address_type;
+	typedef uint32_t word_type;
+
+	/**
+	 * Number of words per page.
+	 */
+	static constexpr size_t page_size = 1 << 10;
+
+	OmnibusRegisterFile() SYMBOL_VISIBLE;
+
+	OmnibusRegisterFile(OmnibusRegisterFile const&) = delete;
+	OmnibusRegisterFile& operator=(OmnibusRegisterFile const&) = delete;
+	OmnibusRegisterFile(OmnibusRegisterFile&& other) noexcept SYMBOL_VISIBLE;
+	OmnibusRegisterFile& operator=(OmnibusRegisterFile&& other) noexcept SYMBOL_VISIBLE;
+
+	/**
+	 * Read word.
+	 * @param address Address to read
+	 * @return Last written value or zero if never written
+	 */
+	word_type read(address_type address) const SYMBOL_VISIBLE;
+
+	/**
+	 * Write word.
+	 * @param address Address to write
+	 * @param value Value to write
+	 * @param mask Mask of bits to write, the other bits keep their value
+	 */
+	void write(address_type address, word_type value, word_type mask = ~word_type(0))
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Process omnibus address message.
+	 * @param message Message
+	 * @return Read value for read accesses, none for write accesses awaiting their data message
+	 */
+	std::optional<word_type> operator()(
+	    UTMessageToFPGA<instruction::omnibus_to_fpga::Address> const& message) SYMBOL_VISIBLE;
+
+	/**
+	 * Process omnibus data message, writing to the address of the preceding write access.
+	 * Data without preceding write access is ignored.
+	 * @param message Message
+	 */
+	void operator()(UTMessageToFPGA<instruction::omnibus_to_fpga::Data> const& message)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of allocated pages.
+	 * @return Number of pages
+	 */
+	size_t num_pages() const SYMBOL_VISIBLE;
+
+	/**
+	 * Reset all words to zero and release the allocated pages.
+	 */
+	void clear() SYMBOL_VISIBLE;
+
+private:
+	typedef std::array<word_type, page_size> page_type;
+
+	/**
+	 * Find page of address.
+	 * @param page_index Index of page
+	 * @return Pointer to page or nullptr if not allocated
+	 */
+	page_type* find(address_type page_index) const;
+
+	std::unordered_map<address_type, std::unique_ptr<page_type>> m_pages;
+	mutable address_type m_cached_page_index;
+	mutable page_type* m_cached_page;
+
+	std::optional<address_type> m_write_address;
+	word_type m_write_mask;
+};
+
+} // namespace hxcomm::vx
@@ -9,6 +9,7 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/connection.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include "hxcomm/common/quiggeldy_rcf.h"
 #include "hxcomm/common/sf_serialization.h"
@@ -55,6 +56,7 @@ RCF_METHOD_R0(std::vector<hxcomm::HwdbEntry>, get_hwdb_entry)
 RCF_METHOD_R0(bool, get_use_munge)
 RCF_METHOD_R0(bool, get_use_jwt)
 RCF_METHOD_V1(void, set_user_token, std::string)
+RCF_METHOD_R0(std::vector<hxcomm::ConnectionWireInfo>, get_wire_info)
 RCF_END(I_HXCommQuiggeldyVX)
 
 namespace detail {
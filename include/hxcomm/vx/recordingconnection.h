@@ -0,0 +1,9 @@
+#pragma once
+#include "hxcomm/common/recordingconnection.h"
+
+namespace hxcomm::vx {
+
+template <typename Connection>
+using RecordingConnection = hxcomm::RecordingConnection<Connection>;
+
+} // namespace hxcomm::vx
@@ -0,0 +1,16 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/replayconnection.h"
+#include "hxcomm/vx/connection_parameter.h"
+
+namespace hxcomm {
+
+namespace vx {
+
+using ReplayConnection = hxcomm::ReplayConnection<ConnectionParameter>;
+
+} // namespace vx
+
+extern template class SYMBOL_VISIBLE ReplayConnection<hxcomm::vx::ConnectionParameter>;
+
+} // namespace hxcomm
@@ -0,0 +1,20 @@
+#pragma once
+#include "hate/visibility.h"
+#include "hxcomm/common/response_recording.h"
+#include "hxcomm/common/response_sink.h"
+#include "hxcomm/vx/connection_parameter.h"
+#include "hxcomm/vx/utmessage.h"
+
+namespace hxcomm {
+
+namespace vx {
+
+using ResponseRecording = hxcomm::ResponseRecording<ConnectionParameter>;
+using ResponseSink = hxcomm::ResponseSink<ConnectionParameter>;
+
+} // namespace vx
+
+extern template class SYMBOL_VISIBLE ResponseRecording<hxcomm::vx::ConnectionParameter>;
+extern template class SYMBOL_VISIBLE ResponseSink<hxcomm::vx::ConnectionParameter>;
+
+} // namespace hxcomm
@@ -2,6 +2,7 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/simconnection.h"
 #include "hxcomm/vx/connection_parameter.h"
+#include "hxcomm/vx/expected_responses.h"
 
 namespace hxcomm::vx {
 
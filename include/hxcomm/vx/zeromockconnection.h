@@ -2,25 +2,62 @@
 #include "hate/visibility.h"
 #include "hxcomm/common/zeromockconnection.h"
 #include "hxcomm/vx/connection_parameter.h"
+#include "hxcomm/vx/expected_responses.h"
+#include "hxcomm/vx/omnibus_register_file.h"
+#include <memory>
 
 
 namespace hxcomm {
 
 namespace detail {
 
+/**
+ * Message processing of the ZeroMockConnection for the vx dictionary.
+ * Besides generating responses, timing instructions advance the modelled time: Setup resets the
+ * timer, WaitUntil waits for the timer to reach its value and Barrier on the omnibus or JTAG
+ * channel as well as the halt instruction wait for the responses to all issued reads.
+ * Omnibus reads return zero unless the optional register file model is enabled, which serves
+ * reads with the values written before.
+ */
 template <>
 struct ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>
 {
 	HXCOMM_EXPOSE_MESSAGE_TYPES(hxcomm::vx::ConnectionParameter)
 	typedef std::vector<receive_message_type> receive_queue_type;
+	typedef ZeroMockTimingModel<hxcomm::vx::ConnectionParameter> timing_model_type;
 
-	ZeroMockProcessMessage(receive_queue_type& receive_queue, bool& halt) SYMBOL_VISIBLE;
+	ZeroMockProcessMessage(
+	    receive_queue_type& receive_queue,
+	    ZeroMockHaltQueue& halt,
+	    timing_model_type const& timing_model,
+	    ZeroMockClock& clock) SYMBOL_VISIBLE;
+
+	/**
+	 * Construct from other message processing taking over its register file.
+	 */
+	ZeroMockProcessMessage(
+	    ZeroMockProcessMessage& other,
+	    receive_queue_type& receive_queue,
+	    ZeroMockHaltQueue& halt,
+	    timing_model_type const& timing_model,
+	    ZeroMockClock& clock) SYMBOL_VISIBLE;
 
 	void operator()(send_message_type const& message) SYMBOL_VISIBLE;
 
+	void set_enable_register_file(bool value) SYMBOL_VISIBLE;
+	bool get_enable_register_file() const SYMBOL_VISIBLE;
+
 private:
+	/**
+	 * Register read issued at the current modelled time.
+	 */
+	void issue_read();
+
 	receive_queue_type& m_receive_queue;
-	bool& m_halt;
+	ZeroMockHaltQueue& m_halt;
+	timing_model_type const& m_timing_model;
+	ZeroMockClock& m_clock;
+	std::unique_ptr<hxcomm::vx::OmnibusRegisterFile> m_register_file;
 };
 
 } // namespace detail
@@ -28,6 +65,7 @@ private:
 namespace vx {
 
 using ZeroMockConnection = hxcomm::ZeroMockConnection<ConnectionParameter>;
+using ZeroMockTimingModel = hxcomm::ZeroMockTimingModel<ConnectionParameter>;
 
 } // namespace vx
 
@@ -0,0 +1,35 @@
+#include "hxcomm/common/async_send_queue.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace hxcomm {
+
+size_t get_send_queue_capacity_from_env()
+{
+	char const* env_capacity = std::getenv("HXCOMM_SEND_QUEUE_CAPACITY");
+	if (env_capacity == nullptr) {
+		return 0;
+	}
+	std::string const capacity(env_capacity);
+	size_t pos = 0;
+	unsigned long value = 0;
+	// std::stoul accepts a sign and leading whitespace and wraps negative values
+	if (!capacity.empty() && std::isdigit(static_cast<unsigned char>(capacity.front()))) {
+		try {
+			value = std::stoul(capacity, &pos);
+		} catch (std::exception const&) {
+			pos = 0;
+		}
+	}
+	if (capacity.empty() || (pos != capacity.size())) {
+		throw std::runtime_error(
+		    "Invalid send queue capacity (HXCOMM_SEND_QUEUE_CAPACITY): " + capacity +
+		    ", expected number of packets.");
+	}
+	return value;
+}
+
+} // namespace hxcomm
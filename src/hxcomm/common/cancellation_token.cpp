@@ -0,0 +1,22 @@
+#include "hxcomm/common/cancellation_token.h"
+
+namespace hxcomm {
+
+CancellationToken::CancellationToken() : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+void CancellationToken::cancel()
+{
+	m_cancelled->store(true, std::memory_order_release);
+}
+
+void CancellationToken::reset()
+{
+	m_cancelled->store(false, std::memory_order_release);
+}
+
+bool CancellationToken::is_cancelled() const
+{
+	return m_cancelled->load(std::memory_order_acquire);
+}
+
+} // namespace hxcomm
@@ -0,0 +1,59 @@
+#include "hxcomm/common/connection_time_accumulator.h"
+
+#include <thread>
+
+namespace hxcomm {
+
+#if defined(HXCOMM_TIME_INFO_TSC) && !defined(HXCOMM_DISABLE_TIME_INFO)
+namespace {
+
+/**
+ * Calibrate time-stamp counter frequency against the steady clock.
+ * @return Nanoseconds per tick
+ */
+double calibrate_ns_per_tick()
+{
+	auto const steady_begin = std::chrono::steady_clock::now();
+	auto const ticks_begin = __rdtsc();
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	auto const ticks_end = __rdtsc();
+	auto const steady_end = std::chrono::steady_clock::now();
+	return static_cast<double>(
+	           std::chrono::duration_cast<std::chrono::nanoseconds>(steady_end - steady_begin)
+	               .count()) /
+	       static_cast<double>(ticks_end - ticks_begin);
+}
+
+/**
+ * Get nanoseconds per tick, calibrated on first invocation.
+ */
+double get_ns_per_tick()
+{
+	static double const ns_per_tick = calibrate_ns_per_tick();
+	return ns_per_tick;
+}
+
+} // namespace
+#endif
+
+void ConnectionTimeClock::calibrate()
+{
+#if defined(HXCOMM_TIME_INFO_TSC) && !defined(HXCOMM_DISABLE_TIME_INFO)
+	static_cast<void>(get_ns_per_tick());
+#endif
+}
+
+std::chrono::nanoseconds ConnectionTimeClock::to_duration(ticks_type const ticks)
+{
+#if defined(HXCOMM_DISABLE_TIME_INFO)
+	static_cast<void>(ticks);
+	return std::chrono::nanoseconds(0);
+#elif defined(HXCOMM_TIME_INFO_TSC)
+	return std::chrono::nanoseconds(
+	    static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(ticks) * get_ns_per_tick()));
+#else
+	return std::chrono::nanoseconds(ticks);
+#endif
+}
+
+} // namespace hxcomm
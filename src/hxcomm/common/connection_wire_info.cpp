@@ -0,0 +1,96 @@
+#include "hxcomm/common/connection_wire_info.h"
+
+#include "hate/timer.h"
+#include "hxcomm/cerealization.h"
+#include <cereal/types/chrono.hpp>
+
+namespace hxcomm {
+
+double ConnectionWireInfo::get_send_fill_ratio() const
+{
+	if (!num_words_capacity_sent) {
+		return 0.;
+	}
+	return static_cast<double>(num_words_sent) / static_cast<double>(num_words_capacity_sent);
+}
+
+std::ostream& operator<<(std::ostream& os, ConnectionWireInfo const& data)
+{
+	os << "ConnectionWireInfo(" << std::endl;
+	os << "\tnum_packets_sent:         " << data.num_packets_sent << std::endl;
+	os << "\tnum_words_sent:           " << data.num_words_sent << std::endl;
+	os << "\tnum_words_capacity_sent:  " << data.num_words_capacity_sent << std::endl;
+	os << "\tnum_partial_packets_sent: " << data.num_partial_packets_sent << std::endl;
+	os << "\tsend_fill_ratio:          " << data.get_send_fill_ratio() << std::endl;
+	os << "\tsend_blocked_duration:    " << hate::to_string(data.send_blocked_duration)
+	   << std::endl;
+	os << "\tnum_packets_received:     " << data.num_packets_received << std::endl;
+	os << "\tnum_words_received:       " << data.num_words_received << std::endl;
+	os << ")";
+	return os;
+}
+
+ConnectionWireInfo& ConnectionWireInfo::operator-=(ConnectionWireInfo const& other)
+{
+	num_packets_sent -= other.num_packets_sent;
+	num_words_sent -= other.num_words_sent;
+	num_words_capacity_sent -= other.num_words_capacity_sent;
+	num_partial_packets_sent -= other.num_partial_packets_sent;
+	num_packets_received -= other.num_packets_received;
+	num_words_received -= other.num_words_received;
+	send_blocked_duration -= other.send_blocked_duration;
+	return *this;
+}
+
+ConnectionWireInfo ConnectionWireInfo::operator-(ConnectionWireInfo const& other) const
+{
+	ConnectionWireInfo ret(*this);
+	ret -= other;
+	return ret;
+}
+
+ConnectionWireInfo& ConnectionWireInfo::operator+=(ConnectionWireInfo const& other)
+{
+	num_packets_sent += other.num_packets_sent;
+	num_words_sent += other.num_words_sent;
+	num_words_capacity_sent += other.num_words_capacity_sent;
+	num_partial_packets_sent += other.num_partial_packets_sent;
+	num_packets_received += other.num_packets_received;
+	num_words_received += other.num_words_received;
+	send_blocked_duration += other.send_blocked_duration;
+	return *this;
+}
+
+ConnectionWireInfo ConnectionWireInfo::operator+(ConnectionWireInfo const& other) const
+{
+	ConnectionWireInfo ret(*this);
+	ret += other;
+	return ret;
+}
+
+bool ConnectionWireInfo::operator==(ConnectionWireInfo const& other) const
+{
+	return num_packets_sent == other.num_packets_sent && num_words_sent == other.num_words_sent &&
+	       num_words_capacity_sent == other.num_words_capacity_sent &&
+	       num_partial_packets_sent == other.num_partial_packets_sent &&
+	       num_packets_received == other.num_packets_received &&
+	       num_words_received == other.num_words_received &&
+	       send_blocked_duration == other.send_blocked_duration;
+}
+
+bool ConnectionWireInfo::operator!=(ConnectionWireInfo const& other) const
+{
+	return !(*this == other);
+}
+
+template <typename Archive>
+void ConnectionWireInfo::serialize(Archive& ar, std::uint32_t const)
+{
+	ar(num_packets_sent, num_words_sent, num_words_capacity_sent, num_partial_packets_sent,
+	   num_packets_received, num_words_received, send_blocked_duration);
+}
+
+} // namespace hxcomm
+
+EXPLICIT_INSTANTIATE_CEREAL_SERIALIZE(hxcomm::ConnectionWireInfo)
+CEREAL_CLASS_VERSION(hxcomm::ConnectionWireInfo, 0)
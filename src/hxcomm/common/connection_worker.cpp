@@ -0,0 +1,71 @@
+#include "hxcomm/common/connection_worker.h"
+
+#include <utility>
+
+namespace hxcomm {
+
+ConnectionWorker::ConnectionWorker(std::string const& name) :
+    m_name(name), m_state(idle), m_task(), m_exception(), m_placement(), m_thread()
+{
+	m_thread = std::thread(&ConnectionWorker::work, this);
+}
+
+ConnectionWorker::~ConnectionWorker()
+{
+	join_task();
+	m_state.store(stopped, std::memory_order_release);
+	m_state.notify_one();
+	m_thread.join();
+}
+
+void ConnectionWorker::submit(task_type task)
+{
+	join_task();
+	m_exception = nullptr;
+	m_task = std::move(task);
+	m_state.store(pending, std::memory_order_release);
+	m_state.notify_one();
+}
+
+void ConnectionWorker::wait()
+{
+	join_task();
+	if (m_exception) {
+		std::rethrow_exception(std::exchange(m_exception, nullptr));
+	}
+}
+
+void ConnectionWorker::join_task()
+{
+	// waiting on the atomic spins shortly before blocking
+	m_state.wait(pending, std::memory_order_acquire);
+}
+
+void ConnectionWorker::apply_placement(ThreadPlacement const& placement)
+{
+	if (placement == m_placement) {
+		return;
+	}
+	placement.apply(m_name);
+	m_placement = placement;
+}
+
+void ConnectionWorker::work()
+{
+	while (true) {
+		m_state.wait(idle, std::memory_order_acquire);
+		if (m_state.load(std::memory_order_acquire) == stopped) {
+			return;
+		}
+		try {
+			m_task();
+		} catch (...) {
+			m_exception = std::current_exception();
+		}
+		m_task = nullptr;
+		m_state.store(idle, std::memory_order_release);
+		m_state.notify_one();
+	}
+}
+
+} // namespace hxcomm
@@ -0,0 +1,64 @@
+#include "hxcomm/common/hwdb_cache.h"
+
+#include <boost/asio/ip/address_v4.hpp>
+
+namespace hxcomm {
+
+HwdbCache& HwdbCache::get_instance()
+{
+	static HwdbCache instance;
+	return instance;
+}
+
+HwdbCache::FPGALocation HwdbCache::get_fpga_location(
+    std::string const& ip, std::optional<std::string> const& hwdb_path)
+{
+	auto const index = get_index(hwdb_path ? *hwdb_path : hwdb4cpp::database::get_default_path());
+	auto const it = index->fpgas.find(boost::asio::ip::make_address_v4(ip).to_uint());
+	if (it == index->fpgas.end()) {
+		throw std::out_of_range("Setup not found in hwdb.");
+	}
+	return it->second;
+}
+
+void HwdbCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_indices.clear();
+}
+
+std::shared_ptr<HwdbCache::Index const> HwdbCache::get_index(std::string const& path)
+{
+	auto const write_time = std::filesystem::last_write_time(path);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (auto const it = m_indices.find(path);
+		    (it != m_indices.end()) && (it->second->write_time == write_time)) {
+			return it->second;
+		}
+	}
+
+	// parse without holding the lock, concurrent reloads of the same file are idempotent
+	hwdb4cpp::database hwdb;
+	hwdb.load(path);
+	auto index = std::make_shared<Index>();
+	index->write_time = write_time;
+	for (auto const& id : hwdb.get_hxcube_ids()) {
+		auto const& entry = hwdb.get_hxcube_setup_entry(id);
+		for (auto const& [fcp, fpga] : entry.fpgas) {
+			index->fpgas.insert_or_assign(fpga.ip.to_uint(), FPGALocation{entry, fcp});
+		}
+	}
+	for (auto const& id : hwdb.get_jboa_ids()) {
+		auto const& entry = hwdb.get_jboa_setup_entry(id);
+		for (auto const& [fcp, fpga] : entry.fpgas) {
+			index->fpgas.insert_or_assign(fpga.ip.to_uint(), FPGALocation{entry, fcp});
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_indices[path] = index;
+	return index;
+}
+
+} // namespace hxcomm
@@ -1,6 +1,7 @@
 #include "hxcomm/common/quiggeldy_rcf.h"
 
 #include "cereal/types/hxcomm/common/hwdb_entry.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "hxcomm/common/hwdb_entry.h"
 #include <cereal/types/variant.hpp>
 
@@ -11,4 +12,9 @@ void serialize(Archive& ar, hxcomm::HwdbEntry& value)
 	translate_sf_cereal(ar, value);
 }
 
+void serialize(Archive& ar, hxcomm::ConnectionWireInfo& value)
+{
+	translate_sf_cereal(ar, value);
+}
+
 } // namespace SF
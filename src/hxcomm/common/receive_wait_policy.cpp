@@ -0,0 +1,176 @@
+#include "hxcomm/common/receive_wait_policy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace hxcomm {
+
+ReceiveWaitPolicy ReceiveWaitPolicy::from_env()
+{
+	ReceiveWaitPolicy policy;
+	char const* env_mode = std::getenv("HXCOMM_RECEIVE_WAIT_POLICY");
+	if (env_mode == nullptr) {
+		return policy;
+	}
+	std::string const mode(env_mode);
+	if (mode == "spin") {
+		policy.mode = Mode::spin;
+	} else if (mode == "spin_yield") {
+		policy.mode = Mode::spin_yield;
+	} else if (mode == "block") {
+		policy.mode = Mode::block;
+	} else {
+		throw std::runtime_error(
+		    "Unknown receive wait policy (HXCOMM_RECEIVE_WAIT_POLICY): " + mode +
+		    ", expected one of {spin,spin_yield,block}.");
+	}
+	return policy;
+}
+
+bool ReceiveWaitPolicy::operator==(ReceiveWaitPolicy const& other) const
+{
+	return mode == other.mode && spin_count == other.spin_count &&
+	       yield_count == other.yield_count && max_wait == other.max_wait;
+}
+
+bool ReceiveWaitPolicy::operator!=(ReceiveWaitPolicy const& other) const
+{
+	return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, ReceiveWaitPolicy::Mode const& mode)
+{
+	switch (mode) {
+		case ReceiveWaitPolicy::Mode::spin: {
+			os << "spin";
+			break;
+		}
+		case ReceiveWaitPolicy::Mode::spin_yield: {
+			os << "spin_yield";
+			break;
+		}
+		case ReceiveWaitPolicy::Mode::block: {
+			os << "block";
+			break;
+		}
+		default: {
+			throw std::logic_error("Unknown receive wait policy mode.");
+		}
+	}
+	return os;
+}
+
+std::ostream& operator<<(std::ostream& os, ReceiveWaitPolicy const& policy)
+{
+	os << "ReceiveWaitPolicy(mode: " << policy.mode << ", spin_count: " << policy.spin_count
+	   << ", yield_count: " << policy.yield_count << ", max_wait: " << policy.max_wait.count()
+	   << " us)";
+	return os;
+}
+
+
+ReceiveWaiter::ReceiveWaiter(ReceiveWaitPolicy const& policy) :
+    m_mode(policy.mode),
+    m_spin_count(policy.spin_count),
+    m_yield_count(policy.yield_count),
+    m_max_wait(policy.max_wait.count()),
+    m_idle_count(0),
+    m_current_wait(initial_wait),
+    m_active(0),
+    m_notified(false),
+    m_num_blocking_waits(0),
+    m_mutex(),
+    m_condition()
+{}
+
+void ReceiveWaiter::set_policy(ReceiveWaitPolicy const& policy)
+{
+	m_spin_count.store(policy.spin_count, std::memory_order_relaxed);
+	m_yield_count.store(policy.yield_count, std::memory_order_relaxed);
+	m_max_wait.store(policy.max_wait.count(), std::memory_order_relaxed);
+	m_mode.store(policy.mode, std::memory_order_relaxed);
+	notify();
+}
+
+ReceiveWaitPolicy ReceiveWaiter::get_policy() const
+{
+	ReceiveWaitPolicy policy;
+	policy.mode = m_mode.load(std::memory_order_relaxed);
+	policy.spin_count = m_spin_count.load(std::memory_order_relaxed);
+	policy.yield_count = m_yield_count.load(std::memory_order_relaxed);
+	policy.max_wait = std::chrono::microseconds(m_max_wait.load(std::memory_order_relaxed));
+	return policy;
+}
+
+void ReceiveWaiter::wait()
+{
+	auto const mode = m_mode.load(std::memory_order_relaxed);
+	if (mode == ReceiveWaitPolicy::Mode::spin) {
+		return;
+	}
+
+	auto const spin_count = m_spin_count.load(std::memory_order_relaxed);
+	if (m_idle_count < spin_count) {
+		m_idle_count++;
+		return;
+	}
+
+	if ((mode == ReceiveWaitPolicy::Mode::spin_yield) ||
+	    (m_idle_count < spin_count + m_yield_count.load(std::memory_order_relaxed)) ||
+	    m_active.load(std::memory_order_acquire)) {
+		m_idle_count++;
+		std::this_thread::yield();
+		return;
+	}
+
+	m_num_blocking_waits.fetch_add(1, std::memory_order_relaxed);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait_for(
+		    lock, m_current_wait, [this] { return m_notified.load(std::memory_order_acquire); });
+	}
+	if (m_notified.exchange(false, std::memory_order_acq_rel)) {
+		reset();
+	} else {
+		m_current_wait = std::min(
+		    m_current_wait * 2,
+		    std::chrono::microseconds(m_max_wait.load(std::memory_order_relaxed)));
+	}
+}
+
+void ReceiveWaiter::reset()
+{
+	m_idle_count = 0;
+	m_current_wait = initial_wait;
+}
+
+void ReceiveWaiter::notify()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_notified.store(true, std::memory_order_release);
+	}
+	m_condition.notify_one();
+}
+
+size_t ReceiveWaiter::get_num_blocking_waits() const
+{
+	return m_num_blocking_waits.load(std::memory_order_relaxed);
+}
+
+ReceiveWaiter::Active::Active(ReceiveWaiter& waiter) : m_waiter(waiter)
+{
+	m_waiter.m_active.fetch_add(1, std::memory_order_acq_rel);
+	m_waiter.notify();
+}
+
+ReceiveWaiter::Active::~Active()
+{
+	m_waiter.m_active.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace hxcomm
@@ -1,37 +1,70 @@
 #include "hxcomm/common/signal.h"
 
+#include <cstddef>
 #include <cstdlib>
+#include <mutex>
 
 namespace hxcomm {
 
-SignalOverrideIntTerm::SignalOverrideIntTerm() :
-    m_previous_handler_sigint(signal(SIGINT, SIG_IGN)),
-    m_previous_handler_sigterm(signal(SIGTERM, SIG_IGN))
+namespace {
+
+typedef decltype(signal(SIGINT, SIG_IGN)) signal_handler_type;
+
+std::mutex signal_override_mutex;
+size_t signal_override_count = 0;
+signal_handler_type previous_handler_sigint;
+signal_handler_type previous_handler_sigterm;
+
+} // namespace
+
+void SignalOverrideIntTerm::acquire()
 {
+	std::lock_guard<std::mutex> lock(signal_override_mutex);
+	if (signal_override_count++) {
+		return;
+	}
+
+	previous_handler_sigint = signal(SIGINT, SIG_IGN);
+	previous_handler_sigterm = signal(SIGTERM, SIG_IGN);
+
 	auto handler = [](int /*sig*/) { std::exit(EXIT_FAILURE); };
 
 	// If the signal is ignored, for the lifetime change it to exiting on
 	// {SIGINT,SIGTERM} to allow exiting the while loop below.
-	if (m_previous_handler_sigint == SIG_IGN) {
+	if (previous_handler_sigint == SIG_IGN) {
 		signal(SIGINT, handler);
 	} else {
-		signal(SIGINT, m_previous_handler_sigint);
+		signal(SIGINT, previous_handler_sigint);
 	}
 
-	if (m_previous_handler_sigterm == SIG_IGN) {
+	if (previous_handler_sigterm == SIG_IGN) {
 		signal(SIGTERM, handler);
 	} else {
-		signal(SIGTERM, m_previous_handler_sigterm);
+		signal(SIGTERM, previous_handler_sigterm);
 	}
 }
 
+SignalOverrideIntTerm::SignalOverrideIntTerm()
+{
+	acquire();
+}
+
+SignalOverrideIntTerm::SignalOverrideIntTerm(SignalOverrideIntTerm const&)
+{
+	acquire();
+}
+
 SignalOverrideIntTerm::~SignalOverrideIntTerm()
 {
-	if (m_previous_handler_sigint == SIG_IGN) {
-		signal(SIGINT, m_previous_handler_sigint);
+	std::lock_guard<std::mutex> lock(signal_override_mutex);
+	if (--signal_override_count) {
+		return;
+	}
+	if (previous_handler_sigint == SIG_IGN) {
+		signal(SIGINT, previous_handler_sigint);
 	}
-	if (m_previous_handler_sigterm == SIG_IGN) {
-		signal(SIGTERM, m_previous_handler_sigterm);
+	if (previous_handler_sigterm == SIG_IGN) {
+		signal(SIGTERM, previous_handler_sigterm);
 	}
 }
 
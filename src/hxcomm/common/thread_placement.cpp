@@ -0,0 +1,232 @@
+#include "hxcomm/common/thread_placement.h"
+
+#include "hxcomm/common/logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+
+namespace hxcomm {
+
+namespace {
+
+std::string get_env_or_empty(char const* name)
+{
+	char const* value = std::getenv(name);
+	return value ? std::string(value) : std::string();
+}
+
+size_t parse_integer(std::string const& value, std::string const& context)
+{
+	size_t pos = 0;
+	unsigned long result = 0;
+	try {
+		result = std::stoul(value, &pos);
+	} catch (std::exception const&) {
+		pos = 0;
+	}
+	if (value.empty() || (pos != value.size()) || (value.front() == '-')) {
+		throw std::runtime_error("Invalid integer in " + context + ": " + value);
+	}
+	return result;
+}
+
+} // namespace
+
+std::vector<size_t> parse_integer_list(std::string const& list)
+{
+	std::vector<size_t> values;
+	std::istringstream list_stream(list);
+	std::string range;
+	while (std::getline(list_stream, range, ',')) {
+		range.erase(
+		    std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c); }),
+		    range.end());
+		if (range.empty()) {
+			continue;
+		}
+		auto const dash = range.find('-');
+		if (dash == std::string::npos) {
+			values.push_back(parse_integer(range, "list " + list));
+		} else {
+			size_t const first = parse_integer(range.substr(0, dash), "list " + list);
+			size_t const last = parse_integer(range.substr(dash + 1), "list " + list);
+			if (last < first) {
+				throw std::runtime_error("Invalid range in list " + list + ": " + range);
+			}
+			for (size_t i = first; i <= last; ++i) {
+				values.push_back(i);
+			}
+		}
+	}
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+	return values;
+}
+
+ThreadPlacement ThreadPlacement::from_env()
+{
+	return from_string(
+	    get_env_or_empty("HXCOMM_THREAD_CPUS"), get_env_or_empty("HXCOMM_THREAD_NUMA_NODES"),
+	    get_env_or_empty("HXCOMM_THREAD_SCHED_FIFO_PRIORITY"));
+}
+
+ThreadPlacement ThreadPlacement::from_string(
+    std::string const& cpus, std::string const& numa_nodes, std::string const& sched_fifo_priority)
+{
+	ThreadPlacement placement;
+	placement.cpus = parse_integer_list(cpus);
+	for (auto const node : parse_integer_list(numa_nodes)) {
+		std::string const path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+		std::ifstream file(path);
+		std::string node_cpus;
+		if (!file || !std::getline(file, node_cpus)) {
+			throw std::runtime_error("Unknown NUMA node: " + std::to_string(node));
+		}
+		auto const cpus_of_node = parse_integer_list(node_cpus);
+		placement.cpus.insert(placement.cpus.end(), cpus_of_node.begin(), cpus_of_node.end());
+	}
+	std::sort(placement.cpus.begin(), placement.cpus.end());
+	placement.cpus.erase(
+	    std::unique(placement.cpus.begin(), placement.cpus.end()), placement.cpus.end());
+
+	if (!sched_fifo_priority.empty()) {
+		int const priority =
+		    static_cast<int>(parse_integer(sched_fifo_priority, "SCHED_FIFO priority"));
+		if ((priority < sched_get_priority_min(SCHED_FIFO)) ||
+		    (priority > sched_get_priority_max(SCHED_FIFO))) {
+			throw std::runtime_error("SCHED_FIFO priority out of range: " + sched_fifo_priority);
+		}
+		placement.sched_fifo_priority = priority;
+	}
+	return placement;
+}
+
+ThreadPlacement ThreadPlacement::get(std::thread::native_handle_type const thread)
+{
+	ThreadPlacement placement;
+
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	if (int const ret = pthread_getaffinity_np(thread, sizeof(cpu_set), &cpu_set); ret != 0) {
+		throw std::runtime_error(
+		    std::string("Failed to get thread CPU affinity: ") + std::strerror(ret));
+	}
+	for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+		if (CPU_ISSET(cpu, &cpu_set)) {
+			placement.cpus.push_back(cpu);
+		}
+	}
+
+	int policy;
+	sched_param param;
+	if (int const ret = pthread_getschedparam(thread, &policy, &param); ret != 0) {
+		throw std::runtime_error(
+		    std::string("Failed to get thread scheduling policy: ") + std::strerror(ret));
+	}
+	if (policy == SCHED_FIFO) {
+		placement.sched_fifo_priority = param.sched_priority;
+	}
+	return placement;
+}
+
+void ThreadPlacement::apply(
+    std::thread::native_handle_type const thread, std::string const& name) const
+{
+	auto logger = log4cxx::Logger::getLogger("hxcomm.ThreadPlacement");
+
+	if (!cpus.empty()) {
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		for (auto const cpu : cpus) {
+			if (cpu >= CPU_SETSIZE) {
+				HXCOMM_LOG_WARN(logger, name << ": Ignoring CPU " << cpu << " out of range.");
+				continue;
+			}
+			CPU_SET(cpu, &cpu_set);
+		}
+		if (int const ret = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set); ret != 0) {
+			HXCOMM_LOG_WARN(
+			    logger, name << ": Failed to set CPU affinity: " << std::strerror(ret) << ".");
+		}
+	}
+
+	if (sched_fifo_priority) {
+		sched_param param{};
+		param.sched_priority = *sched_fifo_priority;
+		if (int const ret = pthread_setschedparam(thread, SCHED_FIFO, &param); ret != 0) {
+			HXCOMM_LOG_WARN(
+			    logger, name << ": Failed to set SCHED_FIFO scheduling: " << std::strerror(ret)
+			                 << ".");
+		}
+	}
+
+	try {
+		auto const effective = get(thread);
+		if (is_default()) {
+			HXCOMM_LOG_DEBUG(logger, name << ": Effective placement: " << effective << ".");
+		} else {
+			HXCOMM_LOG_INFO(logger, name << ": Effective placement: " << effective << ".");
+		}
+	} catch (std::runtime_error const& error) {
+		HXCOMM_LOG_WARN(logger, name << ": " << error.what());
+	}
+}
+
+void ThreadPlacement::apply(std::string const& name) const
+{
+	apply(pthread_self(), name);
+}
+
+bool ThreadPlacement::is_default() const
+{
+	return cpus.empty() && !sched_fifo_priority;
+}
+
+bool ThreadPlacement::operator==(ThreadPlacement const& other) const
+{
+	return cpus == other.cpus && sched_fifo_priority == other.sched_fifo_priority;
+}
+
+bool ThreadPlacement::operator!=(ThreadPlacement const& other) const
+{
+	return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, ThreadPlacement const& placement)
+{
+	os << "ThreadPlacement(cpus: ";
+	if (placement.cpus.empty()) {
+		os << "any";
+	} else {
+		// print consecutive cores as ranges
+		for (size_t i = 0; i < placement.cpus.size();) {
+			size_t j = i;
+			while ((j + 1 < placement.cpus.size()) &&
+			       (placement.cpus.at(j + 1) == placement.cpus.at(j) + 1)) {
+				j++;
+			}
+			os << (i ? "," : "") << placement.cpus.at(i);
+			if (j != i) {
+				os << "-" << placement.cpus.at(j);
+			}
+			i = j + 1;
+		}
+	}
+	os << ", scheduling: ";
+	if (placement.sched_fifo_priority) {
+		os << "SCHED_FIFO(" << *placement.sched_fifo_priority << ")";
+	} else {
+		os << "default";
+	}
+	os << ")";
+	return os;
+}
+
+} // namespace hxcomm
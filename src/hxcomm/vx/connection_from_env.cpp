@@ -1,5 +1,6 @@
 #include "hxcomm/vx/connection_from_env.h"
 
+#include "hxcomm/common/construct_connections.h"
 #include "hxcomm/common/fpga_ip_list.h"
 #ifdef WITH_HXCOMM_HOSTARQ
 #include "hxcomm/vx/arqconnection.h"
@@ -57,11 +58,7 @@ inline std::vector<ARQConnection> get_arqconnection_list_from_env(
 		    std::to_string(fpga_ip_list.size()) + ") in environment to connect to.");
 	}
 
-	std::vector<ARQConnection> connection_list;
-	for (auto const& fpga_ip : fpga_ip_list) {
-		connection_list.emplace_back(ARQConnection(fpga_ip));
-	}
-	return connection_list;
+	return hxcomm::construct_connections<ARQConnection>(fpga_ip_list);
 }
 #endif // WITH_HOSTARQ
 
@@ -0,0 +1,37 @@
+#include "hxcomm/vx/expected_responses.h"
+
+#include "hate/variant.h"
+
+namespace hxcomm::detail {
+
+size_t ExpectedResponses<hxcomm::vx::ConnectionParameter>::operator()(
+    send_message_type const& message) const
+{
+	return std::visit(
+	    hate::overloaded{
+	        [](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::system::Loopback> const&)
+	            -> size_t { return 1; },
+	        [](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::to_fpga_jtag::Data> const&
+	               msg) -> size_t { return has_response(msg); },
+	        [](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::omnibus_to_fpga::Address> const&
+	               msg) -> size_t { return has_response(msg); },
+	        [](auto const&) -> size_t { return 0; }},
+	    message);
+}
+
+bool ExpectedResponses<hxcomm::vx::ConnectionParameter>::has_response(
+    hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::to_fpga_jtag::Data> const& message)
+{
+	return message.get_payload().test(
+	    hxcomm::vx::instruction::to_fpga_jtag::Data::size -
+	    hxcomm::vx::instruction::to_fpga_jtag::Data::padded_num_bits_keep_response);
+}
+
+bool ExpectedResponses<hxcomm::vx::ConnectionParameter>::has_response(
+    hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::omnibus_to_fpga::Address> const& message)
+{
+	return message.get_payload().test(
+	    sizeof(uint32_t) * (CHAR_BIT /* address */ + 1 /* byte enables */));
+}
+
+} // namespace hxcomm::detail
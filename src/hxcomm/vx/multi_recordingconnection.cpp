@@ -0,0 +1,13 @@
+#include "hxcomm/vx/multi_recordingconnection.h"
+
+#include "hxcomm/common/multiconnection_impl.tcc"
+
+namespace hxcomm {
+
+template class MultiConnection<RecordingConnection<hxcomm::vx::ZeroMockConnection>>;
+template class MultiConnection<RecordingConnection<hxcomm::vx::SimConnection>>;
+#ifdef WITH_HXCOMM_HOSTARQ
+template class MultiConnection<RecordingConnection<hxcomm::vx::ARQConnection>>;
+#endif
+
+} // namespace hxcomm
@@ -0,0 +1,9 @@
+#include "hxcomm/vx/multi_replayconnection.h"
+
+#include "hxcomm/common/multiconnection_impl.tcc"
+
+namespace hxcomm {
+
+template class MultiConnection<hxcomm::vx::ReplayConnection>;
+
+} // namespace hxcomm
@@ -0,0 +1,114 @@
+#include "hxcomm/vx/omnibus_register_file.h"
+
+#include "hxcomm/vx/expected_responses.h"
+#include <climits>
+#include <utility>
+
+namespace hxcomm::vx {
+
+OmnibusRegisterFile::OmnibusRegisterFile() :
+    m_pages(), m_cached_page_index(0), m_cached_page(nullptr), m_write_address(), m_write_mask(0)
+{}
+
+OmnibusRegisterFile::OmnibusRegisterFile(OmnibusRegisterFile&& other) noexcept :
+    m_pages(std::move(other.m_pages)),
+    m_cached_page_index(other.m_cached_page_index),
+    m_cached_page(std::exchange(other.m_cached_page, nullptr)),
+    m_write_address(std::exchange(other.m_write_address, std::nullopt)),
+    m_write_mask(other.m_write_mask)
+{
+	other.m_pages.clear();
+}
+
+OmnibusRegisterFile& OmnibusRegisterFile::operator=(OmnibusRegisterFile&& other) noexcept
+{
+	if (this != &other) {
+		m_pages = std::move(other.m_pages);
+		other.m_pages.clear();
+		m_cached_page_index = other.m_cached_page_index;
+		m_cached_page = std::exchange(other.m_cached_page, nullptr);
+		m_write_address = std::exchange(other.m_write_address, std::nullopt);
+		m_write_mask = other.m_write_mask;
+	}
+	return *this;
+}
+
+OmnibusRegisterFile::page_type* OmnibusRegisterFile::find(address_type const page_index) const
+{
+	if (m_cached_page && (m_cached_page_index == page_index)) {
+		return m_cached_page;
+	}
+	auto const it = m_pages.find(page_index);
+	if (it == m_pages.end()) {
+		return nullptr;
+	}
+	m_cached_page_index = page_index;
+	m_cached_page = it->second.get();
+	return m_cached_page;
+}
+
+OmnibusRegisterFile::word_type OmnibusRegisterFile::read(address_type const address) const
+{
+	auto const* const page = find(address / page_size);
+	return page ? (*page)[address % page_size] : 0;
+}
+
+void OmnibusRegisterFile::write(
+    address_type const address, word_type const value, word_type const mask)
+{
+	address_type const page_index = address / page_size;
+	auto* page = find(page_index);
+	if (!page) {
+		auto& new_page = m_pages[page_index];
+		new_page = std::make_unique<page_type>();
+		new_page->fill(0);
+		m_cached_page_index = page_index;
+		m_cached_page = new_page.get();
+		page = m_cached_page;
+	}
+	auto& word = (*page)[address % page_size];
+	word = (word & ~mask) | (value & mask);
+}
+
+std::optional<OmnibusRegisterFile::word_type> OmnibusRegisterFile::operator()(
+    UTMessageToFPGA<instruction::omnibus_to_fpga::Address> const& message)
+{
+	auto const& payload = message.get_payload();
+	auto const address = static_cast<address_type>(payload);
+	if (hxcomm::detail::ExpectedResponses<ConnectionParameter>::has_response(message)) {
+		m_write_address.reset();
+		return read(address);
+	}
+	m_write_address = address;
+	m_write_mask = 0;
+	for (size_t i = 0; i < sizeof(word_type); ++i) {
+		if (payload.test(sizeof(word_type) * CHAR_BIT + i)) {
+			m_write_mask |= word_type(0xff) << (i * CHAR_BIT);
+		}
+	}
+	return std::nullopt;
+}
+
+void OmnibusRegisterFile::operator()(
+    UTMessageToFPGA<instruction::omnibus_to_fpga::Data> const& message)
+{
+	if (!m_write_address) {
+		return;
+	}
+	write(*m_write_address, message.decode().value(), m_write_mask);
+	m_write_address.reset();
+}
+
+size_t OmnibusRegisterFile::num_pages() const
+{
+	return m_pages.size();
+}
+
+void OmnibusRegisterFile::clear()
+{
+	m_pages.clear();
+	m_cached_page = nullptr;
+	m_write_address.reset();
+}
+
+} // namespace hxcomm::vx
@@ -0,0 +1,9 @@
+#include "hxcomm/vx/replayconnection.h"
+
+#include "hxcomm/common/replayconnection_impl.tcc"
+
+namespace hxcomm {
+
+template class ReplayConnection<hxcomm::vx::ConnectionParameter>;
+
+} // namespace hxcomm
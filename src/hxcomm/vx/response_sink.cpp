@@ -0,0 +1,11 @@
+#include "hxcomm/vx/response_sink.h"
+
+#include "hxcomm/common/response_recording_impl.tcc"
+#include "hxcomm/common/response_sink_impl.tcc"
+
+namespace hxcomm {
+
+template class ResponseRecording<hxcomm::vx::ConnectionParameter>;
+template class ResponseSink<hxcomm::vx::ConnectionParameter>;
+
+} // namespace hxcomm
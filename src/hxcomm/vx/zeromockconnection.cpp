@@ -2,23 +2,67 @@
 
 #include "hate/variant.h"
 #include "hxcomm/common/zeromockconnection_impl.tcc"
+#include <algorithm>
 
 namespace hxcomm {
 
 namespace detail {
 
 ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::ZeroMockProcessMessage(
-    receive_queue_type& receive_queue, bool& halt) :
-    m_receive_queue(receive_queue), m_halt(halt)
+    receive_queue_type& receive_queue,
+    ZeroMockHaltQueue& halt,
+    timing_model_type const& timing_model,
+    ZeroMockClock& clock) :
+    m_receive_queue(receive_queue),
+    m_halt(halt),
+    m_timing_model(timing_model),
+    m_clock(clock),
+    m_register_file()
 {}
 
+ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::ZeroMockProcessMessage(
+    ZeroMockProcessMessage& other,
+    receive_queue_type& receive_queue,
+    ZeroMockHaltQueue& halt,
+    timing_model_type const& timing_model,
+    ZeroMockClock& clock) :
+    m_receive_queue(receive_queue),
+    m_halt(halt),
+    m_timing_model(timing_model),
+    m_clock(clock),
+    m_register_file(std::move(other.m_register_file))
+{}
+
+void ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::set_enable_register_file(
+    bool const value)
+{
+	if (!value) {
+		m_register_file.reset();
+	} else if (!m_register_file) {
+		m_register_file = std::make_unique<hxcomm::vx::OmnibusRegisterFile>();
+	}
+}
+
+bool ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::get_enable_register_file() const
+{
+	return static_cast<bool>(m_register_file);
+}
+
+void ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::issue_read()
+{
+	m_clock.responses_done =
+	    std::max(m_clock.responses_done, m_clock.now + m_timing_model.read_latency);
+}
+
 void ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::operator()(
     send_message_type const& message)
 {
 	auto const process_loopback =
 	    [this](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::system::Loopback> const& msg) {
 		    if (msg.decode() == hxcomm::vx::instruction::system::Loopback::halt) {
-			    m_halt = true;
+			    // the program ends with the arrival of all responses, the next one starts afresh
+			    m_halt.push_back(std::max(m_clock.now, m_clock.responses_done));
+			    m_clock = ZeroMockClock();
 		    }
 		    m_receive_queue.emplace_back(
 		        hxcomm::vx::UTMessageFromFPGA<hxcomm::vx::instruction::from_fpga_system::Loopback>(
@@ -27,12 +71,10 @@ void ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::operator()(
 	auto const process_jtag =
 	    [this](
 	        hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::to_fpga_jtag::Data> const& msg) {
-		    auto const keep_response = msg.get_payload().test(
-		        hxcomm::vx::instruction::to_fpga_jtag::Data::size -
-		        hxcomm::vx::instruction::to_fpga_jtag::Data::padded_num_bits_keep_response);
-		    if (!keep_response) { // is no read
+		    if (!ExpectedResponses<hxcomm::vx::ConnectionParameter>::has_response(msg)) {
 			    return;
 		    }
+		    issue_read();
 
 		    auto const response =
 		        hxcomm::vx::UTMessageFromFPGA<hxcomm::vx::instruction::jtag_from_hicann::Data>(
@@ -42,17 +84,53 @@ void ZeroMockProcessMessage<hxcomm::vx::ConnectionParameter>::operator()(
 	auto const process_omnibus =
 	    [this](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::omnibus_to_fpga::Address> const&
 	               msg) {
-		    if (!msg.get_payload().test(
-		            sizeof(uint32_t) *
-		            (CHAR_BIT /* address */ + 1 /* byte enables */))) { // is no read
+		    if (m_register_file) {
+			    if (auto const value = (*m_register_file)(msg)) {
+				    issue_read();
+				    m_receive_queue.emplace_back(
+				        hxcomm::vx::UTMessageFromFPGA<
+				            hxcomm::vx::instruction::omnibus_from_fpga::Data>(*value));
+			    }
+			    return;
+		    }
+		    if (!ExpectedResponses<hxcomm::vx::ConnectionParameter>::has_response(msg)) {
 			    return;
 		    }
+		    issue_read();
 		    auto const response =
 		        hxcomm::vx::UTMessageFromFPGA<hxcomm::vx::instruction::omnibus_from_fpga::Data>(0);
 		    m_receive_queue.emplace_back(response);
 	    };
+	auto const process_omnibus_data =
+	    [this](
+	        hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::omnibus_to_fpga::Data> const& msg) {
+		    if (m_register_file) {
+			    (*m_register_file)(msg);
+		    }
+	    };
+	auto const process_setup =
+	    [this](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::timing::Setup> const&) {
+		    m_clock.timer_origin = m_clock.now;
+	    };
+	auto const process_wait_until =
+	    [this](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::timing::WaitUntil> const&
+	               msg) {
+		    m_clock.now = std::max(
+		        m_clock.now,
+		        m_clock.timer_origin + m_timing_model.timer_tick * msg.decode().value());
+	    };
+	auto const process_barrier =
+	    [this](hxcomm::vx::UTMessageToFPGA<hxcomm::vx::instruction::timing::Barrier> const& msg) {
+		    typedef hxcomm::vx::instruction::timing::Barrier Barrier;
+		    if ((msg.get_payload() & (Barrier::omnibus | Barrier::jtag)).any()) {
+			    m_clock.now = std::max(m_clock.now, m_clock.responses_done);
+		    }
+	    };
 	std::visit(
-	    hate::overloaded{process_loopback, process_jtag, process_omnibus, [](auto&&) {}}, message);
+	    hate::overloaded{
+	        process_loopback, process_jtag, process_omnibus, process_omnibus_data, process_setup,
+	        process_wait_until, process_barrier, [](auto&&) {}},
+	    message);
 }
 
 } // namespace detail
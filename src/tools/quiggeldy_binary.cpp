@@ -15,9 +15,11 @@
 #include "logger/log4cxx/logging_ctrl.h"
 
 #include "cereal/types/hxcomm/common/utmessage.h"
+#include "hxcomm/common/cancellation_token.h"
 #include "hxcomm/common/fpga_ip_list.h"
 #include "hxcomm/common/multiconnection.h"
 #include "hxcomm/common/quiggeldy_utility.h"
+#include "hxcomm/common/thread_placement.h"
 #ifdef WITH_HXCOMM_HOSTARQ
 #include "hxcomm/vx/arqconnection.h"
 #endif
@@ -136,6 +138,8 @@ struct Config
 
 	std::size_t delay_after_connect_ms;
 	std::size_t max_num_connection_attempts;
+	std::size_t execution_timeout_ms;
+	std::size_t mock_execution_duration_ms;
 
 	std::size_t period_per_user_ms;
 
@@ -157,6 +161,7 @@ void configure(WorkerT& worker, Config& cfg)
 		HXCOMM_LOG_INFO(log, "Setting mock-mode.");
 	}
 	worker.set_enable_mock_mode(cfg.mock_mode);
+	worker.set_mock_execution_duration(std::chrono::milliseconds{cfg.mock_execution_duration_ms});
 
 	if (cfg.no_allocate_license) {
 		HXCOMM_LOG_DEBUG(
@@ -174,6 +179,11 @@ void configure(WorkerT& worker, Config& cfg)
 	if (cfg.max_num_connection_attempts > 0) {
 		worker.set_max_num_connection_attemps(cfg.max_num_connection_attempts);
 	}
+	if (cfg.execution_timeout_ms) {
+		HXCOMM_LOG_DEBUG(
+		    log, "Setting execution timeout: " << cfg.execution_timeout_ms << "ms");
+		worker.set_execution_timeout(std::chrono::milliseconds{cfg.execution_timeout_ms});
+	}
 
 	if (cfg.no_munge) {
 		HXCOMM_LOG_DEBUG(log, "Excplicitly disabling munge authentication.");
@@ -185,8 +195,15 @@ void configure(WorkerT& worker, Config& cfg)
 }
 
 template <class ServerT, class WorkerT, class VariantT>
-void allocate(std::unique_ptr<VariantT>& server, WorkerT&& worker, Config& cfg)
+void allocate(
+    std::unique_ptr<VariantT>& server,
+    WorkerT&& worker,
+    Config& cfg,
+    hxcomm::CancellationToken& cancellation_token)
 {
+	// the token shares its state with the worker's, so that executions can be cancelled without
+	// access to the worker
+	cancellation_token = worker.get_cancellation_token();
 	server.reset(new VariantT{
 	    std::in_place_type<ServerT>, RCF::TcpEndpoint(cfg.listen_ip, cfg.listen_port),
 	    std::move(worker), cfg.num_threads_input, cfg.num_threads_output, cfg.num_max_connections});
@@ -250,6 +267,11 @@ int main(int argc, const char* argv[])
 	("delay-after-connect-ms", po::value<std::size_t>(&(cfg.delay_after_connect_ms)),
 	 "Number of milliseconds to wait after connection to \"real\" backend failed.")
 
+	("execution-timeout-ms",
+	 po::value<std::size_t>(&(cfg.execution_timeout_ms))->default_value(0),
+	 "Number of milliseconds after which an execution on the \"real\" backend is aborted "
+	 "(0 for no timeout).")
+
 	("listen-ip", po::value<std::string>()->default_value("0.0.0.0"), "specify listening IP")
 	("listen-port,p", po::value<uint16_t>(&(cfg.listen_port))->required(),
 	 "specify listening port")
@@ -272,6 +294,9 @@ int main(int argc, const char* argv[])
 
 	("mock-mode", po::bool_switch(&(cfg.mock_mode))->default_value(false),
 	 "Operate in mock-mode, i.e., accept connections but return empty results.")
+	("mock-execution-duration-ms",
+	 po::value<std::size_t>(&(cfg.mock_execution_duration_ms))->default_value(0),
+	 "Number of milliseconds each execution takes in mock-mode.")
 	("no-allocate-license", po::bool_switch(&(cfg.no_allocate_license))->default_value(false),
 	 "Do not allocate license prior to running jobs.")
 	("no-munge", po::bool_switch(&(cfg.no_munge))->default_value(false),
@@ -289,6 +314,19 @@ int main(int argc, const char* argv[])
 	("slurm-partition", po::value<std::string>()->default_value("cube"),
 	 "Slurm partition in which to allocate license (if not disabled via --no-allocate-license).")
 
+	("thread-cpus", po::value<std::string>()->default_value(""),
+	 "CPU cores of the form \"0-3,8\" to pin connection receive threads to "
+	 "(overrides HXCOMM_THREAD_CPUS).")
+	("thread-numa-nodes", po::value<std::string>()->default_value(""),
+	 "NUMA nodes of the form \"0-1\" whose cores connection receive threads are pinned to "
+	 "(overrides HXCOMM_THREAD_NUMA_NODES).")
+	("thread-sched-fifo-priority", po::value<std::string>()->default_value(""),
+	 "SCHED_FIFO priority of connection receive threads "
+	 "(overrides HXCOMM_THREAD_SCHED_FIFO_PRIORITY).")
+	("server-thread-cpus", po::value<std::string>()->default_value(""),
+	 "CPU cores of the form \"0-3,8\" to pin server threads to, e.g. to keep them off the "
+	 "cores of the connection receive threads.")
+
 	("timeout,t", po::value<std::size_t>(&(cfg.timeout_seconds)),
 	 "Number of seconds after which quiggeldy shuts down when idling (0=disable).")
 
@@ -392,6 +430,28 @@ int main(int argc, const char* argv[])
 
 	HXCOMM_LOG_INFO(log, "Starting up..");
 
+	// connections read their thread placement from the environment upon construction
+	for (auto const& [option, env] :
+	     {std::pair{"thread-cpus", "HXCOMM_THREAD_CPUS"},
+	      std::pair{"thread-numa-nodes", "HXCOMM_THREAD_NUMA_NODES"},
+	      std::pair{"thread-sched-fifo-priority", "HXCOMM_THREAD_SCHED_FIFO_PRIORITY"}}) {
+		if (auto const value = vm[option].as<std::string>(); !value.empty()) {
+			setenv(env, value.c_str(), 1);
+		}
+	}
+	hxcomm::ThreadPlacement server_thread_placement;
+	try {
+		HXCOMM_LOG_INFO(
+		    log, "Connection thread placement: " << hxcomm::ThreadPlacement::from_env());
+		server_thread_placement = hxcomm::ThreadPlacement::from_string(
+		    vm["server-thread-cpus"].as<std::string>(), "", "");
+	} catch (std::runtime_error const& error) {
+		HXCOMM_LOG_ERROR(log, "Invalid thread placement: " << error.what());
+		return EXIT_FAILURE;
+	}
+	// threads spawned afterwards, i.e. signal handling and RCF threads, inherit the placement
+	server_thread_placement.apply("quiggeldy server");
+
 	// has to be called prior to QuiggeldyServer
 	auto thread_sig = quiggeldy::setup_signal_handler_thread();
 
@@ -400,6 +460,7 @@ int main(int argc, const char* argv[])
 	RCF::init();
 
 	std::unique_ptr<quiggeldy_server_t> server;
+	hxcomm::CancellationToken cancellation_token;
 
 	// create server
 	if (cfg.backend_arq + cfg.backend_sim > 1) {
@@ -434,7 +495,7 @@ int main(int argc, const char* argv[])
 		    connection_init_parameters, cfg.public_key, cfg.token_encryption,
 		    cfg.token_expiration_grace_time);
 		quiggeldy::configure(worker, cfg);
-		quiggeldy::allocate<QuiggeldyServerARQ>(server, std::move(worker), cfg);
+		quiggeldy::allocate<QuiggeldyServerARQ>(server, std::move(worker), cfg, cancellation_token);
 
 #endif
 
@@ -450,12 +511,13 @@ int main(int argc, const char* argv[])
 		    connection_init_parameters, cfg.public_key, cfg.token_encryption,
 		    cfg.token_expiration_grace_time);
 		quiggeldy::configure(worker, cfg);
-		quiggeldy::allocate<QuiggeldyServerSim>(server, std::move(worker), cfg);
+		quiggeldy::allocate<QuiggeldyServerSim>(server, std::move(worker), cfg, cancellation_token);
 	}
 
 	bool work_left_at_shutdown = false;
 	// we want to release a possible slurm allocation if the program fails under any circumstances
-	quiggeldy::signal_handler = [&server, &work_left_at_shutdown, &log](int sig) {
+	quiggeldy::signal_handler = [&server, &work_left_at_shutdown, &cancellation_token,
+	                             &log](int sig) {
 		auto log = log4cxx::Logger::getLogger("hxcomm.quiggeldy.signal_handler");
 		if (!server) {
 			HXCOMM_LOG_TRACE(log, "Server already terminated, exiting signal handler..");
@@ -463,9 +525,12 @@ int main(int argc, const char* argv[])
 		}
 
 		HXCOMM_LOG_DEBUG(log, "Received signal: " << sig << " (" << strsignal(sig) << ").");
-		auto shutdown = [&log, &server, &work_left_at_shutdown] {
+		auto shutdown = [&log, &server, &work_left_at_shutdown, &cancellation_token] {
 			work_left_at_shutdown =
 			    std::visit([](auto const& server) { return server.has_work_left(); }, *server);
+			// the running execution is not to delay the shutdown
+			HXCOMM_LOG_DEBUG(log, "Cancelling running execution.");
+			cancellation_token.cancel();
 			HXCOMM_LOG_DEBUG(log, "Shutting down server.");
 			server.reset();
 		};
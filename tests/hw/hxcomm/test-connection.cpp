@@ -1,3 +1,7 @@
+#include "hate/timer.h"
+#include "hxcomm/common/fpga_ip_list.h"
+#include "hxcomm/common/hwdb_cache.h"
+#include "hxcomm/common/logger.h"
 #include "hxcomm/vx/connection_from_env.h"
 #include <gtest/gtest.h>
 
@@ -100,6 +104,45 @@ TEST(TestConnection, ReceiveAll)
 	std::visit(test, *connection);
 }
 
+TEST(TestConnection, WireInfo)
+{
+	constexpr size_t num = 1000;
+
+	auto const test = [](auto& connection) {
+		if constexpr (requires { connection.get_wire_info(); }) {
+			auto const wire_begin = connection.get_wire_info();
+			{
+				Stream stream(connection);
+				for (size_t i = 0; i < num; ++i) {
+					stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+				}
+				stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+				stream.commit();
+				stream.run_until_halt();
+			}
+			auto const wire_info = connection.get_wire_info() - wire_begin;
+
+			auto logger = log4cxx::Logger::getLogger("hxcomm.TestConnection.WireInfo");
+			HXCOMM_LOG_INFO(logger, wire_info);
+
+			EXPECT_GT(wire_info.num_packets_sent, 0);
+			EXPECT_GE(wire_info.num_words_sent, wire_info.num_packets_sent);
+			EXPECT_LE(wire_info.num_partial_packets_sent, wire_info.num_packets_sent);
+			EXPECT_LE(wire_info.get_send_fill_ratio(), 1.);
+			EXPECT_GT(wire_info.num_packets_received, 0);
+			EXPECT_GE(wire_info.num_words_received, wire_info.num_packets_received);
+		} else {
+			GTEST_SKIP() << "Connection does not provide wire information.";
+		}
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
+
 TEST(TestConnection, FromEnv)
 {
 	// Just ensure that this compiles for now
@@ -120,3 +163,39 @@ TEST(TestConnection, Registry)
 	}
 	EXPECT_NO_THROW(get_connection_from_env());
 }
+
+#ifdef WITH_HXCOMM_HOSTARQ
+TEST(TestConnection, ConstructionDuration)
+{
+	{
+		auto connection = get_connection_from_env();
+		if (!std::holds_alternative<hxcomm::vx::MultiARQConnection>(connection)) {
+			GTEST_SKIP() << "Construction duration only measured for ARQConnection.";
+		}
+	}
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.TestConnection.ConstructionDuration");
+
+	constexpr size_t num = 10;
+	hate::Timer timer;
+	for (size_t i = 0; i < num; ++i) {
+		[[maybe_unused]] auto connection = get_connection_from_env();
+	}
+	HXCOMM_LOG_INFO(logger, "Average connection construction: " << timer.get_us() / num << " us");
+
+	auto const ip = hxcomm::get_fpga_ip_list().at(0);
+	timer.reset();
+	hwdb4cpp::database hwdb;
+	hwdb.load(hwdb4cpp::database::get_default_path());
+	HXCOMM_LOG_INFO(logger, "Loading of hwdb: " << timer.get_us() << " us");
+
+	constexpr size_t num_lookups = 1000;
+	auto& cache = hxcomm::HwdbCache::get_instance();
+	timer.reset();
+	for (size_t i = 0; i < num_lookups; ++i) {
+		cache.get_fpga_location(ip);
+	}
+	HXCOMM_LOG_INFO(
+	    logger, "Average cached hwdb lookup: " << timer.get_ns() / num_lookups << " ns");
+}
+#endif
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include "hxcomm/common/fpga_ip_list.h"
 #include "hxcomm/vx/connection_from_env.h"
+#include "hxcomm/vx/quiggeldy_worker.h"
+#include <chrono>
+#include <optional>
+#include <boost/uuid/uuid_generators.hpp>
 
 TEST(TestConnection, Halt)
 {
@@ -33,3 +38,121 @@ TEST(TestConnection, Halt)
 	}
 	std::visit(test, *connection);
 }
+
+TEST(TestConnection, HaltExecutionTimeout)
+{
+	using namespace hxcomm;
+	using namespace hxcomm::vx;
+	using namespace hxcomm::vx::instruction;
+
+	auto const test = [](auto& connection) {
+		if constexpr (requires { connection.set_execution_timeout(std::nullopt); }) {
+			connection.set_execution_timeout(std::chrono::milliseconds(10));
+			{
+				auto stream = Stream(connection);
+
+				// wait for about one second before halting
+				stream.add(UTMessageToFPGA<timing::Setup>());
+				stream.add(
+				    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(125000000)));
+				stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+				stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+				stream.commit();
+
+				EXPECT_THROW(stream.run_until_halt(), ExecutionAborted);
+				EXPECT_TRUE(stream.receive_empty());
+			}
+			connection.set_execution_timeout(std::nullopt);
+
+			// responses of the aborted execution are discarded
+			auto stream = Stream(connection);
+			stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+			stream.commit();
+			stream.run_until_halt();
+
+			auto const responses = stream.receive_all();
+			ASSERT_EQ(responses.size(), 1);
+			EXPECT_EQ(
+			    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.at(0)),
+			    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+
+			// cancelled token aborts execution until reset
+			auto token = connection.get_cancellation_token();
+			token.cancel();
+			stream.add(UTMessageToFPGA<timing::Setup>());
+			stream.add(UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(125000000)));
+			stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+			stream.commit();
+			EXPECT_THROW(stream.run_until_halt(), ExecutionAborted);
+			token.reset();
+		} else {
+			GTEST_SKIP() << "Connection does not support execution timeouts.";
+		}
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (std::holds_alternative<hxcomm::vx::SimConnection>(*connection)) {
+		GTEST_SKIP() << "Waiting in simulation exceeds test duration.";
+	}
+	std::visit(test, *connection);
+}
+
+TEST(QuiggeldyWorker, ExecutionWithoutHaltResponse)
+{
+	using namespace hxcomm;
+	using namespace hxcomm::vx;
+	using namespace hxcomm::vx::instruction;
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+#ifdef WITH_HXCOMM_HOSTARQ
+	if (!std::holds_alternative<hxcomm::vx::ARQConnection>(*connection)) {
+		GTEST_SKIP() << "Waiting in simulation exceeds test duration.";
+	}
+	// the worker sets up its own connection to the same FPGA
+	connection.reset();
+
+	typedef hxcomm::vx::QuiggeldyWorker<hxcomm::vx::ARQConnection> worker_type;
+	worker_type::init_parameters_type init;
+	std::get<0>(init).push_back(std::make_tuple(get_fpga_ip_list().at(0)));
+	worker_type worker(init);
+	worker.set_enable_allocate_license(false);
+	worker.set_use_munge(false);
+	worker.set_execution_timeout(std::chrono::milliseconds(100));
+	worker.set_discard_timeout(std::chrono::milliseconds(100));
+	worker.setup();
+
+	auto const session_id = boost::uuids::random_generator()();
+
+	// the halt response of a program waiting for about ten seconds arrives neither within the
+	// execution nor within the discard timeout
+	worker_type::request_type program_without_halt(1);
+	program_without_halt.at(0).push_back(UTMessageToFPGA<timing::Setup>());
+	program_without_halt.at(0).push_back(
+	    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(1250000000)));
+	EXPECT_THROW(worker.work(program_without_halt, session_id), ExecutionAborted);
+
+	// the connection was set up anew instead of discarding the halt response of the next program
+	worker_type::request_type program(1);
+	program.at(0).push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+	auto const result = worker.work(program, session_id);
+	ASSERT_EQ(result.size(), 1);
+	auto const& responses = result.at(0).first;
+	ASSERT_EQ(responses.size(), 2);
+	EXPECT_EQ(
+	    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.at(0)),
+	    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+	EXPECT_EQ(
+	    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.at(1)),
+	    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+
+	worker.teardown();
+#else
+	GTEST_SKIP() << "Only supported with HostARQ.";
+#endif
+}
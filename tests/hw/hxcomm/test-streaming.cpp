@@ -0,0 +1,181 @@
+#include "hxcomm/vx/connection_from_env.h"
+#include <chrono>
+#include <set>
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+TEST(TestConnection, StreamingReceive)
+{
+	constexpr size_t num = 100;
+
+	auto const test = [](auto& connection) {
+		hxcomm::Stream stream(connection);
+		for (size_t i = 0; i < num; ++i) {
+			stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+		}
+		stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+		stream.commit();
+
+		EXPECT_FALSE(stream.receive_halted());
+
+		typename std::decay_t<decltype(connection)>::receive_message_type message;
+		EXPECT_TRUE(stream.try_receive(message, std::chrono::seconds(10)));
+		EXPECT_EQ(
+		    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(message),
+		    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+
+		auto responses = stream.receive_all();
+		while (!stream.receive_halted()) {
+			stream.receive_some(responses, std::chrono::milliseconds(10));
+		}
+		EXPECT_TRUE(stream.receive_empty());
+		EXPECT_FALSE(stream.try_receive(message));
+		EXPECT_THROW(stream.receive(), std::runtime_error);
+
+		stream.run_until_halt();
+		EXPECT_FALSE(stream.receive_halted());
+
+		EXPECT_EQ(responses.size(), num);
+		EXPECT_EQ(
+		    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.back()),
+		    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (std::holds_alternative<hxcomm::vx::SimConnection>(*connection)) {
+		GTEST_SKIP() << "Simulation only progresses during run_until_halt.";
+	}
+	std::visit(test, *connection);
+}
+
+TEST(TestConnection, ExecuteMessagesCallback)
+{
+	constexpr size_t num = 1000;
+
+	std::vector<UTMessageToFPGAVariant> messages;
+	for (size_t i = 0; i < num; ++i) {
+		messages.push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+	}
+
+	auto const test = [messages](auto& connection) {
+		size_t num_responses = 0;
+		size_t num_batches = 0;
+		auto const time_info = hxcomm::execute_messages(
+		    connection, messages, [&num_responses, &num_batches](auto& responses) {
+			    EXPECT_FALSE(responses.empty());
+			    num_responses += responses.size();
+			    num_batches++;
+		    });
+		EXPECT_EQ(num_responses, num + 1 /* halt */);
+		EXPECT_GE(num_batches, 1);
+		EXPECT_GT(time_info.execution_duration, std::chrono::nanoseconds(0));
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
+
+TEST(TestConnection, ExecuteMessagesPipelined)
+{
+	constexpr size_t num_programs = 10;
+
+	std::vector<std::vector<UTMessageToFPGAVariant>> programs(num_programs);
+	for (size_t i = 0; i < num_programs; ++i) {
+		for (size_t j = 0; j < i; ++j) {
+			programs.at(i).push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+		}
+	}
+
+	auto const test = [programs](auto& connection) {
+		auto const results = hxcomm::execute_messages_pipelined(connection, programs);
+		ASSERT_EQ(results.size(), num_programs);
+		for (size_t i = 0; i < num_programs; ++i) {
+			auto const& [responses, time_info] = results.at(i);
+			EXPECT_EQ(responses.size(), i + 1 /* halt */);
+			EXPECT_EQ(
+			    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.back()),
+			    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+		}
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
+
+TEST(TestConnection, ExecuteMessagesInto)
+{
+	constexpr size_t num = 1000;
+	constexpr size_t num_executions = 10;
+
+	std::vector<UTMessageToFPGAVariant> messages;
+	for (size_t i = 0; i < num; ++i) {
+		messages.push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+	}
+
+	auto const test = [messages](auto& connection) {
+		typename std::decay_t<decltype(connection)>::receive_queue_type responses;
+		std::set<void const*> storages;
+		for (size_t i = 0; i < num_executions; ++i) {
+			hxcomm::execute_messages_into(connection, messages, responses);
+			EXPECT_EQ(responses.size(), num + 1 /* halt */);
+			EXPECT_EQ(
+			    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(responses.back()),
+			    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+			// storage of the buffer and the receive queue is exchanged after the first executions
+			if (i >= 2) {
+				storages.insert(responses.data());
+			}
+		}
+		EXPECT_LE(storages.size(), 2);
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
+
+TEST(TestConnection, ExecuteMessagesStreaming)
+{
+	constexpr size_t num_batches = 100;
+	constexpr size_t batch_size = 1000;
+
+	auto const test = [](auto& connection) {
+		size_t num_produced = 0;
+		size_t num_responses = 0;
+		auto const time_info = hxcomm::execute_messages_streaming(
+		    connection,
+		    [&num_produced](auto& messages) {
+			    EXPECT_TRUE(messages.empty());
+			    for (size_t i = 0; i < batch_size; ++i) {
+				    messages.push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+			    }
+			    return ++num_produced < num_batches;
+		    },
+		    [&num_responses](auto& responses) {
+			    EXPECT_FALSE(responses.empty());
+			    num_responses += responses.size();
+		    });
+		EXPECT_EQ(num_produced, num_batches);
+		EXPECT_EQ(num_responses, num_batches * batch_size + 1 /* halt */);
+		EXPECT_GT(time_info.execution_duration, std::chrono::nanoseconds(0));
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
@@ -74,6 +74,72 @@ TEST(TestConnection, ThroughputStream)
 	std::visit(test, *connection);
 }
 
+/**
+ * Rate of messages added one by one, which is limited by the per-message overhead of encoding and
+ * time accounting.
+ */
+TEST(TestConnection, ThroughputStreamSingleAdd)
+{
+	using namespace hxcomm::vx;
+	using namespace hxcomm::vx::instruction;
+
+	auto const test = [](auto& connection) {
+		hxcomm::Stream stream(connection);
+		constexpr size_t num = hate::math::pow(2, 24);
+		UTMessageToFPGAVariant const message = UTMessageToFPGA<timing::Setup>();
+
+		hate::Timer timer;
+		for (size_t i = 0; i < num; ++i) {
+			stream.add(message);
+		}
+		auto const add_ns = timer.get_ns();
+		stream.add(UTMessageToFPGA<system::Loopback>(system::Loopback::halt));
+		stream.commit();
+		stream.run_until_halt();
+		stream.receive_all();
+
+		auto logger = log4cxx::Logger::getLogger("hxcomm.test_throughput_stream_single_add");
+		HXCOMM_LOG_INFO(
+		    logger, "Add rate for " << num << " single messages: "
+		                            << static_cast<double>(num) * 1e3 / static_cast<double>(add_ns)
+		                            << " M/s");
+		HXCOMM_LOG_INFO(logger, connection.get_time_info());
+	};
+
+	auto connection = hxcomm::vx::get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (std::holds_alternative<hxcomm::vx::SimConnection>(*connection)) {
+		GTEST_SKIP() << "Throughput measurement skipped in simulation.";
+	}
+	std::visit(test, *connection);
+}
+
+#ifdef WITH_HXCOMM_HOSTARQ
+TEST(TestConnection, ThroughputStreamAsyncSend)
+{
+	auto connection = hxcomm::vx::get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (!std::holds_alternative<hxcomm::vx::ARQConnection>(*connection)) {
+		GTEST_SKIP() << "Asynchronous send queue only available for ARQConnection.";
+	}
+	auto& arq_connection = std::get<hxcomm::vx::ARQConnection>(*connection);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.test_throughput_stream_async_send");
+	constexpr size_t num = hate::math::pow(2, 26);
+	for (size_t const capacity : {0, 1, 8, 64}) {
+		arq_connection.set_send_queue_capacity(capacity);
+		hxcomm::Stream stream(arq_connection);
+		HXCOMM_LOG_INFO(logger, "Send queue capacity: " << capacity);
+		test_throughput_stream(num, stream);
+		EXPECT_TRUE(stream.receive_empty());
+	}
+}
+#endif
+
 template <typename Connection>
 double test_throughput_execute_messages(size_t const num, Connection& connection)
 {
@@ -261,3 +327,48 @@ TEST(TestMultiConnection, ThroughputExecuteMessagesRead)
 	}
 	std::visit(test, connection);
 }
+
+TEST(TestConnection, ThroughputExecuteMessagesPipelined)
+{
+	using namespace hxcomm::vx;
+	using namespace hxcomm::vx::instruction;
+
+	constexpr size_t num_programs = 100;
+	constexpr size_t program_size = 10000;
+
+	std::vector<UTMessageToFPGAVariant> instructions;
+	for (size_t i = 0; i < program_size; ++i) {
+		instructions.push_back(UTMessageToFPGA<timing::Setup>());
+	}
+	std::vector<std::vector<UTMessageToFPGAVariant>> programs(num_programs, instructions);
+
+	auto const test = [programs](auto& connection) {
+		hate::Timer timer;
+		for (auto const& program : programs) {
+			hxcomm::execute_messages(connection, program);
+		}
+		auto const sequential_us = timer.get_us();
+
+		timer.reset();
+		auto const results = hxcomm::execute_messages_pipelined(connection, programs);
+		auto const pipelined_us = timer.get_us();
+		EXPECT_EQ(results.size(), num_programs);
+
+		auto logger = log4cxx::Logger::getLogger("hxcomm.test_throughput_execute_messages_pipelined");
+		HXCOMM_LOG_INFO(
+		    logger, "Programs per second for " << num_programs << " programs of " << program_size
+		                                       << " messages: sequential: "
+		                                       << (num_programs * 1e6 / sequential_us)
+		                                       << ", pipelined: "
+		                                       << (num_programs * 1e6 / pipelined_us));
+	};
+
+	auto connection = hxcomm::vx::get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (std::holds_alternative<hxcomm::vx::SimConnection>(*connection)) {
+		GTEST_SKIP() << "Throughput measurement skipped in simulation.";
+	}
+	std::visit(test, *connection);
+}
@@ -0,0 +1,100 @@
+#include "hxcomm/common/logger.h"
+#include "hxcomm/vx/connection_from_env.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+TEST(TestConnection, Transact)
+{
+	constexpr size_t num = 3;
+
+	std::vector<UTMessageToFPGAVariant> messages;
+	for (size_t i = 0; i < num; ++i) {
+		messages.push_back(UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+	}
+	// no response expected
+	messages.push_back(UTMessageToFPGA<timing::Setup>());
+
+	auto const test = [messages, num](auto& connection) {
+		typename std::decay_t<decltype(connection)>::receive_queue_type responses;
+		for (size_t i = 0; i < 2; ++i) {
+			hxcomm::transact(connection, messages, responses);
+			EXPECT_EQ(responses.size(), num);
+			for (auto const& response : responses) {
+				EXPECT_EQ(
+				    std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(response),
+				    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+			}
+		}
+		// connection is usable for regular execution afterwards
+		auto const [execute_responses, time_info] = hxcomm::execute_messages(connection, messages);
+		EXPECT_EQ(execute_responses.size(), num + 1 /* halt */);
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	std::visit(test, *connection);
+}
+
+/**
+ * Round-trip latency of small programs compared to execute_messages.
+ */
+TEST(TestConnection, TransactLatency)
+{
+	constexpr size_t num_round_trips = 10000;
+
+	std::vector<UTMessageToFPGAVariant> messages{
+	    UTMessageToFPGA<system::Loopback>(system::Loopback::tick)};
+
+	auto const test = [messages](auto& connection) {
+		auto logger = log4cxx::Logger::getLogger("hxcomm.test_transact_latency");
+		auto const log_percentiles = [&logger](std::string const& name, auto durations) {
+			std::sort(durations.begin(), durations.end());
+			HXCOMM_LOG_INFO(
+			    logger, name << " round-trip latency: median: "
+			                 << durations.at(durations.size() / 2)
+			                 << " us, 90th percentile: " << durations.at(durations.size() * 9 / 10)
+			                 << " us, 99th percentile: "
+			                 << durations.at(durations.size() * 99 / 100)
+			                 << " us, 99.9th percentile: "
+			                 << durations.at(durations.size() * 999 / 1000) << " us");
+		};
+
+		typename std::decay_t<decltype(connection)>::receive_queue_type responses;
+		std::vector<size_t> durations_us;
+		for (size_t i = 0; i < num_round_trips; ++i) {
+			auto const begin = std::chrono::steady_clock::now();
+			hxcomm::transact(connection, messages, responses);
+			durations_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+			                           std::chrono::steady_clock::now() - begin)
+			                           .count());
+			ASSERT_EQ(responses.size(), 1);
+		}
+		log_percentiles("transact", durations_us);
+
+		durations_us.clear();
+		for (size_t i = 0; i < num_round_trips; ++i) {
+			auto const begin = std::chrono::steady_clock::now();
+			hxcomm::execute_messages(connection, messages);
+			durations_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+			                           std::chrono::steady_clock::now() - begin)
+			                           .count());
+		}
+		log_percentiles("execute_messages", durations_us);
+	};
+
+	auto connection = get_connection_full_stream_interface_from_env();
+	if (!connection) {
+		GTEST_SKIP();
+	}
+	if (std::holds_alternative<hxcomm::vx::SimConnection>(*connection)) {
+		GTEST_SKIP() << "Latency measurement skipped in simulation.";
+	}
+	std::visit(test, *connection);
+}
@@ -0,0 +1,183 @@
+#include "hate/timer.h"
+#include "hxcomm/common/async_send_queue.h"
+#include "hxcomm/common/logger.h"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+
+typedef std::array<uint64_t, 180> packet_type;
+
+TEST(AsyncSendQueue, General)
+{
+	EXPECT_THROW(
+	    AsyncSendQueue<packet_type>(0, [](packet_type const&) {}, []() {}), std::runtime_error);
+
+	constexpr size_t num = 1000;
+
+	std::vector<uint64_t> sent;
+	size_t num_flushes = 0;
+	{
+		AsyncSendQueue<packet_type> queue(
+		    4, [&sent](packet_type const& packet) { sent.push_back(packet.at(0)); },
+		    [&num_flushes]() { num_flushes++; });
+		EXPECT_EQ(queue.capacity(), 4);
+
+		packet_type packet;
+		for (size_t i = 0; i < num; ++i) {
+			packet.at(0) = i;
+			queue.push(packet);
+		}
+		queue.flush();
+		EXPECT_EQ(sent.size(), num);
+		EXPECT_EQ(num_flushes, 1);
+
+		packet.at(0) = num;
+		queue.push(packet);
+	}
+	// remaining packets are sent on destruction
+	ASSERT_EQ(sent.size(), num + 1);
+	for (size_t i = 0; i <= num; ++i) {
+		EXPECT_EQ(sent.at(i), i);
+	}
+}
+
+TEST(AsyncSendQueue, CapacityFromEnv)
+{
+	unsetenv("HXCOMM_SEND_QUEUE_CAPACITY");
+	EXPECT_EQ(get_send_queue_capacity_from_env(), 0);
+
+	setenv("HXCOMM_SEND_QUEUE_CAPACITY", "16", 1);
+	EXPECT_EQ(get_send_queue_capacity_from_env(), 16);
+
+	setenv("HXCOMM_SEND_QUEUE_CAPACITY", "16 packets", 1);
+	EXPECT_THROW(get_send_queue_capacity_from_env(), std::runtime_error);
+
+	// negative values are not wrapped to a huge capacity
+	for (auto const capacity : {"-1", "+1", " 1", ""}) {
+		setenv("HXCOMM_SEND_QUEUE_CAPACITY", capacity, 1);
+		EXPECT_THROW(get_send_queue_capacity_from_env(), std::runtime_error) << capacity;
+	}
+
+	unsetenv("HXCOMM_SEND_QUEUE_CAPACITY");
+}
+
+TEST(AsyncSendQueue, Backpressure)
+{
+	constexpr size_t capacity = 4;
+
+	std::atomic<bool> blocked(true);
+	std::atomic<size_t> num_sent(0);
+	AsyncSendQueue<packet_type> queue(
+	    capacity,
+	    [&](packet_type const&) {
+		    while (blocked) {
+			    std::this_thread::yield();
+		    }
+		    num_sent++;
+	    },
+	    []() {});
+
+	// the packet in transmission occupies its slot until sent
+	for (size_t i = 0; i < capacity; ++i) {
+		queue.push(packet_type());
+	}
+	std::atomic<bool> pushed(false);
+	std::thread producer([&]() {
+		queue.push(packet_type());
+		pushed = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_FALSE(pushed);
+	blocked = false;
+	producer.join();
+	EXPECT_TRUE(pushed);
+	queue.flush();
+	EXPECT_EQ(num_sent, capacity + 1);
+}
+
+TEST(AsyncSendQueue, Exception)
+{
+	size_t num_sent = 0;
+	AsyncSendQueue<packet_type> queue(
+	    4,
+	    [&num_sent](packet_type const&) {
+		    if (num_sent++ == 1) {
+			    throw std::runtime_error("Backend failure.");
+		    }
+	    },
+	    []() {});
+
+	queue.push(packet_type());
+	queue.push(packet_type());
+	EXPECT_THROW(queue.flush(), std::runtime_error);
+	// exception is rethrown only once
+	queue.push(packet_type());
+	EXPECT_NO_THROW(queue.flush());
+}
+
+/**
+ * Software stand-in for sending encoded packets over a window-limited link.
+ * Encoding costs CPU time in the producer, while the backend blocks on acknowledgements without
+ * using CPU time.
+ */
+TEST(AsyncSendQueue, Throughput)
+{
+	constexpr size_t num = 200;
+	auto const encode_duration = std::chrono::microseconds(50);
+	auto const send_duration = std::chrono::microseconds(50);
+
+	auto const encode = [encode_duration](packet_type& packet) {
+		hate::Timer timer;
+		while (timer.get_ns() < std::chrono::nanoseconds(encode_duration).count()) {
+			packet.at(0)++;
+		}
+	};
+	auto const send = [send_duration](packet_type const&) {
+		std::this_thread::sleep_for(send_duration);
+	};
+
+	hate::Timer timer;
+	packet_type packet{};
+	for (size_t i = 0; i < num; ++i) {
+		encode(packet);
+		send(packet);
+	}
+	auto const inline_us = timer.get_us();
+
+	// the first send only completes once the producer encoded the next packet, which proves that
+	// encoding and sending overlap
+	std::atomic<size_t> num_pushed = 0;
+	bool overlapped = false;
+	size_t num_sent = 0;
+	auto const overlapping_send = [&](packet_type const& packet) {
+		if (num_sent++ == 0) {
+			hate::Timer wait_timer;
+			while ((num_pushed.load() < 2) && (wait_timer.get_ms() < 10000)) {
+				std::this_thread::yield();
+			}
+			overlapped = num_pushed.load() >= 2;
+		}
+		send(packet);
+	};
+
+	AsyncSendQueue<packet_type> queue(8, overlapping_send, []() {});
+	timer.reset();
+	for (size_t i = 0; i < num; ++i) {
+		encode(packet);
+		queue.push(packet);
+		num_pushed++;
+	}
+	queue.flush();
+	auto const async_us = timer.get_us();
+	// flush synchronizes with the send thread
+	EXPECT_TRUE(overlapped);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.AsyncSendQueue");
+	HXCOMM_LOG_INFO(
+	    logger, "Duration of " << num << " packets: inline: " << inline_us
+	                           << " us, asynchronous: " << async_us << " us");
+}
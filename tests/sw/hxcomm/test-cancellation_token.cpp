@@ -0,0 +1,27 @@
+#include "hxcomm/common/cancellation_token.h"
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+
+TEST(CancellationToken, General)
+{
+	CancellationToken token;
+	EXPECT_FALSE(token.is_cancelled());
+
+	// copies share their state
+	CancellationToken copy(token);
+	std::thread canceller([&copy]() { copy.cancel(); });
+	canceller.join();
+	EXPECT_TRUE(token.is_cancelled());
+	EXPECT_TRUE(copy.is_cancelled());
+
+	token.reset();
+	EXPECT_FALSE(token.is_cancelled());
+	EXPECT_FALSE(copy.is_cancelled());
+
+	// independent tokens do not share their state
+	CancellationToken other;
+	other.cancel();
+	EXPECT_FALSE(token.is_cancelled());
+}
@@ -0,0 +1,166 @@
+#include "hate/timer.h"
+#include "hxcomm/common/chunked_send_queue.h"
+#include "hxcomm/common/logger.h"
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace hxcomm;
+
+typedef std::vector<uint64_t> buffer_type;
+
+TEST(ChunkedSendQueue, General)
+{
+	EXPECT_THROW(ChunkedSendQueue<buffer_type>(0), std::runtime_error);
+
+	ChunkedSendQueue<buffer_type> queue(4);
+	EXPECT_EQ(queue.get_chunk_size(), 4);
+	EXPECT_THROW(queue.set_chunk_size(0), std::runtime_error);
+	EXPECT_EQ(queue.get_chunk_size(), 4);
+
+	std::vector<buffer_type> sent;
+	auto const send = [&sent](buffer_type const& chunk) { sent.push_back(chunk); };
+
+	// empty queue is not sent
+	queue.flush(send);
+	EXPECT_TRUE(sent.empty());
+
+	for (uint64_t i = 0; i < 10; ++i) {
+		queue.push(i);
+	}
+	EXPECT_EQ(queue.size(), 10);
+	queue.flush(send);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(sent, (std::vector<buffer_type>{{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9}}));
+
+	sent.clear();
+	queue.set_chunk_size(8);
+	for (uint64_t i = 0; i < 8; ++i) {
+		queue.push(i);
+	}
+	queue.flush(send);
+	EXPECT_EQ(sent, (std::vector<buffer_type>{{0, 1, 2, 3, 4, 5, 6, 7}}));
+}
+
+TEST(ChunkedSendQueue, Exception)
+{
+	ChunkedSendQueue<buffer_type> queue(2);
+	for (uint64_t i = 0; i < 5; ++i) {
+		queue.push(i);
+	}
+
+	size_t num_sent = 0;
+	EXPECT_THROW(
+	    queue.flush([&num_sent](buffer_type const&) {
+		    if (num_sent++ == 1) {
+			    throw std::runtime_error("Backend failure.");
+		    }
+	    }),
+	    std::runtime_error);
+	// words of unsent chunks remain
+	EXPECT_EQ(queue.size(), 3);
+
+	std::vector<buffer_type> sent;
+	queue.flush([&sent](buffer_type const& chunk) { sent.push_back(chunk); });
+	EXPECT_EQ(sent, (std::vector<buffer_type>{{2, 3}, {4}}));
+}
+
+/**
+ * Software stand-in for sending words to the simulator via remote procedure calls.
+ * Each call transfers the chunk to a server thread over a socket and waits for its
+ * acknowledgement, so that the per-call round trip dominates for small chunks.
+ */
+TEST(ChunkedSendQueue, Throughput)
+{
+	constexpr size_t num = 20000;
+
+	int sockets[2];
+	ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+	auto const read_all = [](int const fd, void* data, size_t const size) {
+		auto* position = static_cast<char*>(data);
+		size_t remaining = size;
+		while (remaining) {
+			auto const num_read = read(fd, position, remaining);
+			if (num_read <= 0) {
+				return false;
+			}
+			position += num_read;
+			remaining -= num_read;
+		}
+		return true;
+	};
+	auto const write_all = [](int const fd, void const* data, size_t const size) {
+		auto const* position = static_cast<char const*>(data);
+		size_t remaining = size;
+		while (remaining) {
+			auto const num_written = write(fd, position, remaining);
+			if (num_written <= 0) {
+				throw std::runtime_error("Failed to write to socket.");
+			}
+			position += num_written;
+			remaining -= num_written;
+		}
+	};
+
+	size_t num_received = 0;
+	std::thread server([&]() {
+		buffer_type words;
+		uint64_t size;
+		while (read_all(sockets[1], &size, sizeof(size))) {
+			words.resize(size);
+			if (!read_all(sockets[1], words.data(), size * sizeof(uint64_t))) {
+				break;
+			}
+			num_received += size;
+			uint8_t const ack = 1;
+			write_all(sockets[1], &ack, sizeof(ack));
+		}
+	});
+
+	size_t num_chunks = 0;
+	auto const send = [&](buffer_type const& chunk) {
+		num_chunks++;
+		uint64_t const size = chunk.size();
+		write_all(sockets[0], &size, sizeof(size));
+		write_all(sockets[0], chunk.data(), size * sizeof(uint64_t));
+		uint8_t ack;
+		if (!read_all(sockets[0], &ack, sizeof(ack))) {
+			throw std::runtime_error("Failed to read acknowledgement from socket.");
+		}
+	};
+
+	auto const measure = [&](size_t const chunk_size) {
+		ChunkedSendQueue<buffer_type> queue(chunk_size);
+		num_chunks = 0;
+		hate::Timer timer;
+		for (uint64_t i = 0; i < num; ++i) {
+			queue.push(i);
+		}
+		queue.flush(send);
+		return timer.get_us();
+	};
+
+	constexpr size_t chunk_size = ChunkedSendQueue<buffer_type>::default_chunk_size;
+	auto const single_us = measure(1);
+	EXPECT_EQ(num_chunks, num);
+	auto const chunked_us = measure(chunk_size);
+	// the round trips per chunk are saved, the durations are only logged since they depend on
+	// the load of the machine
+	EXPECT_EQ(num_chunks, (num + chunk_size - 1) / chunk_size);
+
+	shutdown(sockets[0], SHUT_RDWR);
+	server.join();
+	close(sockets[0]);
+	close(sockets[1]);
+	EXPECT_EQ(num_received, 2 * num);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.ChunkedSendQueue");
+	HXCOMM_LOG_INFO(
+	    logger, "Duration of " << num << " words: single: " << single_us
+	                           << " us, chunked: " << chunked_us << " us");
+}
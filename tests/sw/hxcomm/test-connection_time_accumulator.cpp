@@ -0,0 +1,87 @@
+#include "hate/timer.h"
+#include "hxcomm/common/connection_time_accumulator.h"
+#include "hxcomm/common/logger.h"
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+
+TEST(ConnectionTimeAccumulator, General)
+{
+	ConnectionTimeAccumulator accumulator;
+	EXPECT_EQ(accumulator.get(), ConnectionTimeInfo());
+
+	// durations accumulate
+	for (size_t i = 0; i < 2; ++i) {
+		auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+	}
+
+	auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	accumulator.commit.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+
+	auto const time_info = accumulator.get();
+#ifdef HXCOMM_DISABLE_TIME_INFO
+	EXPECT_EQ(time_info, ConnectionTimeInfo());
+#else
+	EXPECT_GE(time_info.encode_duration, std::chrono::milliseconds(2));
+	EXPECT_GE(time_info.commit_duration, std::chrono::microseconds(500));
+	EXPECT_EQ(time_info.decode_duration, std::chrono::nanoseconds(0));
+	EXPECT_EQ(time_info.execution_duration, std::chrono::nanoseconds(0));
+#endif
+
+	ConnectionTimeAccumulator other;
+	other = accumulator;
+	EXPECT_EQ(other.get(), time_info);
+}
+
+/**
+ * Overhead of time accounting per message added one by one.
+ * Previously, every message was timed with a hate::Timer and two atomic additions.
+ */
+TEST(ConnectionTimeAccumulator, Overhead)
+{
+	constexpr size_t num = 1 << 22;
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.ConnectionTimeAccumulator");
+
+	std::atomic<std::chrono::nanoseconds::rep> encode_duration(0);
+	std::atomic<std::chrono::nanoseconds::rep> execution_duration(0);
+	hate::Timer timer_per_message;
+	for (size_t i = 0; i < num; ++i) {
+		hate::Timer timer;
+		auto const duration = timer.get_ns();
+		encode_duration.fetch_add(duration, std::memory_order_relaxed);
+		execution_duration.fetch_add(duration, std::memory_order_relaxed);
+	}
+	double const ns_per_message =
+	    static_cast<double>(timer_per_message.get_ns()) / static_cast<double>(num);
+
+	ConnectionTimeAccumulator accumulator;
+	hate::Timer timer_accumulator;
+	for (size_t i = 0; i < num; ++i) {
+		auto const time_begin = ConnectionTimeAccumulator::clock_type::now();
+		accumulator.encode.add(ConnectionTimeAccumulator::clock_type::now() - time_begin);
+	}
+	double const ns_accumulator =
+	    static_cast<double>(timer_accumulator.get_ns()) / static_cast<double>(num);
+
+	HXCOMM_LOG_INFO(
+	    logger, "Time accounting overhead per message: hate::Timer: "
+	                << ns_per_message << " ns, accumulator: " << ns_accumulator << " ns");
+}
+
+TEST(ConnectionTimeAccumulator, CacheLineSeparation)
+{
+	ConnectionTimeAccumulator accumulator;
+	auto const decode = reinterpret_cast<uintptr_t>(&accumulator.decode);
+	for (auto const* duration : {&accumulator.encode, &accumulator.commit, &accumulator.execution}) {
+		auto const address = reinterpret_cast<uintptr_t>(duration);
+		EXPECT_NE(
+		    address / ConnectionTimeAccumulator::cache_line_size,
+		    decode / ConnectionTimeAccumulator::cache_line_size);
+	}
+}
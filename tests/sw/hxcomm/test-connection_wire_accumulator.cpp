@@ -0,0 +1,48 @@
+#include "hxcomm/common/connection_wire_accumulator.h"
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+
+TEST(ConnectionWireAccumulator, General)
+{
+	ConnectionWireAccumulator accumulator;
+	EXPECT_EQ(accumulator.get(), ConnectionWireInfo());
+	EXPECT_EQ(accumulator.get().get_send_fill_ratio(), 0.);
+
+	auto const time_begin = ConnectionWireAccumulator::clock_type::now();
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	accumulator.add_sent(10, 10, ConnectionWireAccumulator::clock_type::now() - time_begin);
+	accumulator.add_sent(5, 10, 0);
+	// the receive thread accounts concurrently
+	std::thread receiver([&accumulator]() {
+		accumulator.add_received(3);
+		accumulator.add_received(4);
+	});
+	receiver.join();
+
+	auto const wire_info = accumulator.get();
+	EXPECT_EQ(wire_info.num_packets_sent, 2);
+	EXPECT_EQ(wire_info.num_words_sent, 15);
+	EXPECT_EQ(wire_info.num_words_capacity_sent, 20);
+	EXPECT_EQ(wire_info.num_partial_packets_sent, 1);
+	EXPECT_EQ(wire_info.num_packets_received, 2);
+	EXPECT_EQ(wire_info.num_words_received, 7);
+	EXPECT_DOUBLE_EQ(wire_info.get_send_fill_ratio(), 0.75);
+#ifdef HXCOMM_DISABLE_TIME_INFO
+	EXPECT_EQ(wire_info.send_blocked_duration, std::chrono::nanoseconds(0));
+#else
+	EXPECT_GE(wire_info.send_blocked_duration, std::chrono::microseconds(500));
+#endif
+
+	// unlimited packet size
+	accumulator.add_sent(1, 0, 0);
+	EXPECT_EQ(accumulator.get().num_partial_packets_sent, 1);
+
+	EXPECT_EQ(accumulator.get() - wire_info, (ConnectionWireInfo{1, 1, 0, 0, 0, 0, {}}));
+	EXPECT_EQ(wire_info + ConnectionWireInfo() - wire_info, ConnectionWireInfo());
+
+	ConnectionWireAccumulator other;
+	other = accumulator;
+	EXPECT_EQ(other.get(), accumulator.get());
+}
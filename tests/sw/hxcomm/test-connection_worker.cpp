@@ -0,0 +1,61 @@
+#include "hxcomm/common/connection_worker.h"
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+
+TEST(ConnectionWorker, General)
+{
+	constexpr size_t num = 1000;
+
+	std::atomic<size_t> count = 0;
+	std::thread::id worker_id;
+	{
+		ConnectionWorker worker("test");
+		// waiting without submitted task returns immediately
+		EXPECT_NO_THROW(worker.wait());
+
+		for (size_t i = 0; i < num; ++i) {
+			worker.submit([&count, &worker_id]() {
+				count++;
+				worker_id = std::this_thread::get_id();
+			});
+			worker.wait();
+			EXPECT_EQ(count, i + 1);
+			EXPECT_NE(worker_id, std::this_thread::get_id());
+		}
+
+		// tasks are executed on the same thread
+		auto const first_worker_id = worker_id;
+		worker.submit([&worker_id]() { worker_id = std::this_thread::get_id(); });
+		worker.wait();
+		EXPECT_EQ(worker_id, first_worker_id);
+
+		// submitting waits for previous task
+		worker.submit([&count]() { count++; });
+		worker.submit([&count]() { count++; });
+		worker.wait();
+		EXPECT_EQ(count, num + 2);
+
+		// pending task is completed on destruction
+		worker.submit([&count]() { count++; });
+	}
+	EXPECT_EQ(count, num + 3);
+}
+
+TEST(ConnectionWorker, Exception)
+{
+	ConnectionWorker worker("test");
+
+	worker.submit([]() { throw std::runtime_error("task failed"); });
+	EXPECT_THROW(worker.wait(), std::runtime_error);
+	// exception is rethrown only once
+	EXPECT_NO_THROW(worker.wait());
+
+	// worker stays usable
+	bool executed = false;
+	worker.submit([&executed]() { executed = true; });
+	EXPECT_NO_THROW(worker.wait());
+	EXPECT_TRUE(executed);
+}
@@ -0,0 +1,197 @@
+#include "hate/timer.h"
+#include "hxcomm/common/connection_registry.tcc"
+#include "hxcomm/common/construct_connections.h"
+#include "hxcomm/common/logger.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace hxcomm;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * Stand-in for a connection with slow setup registering its endpoint like ARQConnection.
+ */
+struct SlowConnection
+{
+	typedef std::string init_parameters_type;
+
+	static constexpr auto setup_duration = 50ms;
+
+	SlowConnection(init_parameters_type const& endpoint) :
+	    m_registry(std::make_unique<ConnectionRegistry<SlowConnection>>(endpoint))
+	{
+		std::this_thread::sleep_for(setup_duration);
+		if (endpoint.starts_with("fail")) {
+			throw std::runtime_error("Setup of " + endpoint + " failed.");
+		}
+	}
+
+	SlowConnection(SlowConnection&&) = default;
+
+	std::string const& get_endpoint() const { return m_registry->m_parameters; }
+
+	std::unique_ptr<ConnectionRegistry<SlowConnection>> m_registry;
+};
+
+/**
+ * Meeting point of all connections under construction.
+ */
+struct Rendezvous
+{
+	size_t const size;
+	std::chrono::milliseconds timeout;
+	size_t num_arrived = 0;
+	std::mutex mutex;
+	std::condition_variable condition;
+};
+
+/**
+ * Stand-in for a connection whose setup only completes once all connections are under
+ * construction at the same time, which never happens for sequential construction.
+ */
+struct RendezvousConnection
+{
+	typedef Rendezvous* init_parameters_type;
+
+	RendezvousConnection(init_parameters_type const& rendezvous)
+	{
+		std::unique_lock lock(rendezvous->mutex);
+		rendezvous->num_arrived++;
+		rendezvous->condition.notify_all();
+		if (!rendezvous->condition.wait_for(lock, rendezvous->timeout, [rendezvous] {
+			    return rendezvous->num_arrived == rendezvous->size;
+		    })) {
+			throw std::runtime_error("Connections were not constructed concurrently.");
+		}
+	}
+};
+
+std::vector<std::string> get_endpoints(size_t const size)
+{
+	std::vector<std::string> endpoints;
+	for (size_t i = 0; i < size; ++i) {
+		endpoints.push_back("endpoint" + std::to_string(i));
+	}
+	return endpoints;
+}
+
+} // namespace
+
+TEST(construct_connections, General)
+{
+	EXPECT_TRUE(construct_connections<SlowConnection>(std::vector<std::string>{}).empty());
+
+	auto const endpoints = get_endpoints(4);
+	{
+		auto const connections = construct_connections<SlowConnection>(endpoints);
+		ASSERT_EQ(connections.size(), endpoints.size());
+		for (size_t i = 0; i < endpoints.size(); ++i) {
+			EXPECT_EQ(connections.at(i).get_endpoint(), endpoints.at(i));
+		}
+
+		// endpoints are registered
+		EXPECT_THROW(
+		    construct_connections<SlowConnection>(std::vector{endpoints.at(0)}),
+		    std::runtime_error);
+	}
+	// endpoints are deregistered on destruction
+	EXPECT_EQ(construct_connections<SlowConnection>(endpoints).size(), endpoints.size());
+}
+
+TEST(construct_connections, Errors)
+{
+	// single error is rethrown unaltered
+	auto endpoints = get_endpoints(4);
+	endpoints.at(2) = "fail2";
+	try {
+		construct_connections<SlowConnection>(endpoints);
+		FAIL();
+	} catch (std::runtime_error const& e) {
+		EXPECT_EQ(std::string(e.what()), "Setup of fail2 failed.");
+	}
+
+	// multiple errors are aggregated, duplicate endpoints are detected concurrently
+	endpoints.at(0) = "fail0";
+	endpoints.at(3) = endpoints.at(1);
+	try {
+		construct_connections<SlowConnection>(endpoints);
+		FAIL();
+	} catch (std::runtime_error const& e) {
+		std::string const what(e.what());
+		EXPECT_NE(what.find("Failed to construct 3 of 4 connections"), std::string::npos);
+		EXPECT_NE(what.find("Setup of fail0 failed."), std::string::npos);
+		EXPECT_NE(what.find("Setup of fail2 failed."), std::string::npos);
+		EXPECT_NE(what.find("already connected endpoint"), std::string::npos);
+	}
+
+	// successfully constructed connections were destroyed
+	EXPECT_EQ(construct_connections<SlowConnection>(get_endpoints(4)).size(), 4);
+}
+
+TEST(construct_connections, Concurrency)
+{
+	constexpr size_t size = 8;
+
+	// the timeout only bounds the test duration on failure
+	Rendezvous rendezvous{.size = size, .timeout = 10s};
+	hate::Timer timer;
+	EXPECT_EQ(
+	    construct_connections<RendezvousConnection>(std::vector<Rendezvous*>(size, &rendezvous))
+	        .size(),
+	    size);
+	auto const concurrent_ms = timer.get_ms();
+
+	// sequential construction never completes, all but the last connection wait in vain
+	rendezvous.num_arrived = 0;
+	rendezvous.timeout = 0ms;
+	EXPECT_THROW(
+	    {
+		    std::vector<RendezvousConnection> sequential;
+		    for (size_t i = 0; i < size; ++i) {
+			    sequential.emplace_back(&rendezvous);
+		    }
+	    },
+	    std::runtime_error);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.construct_connections");
+	HXCOMM_LOG_INFO(
+	    logger, "Concurrent construction of " << size << " connections: " << concurrent_ms
+	                                          << " ms.");
+}
+
+TEST(construct_connections, Duration)
+{
+	constexpr size_t size = 8;
+	auto const endpoints = get_endpoints(size);
+
+	hate::Timer timer;
+	std::vector<SlowConnection> sequential;
+	for (auto const& endpoint : endpoints) {
+		sequential.emplace_back(endpoint);
+	}
+	auto const sequential_ms = timer.get_ms();
+	sequential.clear();
+
+	timer.reset();
+	auto const concurrent = construct_connections<SlowConnection>(endpoints);
+	auto const concurrent_ms = timer.get_ms();
+
+	// the speedup depends on the load of the machine and is therefore only logged, concurrency
+	// is checked deterministically above
+	EXPECT_GE(
+	    sequential_ms, std::chrono::milliseconds(SlowConnection::setup_duration * size).count());
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.construct_connections");
+	HXCOMM_LOG_INFO(
+	    logger, "Construction of " << size << " connections: sequential: " << sequential_ms
+	                               << " ms, concurrent: " << concurrent_ms << " ms.");
+}
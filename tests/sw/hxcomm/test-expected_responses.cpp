@@ -0,0 +1,33 @@
+#include "hxcomm/vx/expected_responses.h"
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+TEST(ExpectedResponses, General)
+{
+	hxcomm::detail::ExpectedResponses<ConnectionParameter> const expected_responses;
+
+	EXPECT_EQ(expected_responses(UTMessageToFPGA<system::Loopback>(system::Loopback::tick)), 1);
+	EXPECT_EQ(expected_responses(UTMessageToFPGA<system::Loopback>(system::Loopback::halt)), 1);
+	EXPECT_EQ(expected_responses(UTMessageToFPGA<timing::Setup>()), 0);
+
+	EXPECT_EQ(
+	    expected_responses(UTMessageToFPGA<omnibus_to_fpga::Address>(
+	        omnibus_to_fpga::Address::Payload(0x1234, /* is_read */ false))),
+	    0);
+	EXPECT_EQ(
+	    expected_responses(UTMessageToFPGA<omnibus_to_fpga::Address>(
+	        omnibus_to_fpga::Address::Payload(0x1234, /* is_read */ true))),
+	    1);
+	EXPECT_EQ(expected_responses(UTMessageToFPGA<omnibus_to_fpga::Data>(0x5678)), 0);
+
+	EXPECT_EQ(
+	    expected_responses(UTMessageToFPGA<to_fpga_jtag::Data>(
+	        to_fpga_jtag::Data::Payload(/* keep_response */ false))),
+	    0);
+	EXPECT_EQ(
+	    expected_responses(UTMessageToFPGA<to_fpga_jtag::Data>(
+	        to_fpga_jtag::Data::Payload(/* keep_response */ true))),
+	    1);
+}
@@ -0,0 +1,153 @@
+#include "hate/timer.h"
+#include "hxcomm/common/listener_halt.h"
+#include "hxcomm/common/logger.h"
+#include "hxcomm/vx/utmessage.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+typedef hxcomm::ListenerHalt<UTMessageFromFPGA<from_fpga_system::Loopback>> listener_type;
+
+TEST(ListenerHalt, General)
+{
+	listener_type listener;
+	EXPECT_FALSE(listener.get());
+
+	listener(UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+	EXPECT_FALSE(listener.get());
+
+	listener(UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+	EXPECT_TRUE(listener.get());
+	// already registered halt does not block
+	listener.wait();
+
+	listener(UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+	EXPECT_TRUE(listener.get());
+
+	listener.reset();
+	EXPECT_FALSE(listener.get());
+}
+
+/**
+ * Latency from registration of a halt response in the receive thread until the waiting thread
+ * continues, i.e. the latency added to run_until_halt on top of transport and decoding.
+ */
+TEST(ListenerHalt, Latency)
+{
+	constexpr size_t num = 1000;
+
+	listener_type listener;
+	std::atomic<bool> waiting(false);
+	std::atomic<long> notify_ns(0);
+	hate::Timer timer;
+
+	std::thread receiver([&]() {
+		for (size_t i = 0; i < num; ++i) {
+			while (!waiting.exchange(false)) {
+				std::this_thread::yield();
+			}
+			// let waiting thread block
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			notify_ns = timer.get_ns();
+			listener(
+			    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+		}
+	});
+
+	std::vector<size_t> durations_us;
+	for (size_t i = 0; i < num; ++i) {
+		waiting = true;
+		listener.wait();
+		durations_us.push_back((timer.get_ns() - notify_ns) / 1000);
+		listener.reset();
+	}
+	receiver.join();
+
+	std::sort(durations_us.begin(), durations_us.end());
+	auto const mean =
+	    std::accumulate(durations_us.begin(), durations_us.end(), static_cast<size_t>(0)) / num;
+	auto const median = durations_us.at(num / 2);
+	auto const p99 = durations_us.at(num * 99 / 100);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.ListenerHalt");
+	HXCOMM_LOG_INFO(logger, "Average halt notification latency: " << mean << " us");
+	HXCOMM_LOG_INFO(logger, "Median halt notification latency: " << median << " us");
+	// the latency depends on the load of the machine and is therefore only logged, previous
+	// exponential sleep polling added up to 10ms
+	HXCOMM_LOG_INFO(logger, "99th percentile halt notification latency: " << p99 << " us");
+}
+
+TEST(ListenerHalt, Interrupt)
+{
+	listener_type listener;
+
+	auto const interrupts = listener.get_interrupts();
+	std::thread interrupter([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		listener.interrupt();
+	});
+	EXPECT_FALSE(listener.wait(interrupts));
+	interrupter.join();
+	EXPECT_EQ(listener.get_interrupts(), interrupts + 1);
+
+	// registered halt takes precedence over interruption
+	listener(UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt));
+	EXPECT_TRUE(listener.wait(interrupts));
+	EXPECT_TRUE(listener.wait(listener.get_interrupts()));
+	listener.reset();
+	EXPECT_FALSE(listener.get());
+}
+
+TEST(ListenerHalt, Discard)
+{
+	typedef std::vector<UTMessageFromFPGAVariant> queue_type;
+
+	UTMessageFromFPGAVariant const tick =
+	    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick);
+	UTMessageFromFPGAVariant const halt =
+	    UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::halt);
+
+	listener_type listener;
+
+	// registered halt is consumed
+	listener(std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(halt));
+	EXPECT_TRUE(listener.consume_or_discard());
+	EXPECT_FALSE(listener.get());
+	EXPECT_FALSE(listener.is_discarding());
+
+	// next halt is discarded
+	EXPECT_FALSE(listener.consume_or_discard());
+	EXPECT_TRUE(listener.is_discarding());
+	EXPECT_EQ(listener.get_num_discarded(), 0);
+
+	queue_type queue{tick};
+	auto const decode = [&](queue_type const& messages) {
+		size_t const num_discarded = listener.get_num_discarded();
+		size_t const size = queue.size();
+		for (auto const& message : messages) {
+			queue.push_back(message);
+			std::visit([&](auto const& m) { listener(m); }, message);
+		}
+		listener.erase_discarded(queue, size, listener.get_num_discarded() - num_discarded);
+	};
+
+	// messages before the discarded halt are erased
+	decode({tick, tick});
+	EXPECT_EQ(queue, queue_type{tick});
+	EXPECT_TRUE(listener.is_discarding());
+
+	// messages up to and including the discarded halt are erased, later ones are kept
+	decode({tick, halt, tick, halt});
+	EXPECT_EQ(queue, (queue_type{tick, tick, halt}));
+	EXPECT_FALSE(listener.is_discarding());
+	EXPECT_EQ(listener.get_num_discarded(), 1);
+	EXPECT_TRUE(listener.get());
+	listener.reset();
+	EXPECT_FALSE(listener.get());
+}
@@ -1,8 +1,11 @@
 #include "hxcomm/common/connection_parameter.h"
+#include "hxcomm/common/execute_messages.h"
 #include "hxcomm/common/loopbackconnection.h"
 #include "hxcomm/test-helper.h"
 #include "hxcomm/vx/utmessage.h"
 #include "hxcomm/vx/utmessage_random.h"
+#include <condition_variable>
+#include <mutex>
 #include <gtest/gtest.h>
 
 using namespace hxcomm;
@@ -27,6 +30,10 @@ using namespace hxcomm::test;
 typedef UTMessageParameter<HEADER_ALIGNMENT, SUBWORD_TYPE, PHYWORD_TYPE, ToFPGADictionary>
     TestUTMessageParameter;
 
+typedef LoopbackConnection<TestUTMessageParameter, system::Loopback> TestLoopbackConnection;
+
+static_assert(hate::is_detected_v<ConnectionConcept, TestLoopbackConnection>);
+
 constexpr auto empty_sleep = std::chrono::microseconds(10000);
 
 static std::mt19937 rng{std::random_device{}()};
@@ -121,3 +128,142 @@ MYTEST(Name, MultipleMessages)
 	// no more messages available to receive
 	ASSERT_TRUE(connection.receive_empty());
 }
+
+/**
+ * Generate random messages not containing a halt message.
+ */
+std::vector<TestLoopbackConnection::send_message_type> random_program(size_t const size)
+{
+	std::vector<TestLoopbackConnection::send_message_type> messages;
+	while (messages.size() < size) {
+		auto message = random_ut_message<TestUTMessageParameter>(rng);
+		auto const* const halt =
+		    std::get_if<TestLoopbackConnection::send_halt_message_type>(&message);
+		if (halt && (halt->decode() == system::Loopback::halt)) {
+			continue;
+		}
+		messages.push_back(message);
+	}
+	return messages;
+}
+
+MYTEST(Name, ExecuteMessages)
+{
+	constexpr size_t max_message_count = 100;
+	auto const messages = random_program(random_integer(0, max_message_count));
+
+	TestLoopbackConnection connection;
+	auto const [responses, time_info] = execute_messages(connection, messages);
+	ASSERT_EQ(responses.size(), messages.size() + 1 /* halt */);
+	for (size_t i = 0; i < messages.size(); ++i) {
+		EXPECT_EQ(responses.at(i), messages.at(i));
+	}
+	EXPECT_EQ(
+	    responses.back(),
+	    TestLoopbackConnection::receive_message_type(
+	        TestLoopbackConnection::send_halt_message_type(system::Loopback::halt)));
+	EXPECT_TRUE(connection.receive_empty());
+}
+
+MYTEST(Name, ExecuteMessagesBackpressure)
+{
+	// programs exceed the capacity of the transport many times
+	constexpr size_t capacity = 2;
+	constexpr size_t message_count = 10 * capacity * TestLoopbackConnection::block_size;
+	std::vector<std::vector<TestLoopbackConnection::send_message_type>> const programs{
+	    random_program(message_count), random_program(message_count)};
+
+	TestLoopbackConnection connection(capacity);
+	EXPECT_EQ(connection.get_capacity(), capacity);
+	auto const results = execute_messages_pipelined(connection, programs);
+	ASSERT_EQ(results.size(), programs.size());
+	for (size_t i = 0; i < programs.size(); ++i) {
+		auto const& responses = results.at(i).first;
+		ASSERT_EQ(responses.size(), programs.at(i).size() + 1 /* halt */);
+		EXPECT_TRUE(std::equal(programs.at(i).begin(), programs.at(i).end(), responses.begin()));
+	}
+
+	EXPECT_THROW(TestLoopbackConnection(0), std::runtime_error);
+}
+
+MYTEST(Name, ExecuteMessagesStreamingBlockingProducer)
+{
+	auto const messages = random_program(10);
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	size_t num_responses = 0;
+	bool responded_while_producing = false;
+
+	size_t batch = 0;
+	auto const producer = [&](std::vector<TestLoopbackConnection::send_message_type>& next) {
+		if (batch++ == 0) {
+			next = messages;
+			return true;
+		}
+		// responses only arrive after the first batch is committed, which has to happen while the
+		// producer blocks
+		std::unique_lock<std::mutex> lock(mutex);
+		responded_while_producing = condition.wait_for(
+		    lock, std::chrono::seconds(10), [&num_responses]() { return num_responses > 0; });
+		return false;
+	};
+	auto const callback = [&](auto const& responses) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			num_responses += responses.size();
+		}
+		condition.notify_all();
+	};
+
+	TestLoopbackConnection connection;
+	execute_messages_streaming(connection, producer, callback);
+	EXPECT_TRUE(responded_while_producing);
+	EXPECT_EQ(num_responses, messages.size() + 1 /* halt */);
+}
+
+MYTEST(Name, ExecuteMessagesStreamingProducerError)
+{
+	auto const streamed_messages = random_program(10);
+
+	size_t batch = 0;
+	auto const producer = [&](std::vector<TestLoopbackConnection::send_message_type>& next) {
+		if (batch++ == 0) {
+			next = streamed_messages;
+			return true;
+		}
+		throw std::runtime_error("Producer failed.");
+	};
+
+	TestLoopbackConnection connection;
+	EXPECT_THROW(
+	    execute_messages_streaming(connection, producer, [](auto const&) {}),
+	    std::runtime_error);
+
+	// the failed execution is ended and its responses are discarded
+	auto const messages = random_program(10);
+	auto const responses = execute_messages(connection, messages).first;
+	ASSERT_EQ(responses.size(), messages.size() + 1 /* halt */);
+	EXPECT_TRUE(std::equal(messages.begin(), messages.end(), responses.begin()));
+}
+
+MYTEST(Name, Move)
+{
+	auto const messages = random_program(10);
+
+	TestLoopbackConnection connection;
+	connection.add(messages.begin(), messages.end());
+	TestLoopbackConnection moved_connection(std::move(connection));
+	moved_connection.commit();
+	size_t count = 0;
+	while (count < messages.size()) {
+		while (moved_connection.receive_empty()) {
+			std::this_thread::sleep_for(empty_sleep);
+		}
+		count += moved_connection.receive_all().size();
+	}
+	EXPECT_EQ(count, messages.size());
+
+	connection = std::move(moved_connection);
+	EXPECT_EQ(execute_messages(connection, messages).first.size(), messages.size() + 1);
+}
@@ -1,7 +1,23 @@
 #include "gtest/gtest.h"
 
+#include "hate/timer.h"
+#include "hxcomm/common/execute_messages.h"
+#include "hxcomm/common/logger.h"
+// MultiConnection of the test-local RendezvousConnection is not explicitly instantiated
+#include "hxcomm/common/multiconnection_impl.tcc"
 #include "hxcomm/vx/connection_from_env.h"
+#include "hxcomm/vx/multi_zeromockconnection.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <future>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+#include <vector>
 
 TEST(Multiconnection, Size)
 {
@@ -40,3 +56,364 @@ TEST(Multiconnection, Size)
 		EXPECT_NO_THROW(connection[i]);
 	}
 }
+
+namespace {
+
+hxcomm::vx::MultiZeroMockConnection get_multi_zeromock_connection(size_t const size)
+{
+	std::vector<hxcomm::vx::ZeroMockConnection> connections(size);
+	return hxcomm::vx::MultiZeroMockConnection(std::move(connections));
+}
+
+/**
+ * Meeting point of the rendezvous programs of RendezvousConnection.
+ */
+struct Rendezvous
+{
+	size_t const size;
+	std::chrono::milliseconds timeout;
+	size_t num_arrived = 0;
+	std::mutex mutex;
+	std::condition_variable condition;
+};
+
+/**
+ * ZeroMockConnection whose rendezvous programs, i.e. programs reading the rendezvous address,
+ * only complete once all rendezvous programs execute at the same time on different connections.
+ */
+class RendezvousConnection
+{
+public:
+	typedef hxcomm::vx::ZeroMockConnection::message_types message_types;
+	typedef hxcomm::vx::ZeroMockConnection::receive_message_type receive_message_type;
+	typedef hxcomm::vx::ZeroMockConnection::send_message_type send_message_type;
+	typedef hxcomm::vx::ZeroMockConnection::send_halt_message_type send_halt_message_type;
+	typedef hxcomm::vx::ZeroMockConnection::receive_queue_type receive_queue_type;
+
+	typedef std::tuple<Rendezvous*> init_parameters_type;
+
+	static constexpr char name[] = "RendezvousConnection";
+	static constexpr auto supported_targets = hxcomm::vx::ZeroMockConnection::supported_targets;
+
+	typedef hxcomm::vx::instruction::omnibus_to_fpga::Address address_type;
+	static inline hxcomm::vx::UTMessageToFPGA<address_type> const rendezvous_read{
+	    address_type::Payload(0x1234, true)};
+
+	RendezvousConnection(Rendezvous& rendezvous) :
+	    m_connection(), m_rendezvous(&rendezvous), m_is_rendezvous(false), m_mutex()
+	{}
+
+	RendezvousConnection(RendezvousConnection&& other) :
+	    m_connection(std::move(other.m_connection)),
+	    m_rendezvous(other.m_rendezvous),
+	    m_is_rendezvous(other.m_is_rendezvous),
+	    m_mutex()
+	{}
+
+	hxcomm::ConnectionTimeInfo get_time_info() const
+	{
+		return m_connection.get_time_info();
+	}
+
+private:
+	friend hxcomm::Stream<RendezvousConnection>;
+
+	void add(send_message_type const& message)
+	{
+		m_is_rendezvous |= (message == send_message_type(rendezvous_read));
+		hxcomm::Stream<hxcomm::vx::ZeroMockConnection>(m_connection).add(message);
+	}
+
+	template <typename InputIterator>
+	void add(InputIterator const& begin, InputIterator const& end)
+	{
+		for (auto it = begin; it != end; ++it) {
+			add(*it);
+		}
+	}
+
+	void commit()
+	{
+		hxcomm::Stream<hxcomm::vx::ZeroMockConnection>(m_connection).commit();
+	}
+
+	receive_queue_type receive_all()
+	{
+		return hxcomm::Stream<hxcomm::vx::ZeroMockConnection>(m_connection).receive_all();
+	}
+
+	void run_until_halt()
+	{
+		hxcomm::Stream<hxcomm::vx::ZeroMockConnection>(m_connection).run_until_halt();
+		if (!std::exchange(m_is_rendezvous, false)) {
+			return;
+		}
+		std::unique_lock lock(m_rendezvous->mutex);
+		m_rendezvous->num_arrived++;
+		m_rendezvous->condition.notify_all();
+		if (!m_rendezvous->condition.wait_for(lock, m_rendezvous->timeout, [this] {
+			    return m_rendezvous->num_arrived >= m_rendezvous->size;
+		    })) {
+			throw std::runtime_error("Rendezvous programs were not executed at the same time.");
+		}
+	}
+
+	std::mutex& get_mutex()
+	{
+		return m_mutex;
+	}
+
+	hxcomm::vx::ZeroMockConnection m_connection;
+	Rendezvous* m_rendezvous;
+	bool m_is_rendezvous;
+	std::mutex m_mutex;
+};
+
+} // namespace
+
+TEST(Multiconnection, ExecuteMessages)
+{
+	using namespace hxcomm::vx;
+
+	constexpr size_t size = 4;
+	auto connection = get_multi_zeromock_connection(size);
+
+	std::vector<std::vector<UTMessageToFPGAVariant>> programs(size);
+	for (size_t i = 0; i < size; ++i) {
+		for (size_t j = 0; j <= i; ++j) {
+			programs.at(i).push_back(
+			    UTMessageToFPGA<instruction::omnibus_to_fpga::Address>(
+			        instruction::omnibus_to_fpga::Address::Payload(j, true)));
+		}
+	}
+
+	// repeated executions reuse the workers of the connections
+	for (size_t repetition = 0; repetition < 3; ++repetition) {
+		auto const results = hxcomm::execute_messages(connection, programs);
+		ASSERT_EQ(results.size(), size);
+		for (size_t i = 0; i < size; ++i) {
+			EXPECT_EQ(results.at(i).first.size(), programs.at(i).size() + 1 /* halt */);
+		}
+	}
+
+	// moved connection keeps executing
+	auto moved_connection = std::move(connection);
+	EXPECT_EQ(hxcomm::execute_messages(moved_connection, programs).size(), size);
+
+	programs.pop_back();
+	EXPECT_THROW(hxcomm::execute_messages(moved_connection, programs), std::invalid_argument);
+}
+
+TEST(Multiconnection, ExecuteMessagesOverhead)
+{
+	using namespace hxcomm::vx;
+
+	constexpr size_t size = 4;
+	constexpr size_t num = 1000;
+	auto connection = get_multi_zeromock_connection(size);
+
+	std::vector<std::vector<UTMessageToFPGAVariant>> const programs(size);
+
+	// previous implementation launching a thread per sub-connection and execution
+	auto const execute_async = [&connection, &programs]() {
+		std::vector<std::future<void>> futures;
+		for (size_t i = 0; i < size; ++i) {
+			futures.push_back(std::async(std::launch::async, [&connection, &programs, i]() {
+				hxcomm::execute_messages(connection[i], programs.at(i));
+			}));
+		}
+		for (auto& future : futures) {
+			future.get();
+		}
+	};
+
+	hate::Timer timer;
+	for (size_t i = 0; i < num; ++i) {
+		execute_async();
+	}
+	auto const async_ns = timer.get_ns() / num;
+
+	timer.reset();
+	for (size_t i = 0; i < num; ++i) {
+		hxcomm::execute_messages(connection, programs);
+	}
+	auto const worker_ns = timer.get_ns() / num;
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.Multiconnection");
+	HXCOMM_LOG_INFO(
+	    logger, "Duration per execution of empty programs on "
+	                << size << " connections: thread per execution: " << async_ns
+	                << " ns, persistent workers: " << worker_ns << " ns.");
+}
+
+TEST(Multiconnection, ExecuteMessagesAsCompleted)
+{
+	using namespace hxcomm::vx;
+	using namespace std::chrono_literals;
+
+	constexpr size_t size = 4;
+
+	// the timeout only bounds the test duration on failure
+	Rendezvous rendezvous{.size = 2, .timeout = 10s};
+	std::vector<RendezvousConnection> rendezvous_connections;
+	for (size_t i = 0; i < size; ++i) {
+		rendezvous_connections.emplace_back(rendezvous);
+	}
+	hxcomm::MultiConnection<RendezvousConnection> rendezvous_connection(
+	    std::move(rendezvous_connections));
+
+	// the program of the first connection only completes once the callback arrived at the
+	// rendezvous for the result of another connection, i.e. results are handed to the callback
+	// while other executions are still running
+	std::vector<std::vector<UTMessageToFPGAVariant>> rendezvous_programs(size);
+	rendezvous_programs.at(0).push_back(RendezvousConnection::rendezvous_read);
+
+	std::vector<size_t> order;
+	hxcomm::execute_messages_as_completed(
+	    rendezvous_connection, rendezvous_programs, [&](size_t const index, auto&& result) {
+		    EXPECT_EQ(result.first.size(), rendezvous_programs.at(index).size() + 1 /* halt */);
+		    order.push_back(index);
+		    if (index != 0) {
+			    std::lock_guard lock(rendezvous.mutex);
+			    rendezvous.num_arrived++;
+			    rendezvous.condition.notify_all();
+		    }
+	    });
+
+	ASSERT_EQ(order.size(), size);
+	EXPECT_NE(order.front(), 0);
+	std::sort(order.begin(), order.end());
+	EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3}));
+
+	auto connection = get_multi_zeromock_connection(size);
+	std::vector<std::vector<UTMessageToFPGAVariant>> programs(size);
+	for (size_t i = 0; i < size; ++i) {
+		for (size_t j = 0; j <= i; ++j) {
+			programs.at(i).push_back(
+			    UTMessageToFPGA<instruction::omnibus_to_fpga::Address>(
+			        instruction::omnibus_to_fpga::Address::Payload(j, true)));
+		}
+	}
+
+	// exception of callback is rethrown after all executions completed
+	size_t num_invocations = 0;
+	EXPECT_THROW(
+	    hxcomm::execute_messages_as_completed(
+	        connection, programs,
+	        [&num_invocations](size_t, auto&&) {
+		        num_invocations++;
+		        throw std::runtime_error("Callback failed.");
+	        }),
+	    std::runtime_error);
+	EXPECT_EQ(num_invocations, 1);
+
+	// connection is usable afterwards
+	EXPECT_EQ(hxcomm::execute_messages(connection, programs).size(), size);
+
+	programs.pop_back();
+	EXPECT_THROW(
+	    hxcomm::execute_messages_as_completed(connection, programs, [](size_t, auto&&) {}),
+	    std::invalid_argument);
+}
+
+TEST(Multiconnection, ExecuteMessagesPooled)
+{
+	using namespace hxcomm::vx;
+	using namespace std::chrono_literals;
+
+	constexpr size_t size = 4;
+	constexpr size_t num_programs = 32;
+
+	ZeroMockConnection::timing_model_type timing_model;
+	timing_model.default_cost = 100us;
+	std::vector<ZeroMockConnection> connections;
+	for (size_t i = 0; i < size; ++i) {
+		connections.emplace_back(timing_model);
+	}
+	MultiZeroMockConnection connection(std::move(connections));
+
+	// programs of widely varying length
+	std::mt19937 rng(1234);
+	std::vector<std::vector<UTMessageToFPGAVariant>> programs(num_programs);
+	for (auto& program : programs) {
+		size_t const length = std::uniform_int_distribution<size_t>(0, 200)(rng);
+		for (size_t j = 0; j < length; ++j) {
+			program.push_back(
+			    UTMessageToFPGA<instruction::omnibus_to_fpga::Address>(
+			        instruction::omnibus_to_fpga::Address::Payload(j, true)));
+		}
+	}
+
+	hate::Timer timer;
+	auto const results = hxcomm::execute_messages_pooled(connection, programs);
+	auto const pooled_ms = timer.get_ms();
+
+	ASSERT_EQ(results.size(), num_programs);
+	for (size_t i = 0; i < num_programs; ++i) {
+		EXPECT_EQ(results.at(i).first.size(), programs.at(i).size() + 1 /* halt */);
+	}
+
+	// one program per connection in lockstep
+	timer.reset();
+	for (size_t i = 0; i < num_programs; i += size) {
+		std::vector<std::vector<UTMessageToFPGAVariant>> const batch(
+		    programs.begin() + i, programs.begin() + i + size);
+		hxcomm::execute_messages(connection, batch);
+	}
+	auto const lockstep_ms = timer.get_ms();
+
+	// the speedup depends on the load of the machine and is therefore only logged, overlapping
+	// execution is checked deterministically by ExecuteMessagesPooledOverlap
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.Multiconnection");
+	HXCOMM_LOG_INFO(
+	    logger, "Duration of " << num_programs << " programs on " << size
+	                           << " connections: lockstep: " << lockstep_ms
+	                           << " ms, pooled: " << pooled_ms << " ms.");
+
+	// fewer programs than connections
+	programs.resize(size / 2);
+	EXPECT_EQ(hxcomm::execute_messages_pooled(connection, programs).size(), size / 2);
+	programs.clear();
+	EXPECT_TRUE(hxcomm::execute_messages_pooled(connection, programs).empty());
+}
+
+TEST(Multiconnection, ExecuteMessagesPooledOverlap)
+{
+	using namespace hxcomm::vx;
+	using namespace std::chrono_literals;
+
+	// the timeout only bounds the test duration on failure
+	Rendezvous rendezvous{.size = 2, .timeout = 10s};
+	std::vector<RendezvousConnection> connections;
+	connections.emplace_back(rendezvous);
+	connections.emplace_back(rendezvous);
+	hxcomm::MultiConnection<RendezvousConnection> connection(std::move(connections));
+
+	// the first and the last program only complete when executed at the same time, so the
+	// connection done with the second program has to continue with the last program while the
+	// first one still executes
+	auto const& rendezvous_read = RendezvousConnection::rendezvous_read;
+	std::vector<std::vector<UTMessageToFPGAVariant>> const programs{
+	    {rendezvous_read}, {}, {rendezvous_read}};
+
+	hate::Timer timer;
+	auto const results = hxcomm::execute_messages_pooled(connection, programs);
+	auto const pooled_ms = timer.get_ms();
+	ASSERT_EQ(results.size(), programs.size());
+	for (size_t i = 0; i < programs.size(); ++i) {
+		EXPECT_EQ(results.at(i).first.size(), programs.at(i).size() + 1 /* halt */);
+	}
+
+	// in lockstep, the first program waits for the last one in vain
+	rendezvous.num_arrived = 0;
+	rendezvous.timeout = 0ms;
+	EXPECT_THROW(
+	    hxcomm::execute_messages(
+	        connection, std::vector<std::vector<UTMessageToFPGAVariant>>(
+	                        programs.begin(), programs.begin() + 2)),
+	    std::runtime_error);
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.Multiconnection");
+	HXCOMM_LOG_INFO(
+	    logger, "Duration of overlapping pooled execution: " << pooled_ms << " ms.");
+}
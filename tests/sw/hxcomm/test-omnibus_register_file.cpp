@@ -0,0 +1,124 @@
+#include "hate/timer.h"
+#include "hxcomm/common/logger.h"
+#include "hxcomm/vx/omnibus_register_file.h"
+#include <random>
+#include <unordered_map>
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+TEST(OmnibusRegisterFile, General)
+{
+	OmnibusRegisterFile registers;
+	EXPECT_EQ(registers.read(0), 0);
+	EXPECT_EQ(registers.num_pages(), 0);
+
+	registers.write(0, 1);
+	registers.write(OmnibusRegisterFile::page_size - 1, 2);
+	EXPECT_EQ(registers.num_pages(), 1);
+	registers.write(0xffffffff, 3);
+	EXPECT_EQ(registers.num_pages(), 2);
+	EXPECT_EQ(registers.read(0), 1);
+	EXPECT_EQ(registers.read(OmnibusRegisterFile::page_size - 1), 2);
+	EXPECT_EQ(registers.read(0xffffffff), 3);
+	EXPECT_EQ(registers.read(1), 0);
+
+	registers.write(0, 0xabcd0000, 0xffff0000);
+	EXPECT_EQ(registers.read(0), 0xabcd0001);
+
+	OmnibusRegisterFile moved(std::move(registers));
+	EXPECT_EQ(moved.read(0), 0xabcd0001);
+	registers = std::move(moved);
+	EXPECT_EQ(registers.read(0xffffffff), 3);
+
+	registers.clear();
+	EXPECT_EQ(registers.num_pages(), 0);
+	EXPECT_EQ(registers.read(0), 0);
+}
+
+TEST(OmnibusRegisterFile, Messages)
+{
+	OmnibusRegisterFile registers;
+
+	EXPECT_FALSE(registers(
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(42, false))));
+	registers(UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0x11223344)));
+	EXPECT_EQ(registers.read(42), 0x11223344);
+
+	// byte enables select the written bytes
+	EXPECT_FALSE(registers(UTMessageToFPGA<omnibus_to_fpga::Address>(
+	    omnibus_to_fpga::Address::Payload(42, false, 0b1010))));
+	registers(UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0xaabbccdd)));
+	EXPECT_EQ(registers.read(42), 0xaa22cc44);
+
+	auto const value = registers(
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(42, true)));
+	ASSERT_TRUE(value);
+	EXPECT_EQ(*value, 0xaa22cc44);
+
+	// data without preceding write access is ignored
+	registers(UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0)));
+	EXPECT_EQ(registers.read(42), 0xaa22cc44);
+}
+
+TEST(OmnibusRegisterFile, Random)
+{
+	constexpr size_t num = 100000;
+
+	std::mt19937 rng{std::random_device{}()};
+	// addresses clustered in a few regions like the configuration of the chip
+	std::uniform_int_distribution<uint32_t> random_region(0, 15);
+	std::uniform_int_distribution<uint32_t> random_offset(0, 1 << 16);
+	std::uniform_int_distribution<uint32_t> random_value;
+
+	OmnibusRegisterFile registers;
+	std::unordered_map<uint32_t, uint32_t> expected;
+	for (size_t i = 0; i < num; ++i) {
+		uint32_t const address = (random_region(rng) << 28) | random_offset(rng);
+		uint32_t const value = random_value(rng);
+		registers.write(address, value);
+		expected[address] = value;
+	}
+	for (auto const& [address, value] : expected) {
+		EXPECT_EQ(registers.read(address), value);
+	}
+}
+
+TEST(OmnibusRegisterFile, Throughput)
+{
+	constexpr size_t num = 1000000;
+
+	auto const measure = [](auto& registers, auto const& write, auto const& read) {
+		hate::Timer timer;
+		for (size_t i = 0; i < num; ++i) {
+			write(registers, static_cast<uint32_t>(i), static_cast<uint32_t>(i));
+		}
+		uint32_t sum = 0;
+		for (size_t i = 0; i < num; ++i) {
+			sum += read(registers, static_cast<uint32_t>(i));
+		}
+		auto const ns = timer.get_ns();
+		EXPECT_EQ(sum, static_cast<uint32_t>(num * (num - 1) / 2));
+		return static_cast<double>(ns) / static_cast<double>(2 * num);
+	};
+
+	OmnibusRegisterFile registers;
+	auto const ns_per_access = measure(
+	    registers,
+	    [](auto& r, uint32_t const address, uint32_t const value) { r.write(address, value); },
+	    [](auto const& r, uint32_t const address) { return r.read(address); });
+
+	std::unordered_map<uint32_t, uint32_t> map;
+	auto const ns_per_access_map = measure(
+	    map, [](auto& m, uint32_t const address, uint32_t const value) { m[address] = value; },
+	    [](auto const& m, uint32_t const address) {
+		    auto const it = m.find(address);
+		    return (it == m.end()) ? 0 : it->second;
+	    });
+
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.OmnibusRegisterFile");
+	HXCOMM_LOG_INFO(
+	    logger, "Sequential access: paged: " << ns_per_access
+	                                         << " ns, hash map: " << ns_per_access_map << " ns");
+}
@@ -164,6 +164,48 @@ TEST(Quiggeldy, SimpleMockModeAsynchronous)
 	}
 }
 
+TEST(Quiggeldy, ShutdownCancelsExecution)
+{
+	using namespace hxcomm;
+
+	auto log = log4cxx::Logger::getLogger("TestQuiggeldy");
+	HXCOMM_LOG_TRACE(log, "Starting");
+
+	hxcomm::port_t port = get_unused_port();
+
+	// each execution takes longer than the test is allowed to wait for the shutdown
+	int quiggeldy_pid = setup_quiggeldy(
+	    "quiggeldy", port, "--mock-mode", "--mock-execution-duration-ms", "600000", "--timeout",
+	    "10", hxcomm::is_munge_available() ? "" : "--no-munge");
+
+	using namespace std::literals::chrono_literals;
+	std::this_thread::sleep_for(1s);
+
+	auto client = hxcomm::vx::QuiggeldyConnection("127.0.0.1", port);
+	StreamRC<decltype(client)> stream_rc{client};
+	auto future = stream_rc.submit_async(decltype(client)::interface_types::request_type());
+	std::this_thread::sleep_for(1s);
+
+	HXCOMM_LOG_TRACE(log, "Killing quiggeldy during execution.");
+	kill(quiggeldy_pid, SIGTERM);
+
+	// the running execution is cancelled instead of delaying the shutdown
+	auto const deadline = std::chrono::steady_clock::now() + 60s;
+	int status;
+	pid_t waited;
+	while (((waited = waitpid(quiggeldy_pid, &status, WNOHANG)) == 0) &&
+	       (std::chrono::steady_clock::now() < deadline)) {
+		std::this_thread::sleep_for(100ms);
+	}
+	if (waited == 0) {
+		kill(quiggeldy_pid, SIGKILL);
+		waitpid(quiggeldy_pid, &status, 0);
+	}
+	ASSERT_EQ(waited, quiggeldy_pid) << "Quiggeldy did not terminate during execution.";
+	// TODO (bug #3973): known issue, quiggeldy sometimes exists abnormally
+	ASSERT_TRUE(WIFEXITED(status) || WIFSIGNALED(status));
+}
+
 TEST(Quiggeldy, SimpleMockModeReinit)
 {
 	using namespace hxcomm;
@@ -0,0 +1,156 @@
+#include "hate/timer.h"
+#include "hxcomm/common/logger.h"
+#include "hxcomm/common/receive_wait_policy.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+#include <time.h>
+
+using namespace hxcomm;
+
+namespace {
+
+long get_thread_cpu_ns()
+{
+	timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+/**
+ * Measure CPU usage of an idle receive worker and its wake-up latency on data arrival.
+ * The worker polls an atomic flag in place of the backend's data availability.
+ * @param policy Policy to measure
+ * @return Fraction of CPU time used while idle, number of blocking waits while idle and median
+ * wake-up latency in us
+ */
+std::tuple<double, size_t, size_t> measure(ReceiveWaitPolicy const& policy)
+{
+	ReceiveWaiter waiter(policy);
+	std::atomic<bool> run(true);
+	std::atomic<bool> available(false);
+	std::atomic<bool> received(false);
+	std::atomic<long> cpu_ns(0);
+
+	std::thread worker([&]() {
+		long const cpu_begin = get_thread_cpu_ns();
+		while (run) {
+			while (available.exchange(false)) {
+				received = true;
+				waiter.reset();
+			}
+			waiter.wait();
+		}
+		cpu_ns = get_thread_cpu_ns() - cpu_begin;
+	});
+
+	constexpr size_t idle_ms = 200;
+	hate::Timer idle_timer;
+	std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+	auto const num_blocking_waits = waiter.get_num_blocking_waits();
+	run = false;
+	waiter.notify();
+	worker.join();
+	double const cpu_fraction =
+	    static_cast<double>(cpu_ns) / static_cast<double>(idle_timer.get_ns());
+
+	// wake-up latency of worker in active execution, i.e. data is sent and awaited
+	run = true;
+	worker = std::thread([&]() {
+		while (run) {
+			while (available.exchange(false)) {
+				received = true;
+				waiter.reset();
+			}
+			waiter.wait();
+		}
+	});
+	constexpr size_t num = 100;
+	std::vector<size_t> durations_us;
+	for (size_t i = 0; i < num; ++i) {
+		ReceiveWaiter::Active active(waiter);
+		// let worker settle into its idle waiting state
+		std::this_thread::sleep_for(std::chrono::microseconds(50));
+		hate::Timer timer;
+		available = true;
+		while (!received) {
+			std::this_thread::yield();
+		}
+		durations_us.push_back(timer.get_us());
+		received = false;
+	}
+	run = false;
+	waiter.notify();
+	worker.join();
+
+	std::nth_element(
+	    durations_us.begin(), durations_us.begin() + durations_us.size() / 2, durations_us.end());
+	return {cpu_fraction, num_blocking_waits, durations_us.at(num / 2)};
+}
+
+} // namespace
+
+TEST(ReceiveWaitPolicy, General)
+{
+	ReceiveWaitPolicy policy;
+	EXPECT_EQ(policy.mode, ReceiveWaitPolicy::Mode::block);
+
+	ReceiveWaiter waiter(policy);
+	EXPECT_EQ(waiter.get_policy(), policy);
+
+	ReceiveWaitPolicy other_policy;
+	other_policy.mode = ReceiveWaitPolicy::Mode::spin_yield;
+	other_policy.max_wait = std::chrono::microseconds(100);
+	EXPECT_NE(other_policy, policy);
+	waiter.set_policy(other_policy);
+	EXPECT_EQ(waiter.get_policy(), other_policy);
+
+	std::stringstream ss;
+	ss << other_policy;
+	EXPECT_EQ(
+	    ss.str(),
+	    "ReceiveWaitPolicy(mode: spin_yield, spin_count: 10000, yield_count: 1000, max_wait: 100 "
+	    "us)");
+}
+
+TEST(ReceiveWaitPolicy, FromEnv)
+{
+	unsetenv("HXCOMM_RECEIVE_WAIT_POLICY");
+	EXPECT_EQ(ReceiveWaitPolicy::from_env(), ReceiveWaitPolicy());
+
+	setenv("HXCOMM_RECEIVE_WAIT_POLICY", "spin", 1);
+	EXPECT_EQ(ReceiveWaitPolicy::from_env().mode, ReceiveWaitPolicy::Mode::spin);
+
+	setenv("HXCOMM_RECEIVE_WAIT_POLICY", "unknown", 1);
+	EXPECT_THROW(ReceiveWaitPolicy::from_env(), std::runtime_error);
+
+	unsetenv("HXCOMM_RECEIVE_WAIT_POLICY");
+}
+
+TEST(ReceiveWaitPolicy, IdleLoadAndLatency)
+{
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.ReceiveWaitPolicy");
+
+	for (auto const mode :
+	     {ReceiveWaitPolicy::Mode::spin, ReceiveWaitPolicy::Mode::spin_yield,
+	      ReceiveWaitPolicy::Mode::block}) {
+		ReceiveWaitPolicy policy;
+		policy.mode = mode;
+		auto const [cpu_fraction, num_blocking_waits, median_us] = measure(policy);
+		HXCOMM_LOG_INFO(
+		    logger, mode << ": idle CPU usage: " << cpu_fraction * 100.
+		                 << " %, blocking waits: " << num_blocking_waits
+		                 << ", median wake-up latency: " << median_us << " us");
+		// the CPU usage depends on the load of the machine and is therefore only logged, an idle
+		// worker is only to block in block mode
+		if (mode == ReceiveWaitPolicy::Mode::block) {
+			EXPECT_GT(num_blocking_waits, 0);
+		} else {
+			EXPECT_EQ(num_blocking_waits, 0);
+		}
+	}
+}
@@ -0,0 +1,218 @@
+#include "hate/timer.h"
+#include "hxcomm/common/execute_messages.h"
+#include "hxcomm/vx/multi_recordingconnection.h"
+#include "hxcomm/vx/multi_replayconnection.h"
+#include "hxcomm/vx/recordingconnection.h"
+#include "hxcomm/vx/replayconnection.h"
+#include "hxcomm/vx/zeromockconnection.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+using namespace std::chrono_literals;
+
+typedef RecordingConnection<ZeroMockConnection> RecordingZeroMockConnection;
+
+static_assert(hate::is_detected_v<hxcomm::ConnectionConcept, RecordingZeroMockConnection>);
+static_assert(hate::is_detected_v<hxcomm::ConnectionConcept, ReplayConnection>);
+
+namespace {
+
+/**
+ * Temporary file removed on destruction.
+ */
+struct TemporaryFile
+{
+	TemporaryFile() : path("/tmp/hxcomm_test_record_replay_XXXXXX")
+	{
+		int const fd = mkstemp(path.data());
+		if (fd < 0) {
+			throw std::runtime_error("Failed to create temporary file.");
+		}
+		close(fd);
+	}
+
+	TemporaryFile(TemporaryFile const&) = delete;
+	TemporaryFile& operator=(TemporaryFile const&) = delete;
+
+	~TemporaryFile()
+	{
+		std::remove(path.c_str());
+	}
+
+	std::string path;
+};
+
+UTMessageToFPGAVariant write(uint32_t const address)
+{
+	return UTMessageToFPGA<omnibus_to_fpga::Address>(
+	    omnibus_to_fpga::Address::Payload(address, false));
+}
+
+UTMessageToFPGAVariant data(uint32_t const value)
+{
+	return UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(value));
+}
+
+UTMessageToFPGAVariant read(uint32_t const address)
+{
+	return UTMessageToFPGA<omnibus_to_fpga::Address>(
+	    omnibus_to_fpga::Address::Payload(address, true));
+}
+
+} // namespace
+
+TEST(RecordingConnection, ReplayResponses)
+{
+	TemporaryFile const file;
+	auto const& path = file.path;
+
+	std::vector<UTMessageToFPGAVariant> const program_write{write(12), data(34)};
+	std::vector<UTMessageToFPGAVariant> const program_read{read(12)};
+	std::vector<std::vector<UTMessageFromFPGAVariant>> recorded;
+	std::vector<hxcomm::ConnectionTimeInfo> recorded_time_info;
+	{
+		ZeroMockConnection zeromock;
+		zeromock.set_enable_register_file(true);
+		RecordingZeroMockConnection connection(std::move(zeromock), path);
+		EXPECT_EQ(connection.get_path(), path);
+		EXPECT_EQ(RecordingZeroMockConnection::name, "RecordingZeroMockConnection");
+
+		// the read program is recorded twice with different responses
+		for (auto const& program : {program_read, program_write, program_read}) {
+			auto [responses, time_info] = hxcomm::execute_messages(connection, program);
+			recorded.push_back(std::move(responses));
+			recorded_time_info.push_back(time_info);
+		}
+		EXPECT_EQ(connection.get_num_recorded_programs(), 3);
+	}
+	ASSERT_NE(recorded.at(0), recorded.at(2));
+
+	ReplayConnection connection(path, 0.);
+	EXPECT_EQ(connection.get_num_programs(), 3);
+	for (size_t repetition = 0; repetition < 2; ++repetition) {
+		auto const [responses_read, time_info_read] =
+		    hxcomm::execute_messages(connection, program_read);
+		EXPECT_EQ(responses_read, recorded.at(0));
+		auto const [responses_write, time_info_write] =
+		    hxcomm::execute_messages(connection, program_write);
+		EXPECT_EQ(responses_write, recorded.at(1));
+		// recordings of the same program are served in recorded order
+		auto const [responses_read_again, time_info_read_again] =
+		    hxcomm::execute_messages(connection, program_read);
+		EXPECT_EQ(responses_read_again, recorded.at(2));
+	}
+
+	// programs are identified by all of their messages
+	std::vector<UTMessageToFPGAVariant> const program_unknown{read(13)};
+	EXPECT_THROW(hxcomm::execute_messages(connection, program_unknown), std::runtime_error);
+	EXPECT_EQ(hxcomm::execute_messages(connection, program_read).first, recorded.at(0));
+
+	EXPECT_THROW(ReplayConnection(path, -1.), std::invalid_argument);
+	EXPECT_THROW(ReplayConnection(path + "_missing"), std::runtime_error);
+}
+
+TEST(RecordingConnection, ReplayPipelined)
+{
+	TemporaryFile const file;
+	auto const& path = file.path;
+
+	std::vector<std::vector<UTMessageToFPGAVariant>> const programs{
+	    {read(1)}, {read(2), read(3)}, {write(4), data(5)}};
+	std::vector<std::vector<UTMessageFromFPGAVariant>> recorded;
+	{
+		RecordingZeroMockConnection connection(ZeroMockConnection(), path);
+		for (auto& [responses, _] : hxcomm::execute_messages_pipelined(connection, programs)) {
+			recorded.push_back(std::move(responses));
+		}
+		// programs in flight at the same time are recorded separately
+		EXPECT_EQ(connection.get_num_recorded_programs(), programs.size());
+	}
+
+	ReplayConnection connection(path, 0.);
+	EXPECT_EQ(connection.get_num_programs(), programs.size());
+	auto const results = hxcomm::execute_messages_pipelined(connection, programs);
+	ASSERT_EQ(results.size(), programs.size());
+	for (size_t i = 0; i < programs.size(); ++i) {
+		EXPECT_EQ(results.at(i).first, recorded.at(i));
+	}
+}
+
+TEST(RecordingConnection, ReplayTiming)
+{
+	TemporaryFile const file;
+	auto const& path = file.path;
+
+	ZeroMockTimingModel model;
+	model.virtual_time = true;
+	model.default_cost = 0ns;
+	model.timer_tick = 1us;
+	std::vector<UTMessageToFPGAVariant> const program{
+	    UTMessageToFPGA<timing::Setup>(),
+	    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(20000))};
+	hxcomm::ConnectionTimeInfo recorded;
+	{
+		RecordingZeroMockConnection connection(ZeroMockConnection(model), path);
+		recorded = hxcomm::execute_messages(connection, program).second;
+		EXPECT_EQ(recorded.execution_duration, 20ms);
+	}
+
+	ReplayConnection connection(path);
+	EXPECT_EQ(connection.get_time_scale(), 1.);
+
+	for (double const time_scale : {1., 0.5, 0.}) {
+		connection.set_time_scale(time_scale);
+		auto const scale = [time_scale](std::chrono::nanoseconds const duration) {
+			return std::chrono::nanoseconds(
+			    std::llround(static_cast<double>(duration.count()) * time_scale));
+		};
+
+		auto const time_info_begin = connection.get_time_info();
+		hate::Timer timer;
+		hxcomm::execute_messages(connection, program);
+		auto const elapsed = std::chrono::nanoseconds(timer.get_ns());
+		auto const time_info = connection.get_time_info() - time_info_begin;
+
+		// durations not waited for are reported scaled exactly
+		EXPECT_EQ(time_info.encode_duration, scale(recorded.encode_duration)) << time_scale;
+		EXPECT_EQ(time_info.decode_duration, scale(recorded.decode_duration)) << time_scale;
+		EXPECT_EQ(time_info.commit_duration, scale(recorded.commit_duration)) << time_scale;
+		// the execution takes at least the scaled recorded duration, how much longer depends on
+		// the load of the machine
+		EXPECT_GE(time_info.execution_duration, scale(recorded.execution_duration))
+		    << time_scale;
+		EXPECT_GE(elapsed, scale(recorded.execution_duration)) << time_scale;
+	}
+}
+
+TEST(RecordingConnection, MultiConnection)
+{
+	TemporaryFile const file_0;
+	TemporaryFile const file_1;
+
+	std::vector<std::vector<UTMessageToFPGAVariant>> const programs{
+	    {read(1)}, {read(2), read(3)}};
+	{
+		typedef MultiRecordingConnection<ZeroMockConnection> multi_connection_type;
+		multi_connection_type connection(multi_connection_type::init_parameters_type{
+		    {{ZeroMockConnection::init_parameters_type{8}, file_0.path},
+		     {ZeroMockConnection::init_parameters_type{8}, file_1.path}}});
+		hxcomm::execute_messages(connection, programs);
+	}
+
+	std::vector<ReplayConnection> connections;
+	connections.emplace_back(file_0.path, 0.);
+	connections.emplace_back(file_1.path, 0.);
+	MultiReplayConnection connection(std::move(connections));
+	auto const results = hxcomm::execute_messages(connection, programs);
+	ASSERT_EQ(results.size(), 2);
+	EXPECT_EQ(results.at(0).first.size(), 1 + 1 /* halt */);
+	EXPECT_EQ(results.at(1).first.size(), 2 + 1 /* halt */);
+}
@@ -0,0 +1,213 @@
+#include "hxcomm/common/execute_messages.h"
+#include "hxcomm/common/utmessage_random.h"
+#include "hxcomm/vx/payload_random.h"
+#include "hxcomm/vx/response_sink.h"
+#include "hxcomm/vx/zeromockconnection.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+
+namespace {
+
+std::string get_temporary_path()
+{
+	std::string path = "/tmp/hxcomm_test_response_sink_XXXXXX";
+	int const fd = mkstemp(path.data());
+	if (fd < 0) {
+		throw std::runtime_error("Failed to create temporary file.");
+	}
+	close(fd);
+	return path;
+}
+
+} // namespace
+
+TEST(ResponseSink, RecordRandom)
+{
+	constexpr size_t num_batches = 100;
+	constexpr size_t max_batch_size = 1000;
+
+	std::mt19937 rng{std::random_device{}()};
+	std::uniform_int_distribution<size_t> random_batch_size(0, max_batch_size);
+
+	auto const path = get_temporary_path();
+	ResponseSink::Config config;
+	config.block_size = 1234;
+	config.num_blocks = 2;
+	ResponseSink sink(path, config);
+
+	ResponseSink::receive_queue_type expected;
+	for (size_t i = 0; i < num_batches; ++i) {
+		ResponseSink::receive_queue_type responses(random_batch_size(rng));
+		for (auto& response : responses) {
+			response = hxcomm::random::random_ut_message<ConnectionParameter::Receive>(rng);
+		}
+		sink(responses);
+		expected.insert(expected.end(), responses.begin(), responses.end());
+	}
+
+	auto const recording = sink.finish();
+	EXPECT_THROW(sink.finish(), std::runtime_error);
+	EXPECT_THROW(sink(expected), std::runtime_error);
+
+	auto const statistics = sink.get_statistics();
+	EXPECT_EQ(statistics.num_messages, expected.size());
+	EXPECT_EQ(statistics.num_dropped_messages, 0);
+
+	EXPECT_EQ(recording.get_path(), path);
+	EXPECT_EQ(recording.size(), expected.size());
+	EXPECT_EQ(recording.num_blocks(), statistics.num_blocks);
+	EXPECT_EQ(recording.read_all(), expected);
+
+	size_t num_loopback = 0;
+	for (auto const& message : expected) {
+		num_loopback +=
+		    std::holds_alternative<UTMessageFromFPGA<from_fpga_system::Loopback>>(message);
+	}
+	EXPECT_EQ(recording.count<UTMessageFromFPGA<from_fpga_system::Loopback>>(), num_loopback);
+
+	auto it = expected.begin();
+	recording.for_each<UTMessageFromFPGA<from_fpga_system::Loopback>>(
+	    [&it, &expected](auto const& message) {
+		    it = std::find_if(it, expected.end(), [](auto const& m) {
+			    return std::holds_alternative<UTMessageFromFPGA<from_fpga_system::Loopback>>(m);
+		    });
+		    ASSERT_NE(it, expected.end());
+		    EXPECT_EQ(std::get<UTMessageFromFPGA<from_fpga_system::Loopback>>(*it), message);
+		    ++it;
+	    });
+
+	std::remove(path.c_str());
+}
+
+TEST(ResponseSink, ExecuteMessages)
+{
+	constexpr size_t num = 10000;
+
+	std::vector<UTMessageToFPGAVariant> messages(
+	    num, UTMessageToFPGA<system::Loopback>(system::Loopback::tick));
+
+	auto const path = get_temporary_path();
+	ResponseSink sink(path);
+	ZeroMockConnection connection;
+	hxcomm::execute_messages(connection, messages, sink);
+	auto const recording = sink.finish();
+
+	EXPECT_EQ(recording.size(), num + 1 /* halt */);
+	EXPECT_EQ(recording.count<UTMessageFromFPGA<from_fpga_system::Loopback>>(), num + 1);
+
+	std::remove(path.c_str());
+}
+
+TEST(ResponseSink, Drop)
+{
+	auto const path = get_temporary_path();
+	ResponseSink::Config config;
+	config.block_size = 1;
+	config.num_blocks = 1;
+	config.drop_on_overflow = true;
+	ResponseSink sink(path, config);
+
+	// blocks are only freed by the write thread, so that the single block is in use while
+	// filling further messages
+	ResponseSink::receive_queue_type responses(
+	    100, UTMessageFromFPGA<from_fpga_system::Loopback>(from_fpga_system::Loopback::tick));
+	sink(responses);
+
+	auto const recording = sink.finish();
+	auto const statistics = sink.get_statistics();
+	EXPECT_EQ(statistics.num_messages + statistics.num_dropped_messages, responses.size());
+	EXPECT_EQ(recording.size(), statistics.num_messages);
+	EXPECT_EQ(statistics.num_stalls, 0);
+
+	std::remove(path.c_str());
+}
+
+TEST(ResponseRecording, InvalidFile)
+{
+	auto const path = get_temporary_path();
+	EXPECT_THROW(ResponseRecording{path}, std::runtime_error);
+	std::remove(path.c_str());
+	EXPECT_THROW(ResponseRecording{path}, std::runtime_error);
+}
+
+namespace {
+
+std::string record_random(std::string const& path, size_t const num)
+{
+	std::mt19937 rng{std::random_device{}()};
+	ResponseSink::receive_queue_type responses(num);
+	for (auto& response : responses) {
+		response = hxcomm::random::random_ut_message<ConnectionParameter::Receive>(rng);
+	}
+	ResponseSink sink(path);
+	sink(responses);
+	sink.finish();
+
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void write_file(std::string const& path, std::string const& content)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(content.data(), content.size());
+}
+
+} // namespace
+
+TEST(ResponseRecording, TruncatedFile)
+{
+	typedef hxcomm::detail::ResponseRecordingFormat<ConnectionParameter> format_type;
+	constexpr size_t header_size = sizeof(format_type::magic) +
+	                               (2 + format_type::num_types) *
+	                                   sizeof(format_type::header_type::word_type);
+
+	auto const path = get_temporary_path();
+	auto const content = record_random(path, 100);
+	EXPECT_EQ(ResponseRecording(path).size(), 100);
+
+	// a file ending after the header is a valid empty recording
+	write_file(path, content.substr(0, header_size));
+	EXPECT_EQ(ResponseRecording(path).size(), 0);
+
+	// the single block is cut at every possible position
+	for (size_t size = header_size + 1; size < content.size(); ++size) {
+		write_file(path, content.substr(0, size));
+		EXPECT_THROW(ResponseRecording{path}, std::runtime_error) << "size: " << size;
+	}
+
+	std::remove(path.c_str());
+}
+
+TEST(ResponseRecording, InconsistentTypeIndices)
+{
+	typedef hxcomm::detail::ResponseRecordingFormat<ConnectionParameter> format_type;
+	constexpr size_t type_indices_offset =
+	    sizeof(format_type::magic) +
+	    (2 + format_type::num_types) * sizeof(format_type::header_type::word_type) +
+	    (1 + format_type::num_types) * sizeof(format_type::count_type);
+
+	auto const path = get_temporary_path();
+	auto content = record_random(path, 100);
+
+	// type indices not matching the counts would select payloads outside their column
+	auto& type_index = content.at(type_indices_offset);
+	type_index = static_cast<char>((type_index + 1) % format_type::num_types);
+	write_file(path, content);
+	EXPECT_THROW(ResponseRecording{path}, std::runtime_error);
+
+	type_index = static_cast<char>(format_type::num_types);
+	write_file(path, content);
+	EXPECT_THROW(ResponseRecording{path}, std::runtime_error);
+
+	std::remove(path.c_str());
+}
@@ -1,5 +1,6 @@
 #include "cereal/types/hxcomm/common/utmessage.h"
 #include "hxcomm/common/connection_time_info.h"
+#include "hxcomm/common/connection_wire_info.h"
 #include "test-to_testing_types.h"
 #include <fstream>
 #include <type_traits>
@@ -16,7 +17,8 @@ class CommonSerializationTests : public ::testing::Test
 typedef typename to_testing_types<
     instruction::ToFPGADictionary,
     instruction::FromFPGADictionary,
-    hxcomm::ConnectionTimeInfo>::type SerializableTypes;
+    hxcomm::ConnectionTimeInfo,
+    hxcomm::ConnectionWireInfo>::type SerializableTypes;
 
 TYPED_TEST_CASE(CommonSerializationTests, SerializableTypes);
 
@@ -0,0 +1,262 @@
+#include "gtest/gtest.h"
+
+#include "hxcomm/common/decoder.h"
+#include "hxcomm/common/encoder.h"
+#include "hxcomm/common/execute_messages.h"
+#include "hxcomm/common/logger.h"
+#include "hxcomm/vx/simconnection.h"
+// SimConnection of the test-local simulator client is not explicitly instantiated
+#include "hxcomm/common/connection_registry.tcc"
+#include "hxcomm/common/simconnection_impl.tcc"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace hxcomm::vx;
+
+/**
+ * Simulation shared by all clients of a connection.
+ * It responds to each halt instruction with a halt response while it is runnable.
+ */
+struct FakeSimulation
+{
+	typedef flange::SimulatorEvent::al_data_t words_type;
+	typedef std::vector<UTMessageToFPGAVariant> instructions_type;
+
+	struct ResponseQueue
+	{
+		words_type words;
+
+		void push(words_type::value_type const word)
+		{
+			words.push_back(word);
+		}
+	};
+
+	std::mutex mutex;
+	bool runnable = false;
+	/**
+	 * Whether halt responses are held back, e.g. to let executions be aborted.
+	 */
+	bool hold = false;
+	size_t num_pending_halts = 0;
+
+	instructions_type instructions;
+	hxcomm::Decoder<ConnectionParameter::Send, instructions_type> decoder{instructions};
+	ResponseQueue responses;
+	hxcomm::Encoder<ConnectionParameter::Receive, ResponseQueue> encoder{responses};
+
+	/**
+	 * Thread ID of the receive worker polling for responses.
+	 */
+	std::optional<pid_t> receive_worker_tid;
+	/**
+	 * Time the last halt response was received by the receive worker.
+	 */
+	std::optional<std::chrono::steady_clock::time_point> halt_received;
+	/**
+	 * Durations from receiving halt responses until the simulation was stopped.
+	 */
+	std::vector<std::chrono::nanoseconds> halt_latencies;
+
+	static FakeSimulation* current;
+};
+
+FakeSimulation* FakeSimulation::current = nullptr;
+
+/**
+ * Test double of flange::SimulatorClient operating on the current FakeSimulation.
+ */
+class FakeSimulatorClient
+{
+public:
+	typedef hxcomm::ip_t ip_t;
+	typedef hxcomm::port_t port_t;
+
+	FakeSimulatorClient(ip_t const&, port_t) : m_simulation(*FakeSimulation::current) {}
+
+	void issue_reset() {}
+
+	void issue_terminate() {}
+
+	void set_runnable(bool const value)
+	{
+		std::lock_guard lock(m_simulation.mutex);
+		if (!value && m_simulation.halt_received) {
+			m_simulation.halt_latencies.push_back(
+			    std::chrono::steady_clock::now() - *m_simulation.halt_received);
+			m_simulation.halt_received.reset();
+		}
+		m_simulation.runnable = value;
+	}
+
+	bool get_runnable() const
+	{
+		std::lock_guard lock(m_simulation.mutex);
+		return m_simulation.runnable;
+	}
+
+	void send(FakeSimulation::words_type const& words)
+	{
+		std::lock_guard lock(m_simulation.mutex);
+		m_simulation.decoder(words.begin(), words.end());
+		for (auto const& instruction : m_simulation.instructions) {
+			auto const* const halt = std::get_if<UTMessageToFPGA<instruction::system::Loopback>>(
+			    &instruction);
+			if (halt && (halt->decode() == instruction::system::Loopback::halt)) {
+				m_simulation.num_pending_halts++;
+			}
+		}
+		m_simulation.instructions.clear();
+	}
+
+	bool receive_data_available()
+	{
+		std::lock_guard lock(m_simulation.mutex);
+		if (!m_simulation.receive_worker_tid) {
+			m_simulation.receive_worker_tid = static_cast<pid_t>(::syscall(SYS_gettid));
+		}
+		if (!m_simulation.runnable) {
+			return false;
+		}
+		if (!m_simulation.hold) {
+			for (; m_simulation.num_pending_halts; --m_simulation.num_pending_halts) {
+				m_simulation.encoder(UTMessageFromFPGA<instruction::from_fpga_system::Loopback>(
+				    instruction::from_fpga_system::Loopback::halt));
+				m_simulation.encoder.flush();
+			}
+		}
+		return !m_simulation.responses.words.empty();
+	}
+
+	FakeSimulation::words_type receive()
+	{
+		std::lock_guard lock(m_simulation.mutex);
+		m_simulation.halt_received = std::chrono::steady_clock::now();
+		return std::exchange(m_simulation.responses.words, {});
+	}
+
+private:
+	FakeSimulation& m_simulation;
+};
+
+typedef hxcomm::SimConnection<ConnectionParameter, FakeSimulatorClient> FakeSimConnection;
+
+/**
+ * Get scheduling state of thread, e.g. 'R' for running and 'S' for sleeping.
+ * @param tid Thread ID
+ * @return State character of /proc/self/task/<tid>/stat
+ */
+char get_thread_state(pid_t const tid)
+{
+	std::ifstream stat("/proc/self/task/" + std::to_string(tid) + "/stat");
+	std::string content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+	// the state follows the parenthesized command name
+	auto const end_of_name = content.rfind(')');
+	if ((end_of_name == std::string::npos) || (end_of_name + 2 >= content.size())) {
+		return '?';
+	}
+	return content.at(end_of_name + 2);
+}
+
+} // namespace
+
+TEST(SimConnection, ShortPrograms)
+{
+	using namespace std::chrono_literals;
+
+	FakeSimulation simulation;
+	FakeSimulation::current = &simulation;
+
+	FakeSimConnection connection("127.0.0.1", 50001);
+	hxcomm::ReceiveWaitPolicy policy;
+	policy.mode = hxcomm::ReceiveWaitPolicy::Mode::block;
+	policy.max_wait = 1s;
+	connection.set_receive_wait_policy(policy);
+
+	constexpr size_t num_programs = 1000;
+	std::vector<FakeSimConnection::send_message_type> const program;
+	for (size_t i = 0; i < num_programs; ++i) {
+		auto const responses = hxcomm::execute_messages(connection, program).first;
+		ASSERT_EQ(responses.size(), 1 /* halt */);
+	}
+
+	std::vector<std::chrono::nanoseconds> latencies;
+	std::optional<pid_t> tid;
+	{
+		std::lock_guard lock(simulation.mutex);
+		latencies = simulation.halt_latencies;
+		tid = simulation.receive_worker_tid;
+	}
+	// each execution ends once its halt response was received
+	ASSERT_EQ(latencies.size(), num_programs);
+	std::sort(latencies.begin(), latencies.end());
+	// the latencies depend on the load of the machine and are therefore only logged, each of them
+	// was previously extended to the next step of polling for the halt response every 10 ms
+	auto logger = log4cxx::Logger::getLogger("hxcomm.swtest.SimConnection");
+	HXCOMM_LOG_INFO(
+	    logger, "Halt notification latency of " << num_programs << " programs: median: "
+	                                            << latencies.at(num_programs / 2).count()
+	                                            << " ns, maximum: " << latencies.back().count()
+	                                            << " ns.");
+
+	// the idle receive worker is to block, while a spinning or yielding worker keeps running
+	// the timeout only bounds the test duration on failure
+	ASSERT_TRUE(tid);
+	bool blocked = false;
+	for (auto const deadline = std::chrono::steady_clock::now() + 10s;
+	     !blocked && (std::chrono::steady_clock::now() < deadline);
+	     std::this_thread::sleep_for(1ms)) {
+		blocked = (get_thread_state(*tid) == 'S');
+	}
+	EXPECT_TRUE(blocked);
+}
+
+TEST(SimConnection, WaitDiscarded)
+{
+	using namespace std::chrono_literals;
+
+	FakeSimulation simulation;
+	FakeSimulation::current = &simulation;
+
+	FakeSimConnection connection("127.0.0.1", 50002);
+	std::vector<FakeSimConnection::send_message_type> const program;
+
+	// the execution exceeds its deadline while its halt response is held back
+	{
+		std::lock_guard lock(simulation.mutex);
+		simulation.hold = true;
+	}
+	connection.set_execution_timeout(0ns);
+	EXPECT_THROW(hxcomm::execute_messages(connection, program), hxcomm::ExecutionAborted);
+	connection.set_execution_timeout(std::nullopt);
+	EXPECT_FALSE(connection.wait_discarded(0ns));
+
+	// the simulation is run until the halt response of the aborted execution arrived
+	// the timeout only bounds the test duration on failure
+	{
+		std::lock_guard lock(simulation.mutex);
+		simulation.hold = false;
+	}
+	EXPECT_TRUE(connection.wait_discarded(10s));
+	EXPECT_TRUE(connection.wait_discarded(0ns));
+
+	// the responses of the aborted execution are not received by the next one
+	auto const responses = hxcomm::execute_messages(connection, program).first;
+	ASSERT_EQ(responses.size(), 1 /* halt */);
+	EXPECT_EQ(
+	    responses.front(),
+	    FakeSimConnection::receive_message_type(
+	        UTMessageFromFPGA<instruction::from_fpga_system::Loopback>(
+	            instruction::from_fpga_system::Loopback::halt)));
+}
@@ -0,0 +1,91 @@
+#include "hxcomm/common/thread_placement.h"
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include <sched.h>
+
+using namespace hxcomm;
+
+TEST(ThreadPlacement, ParseIntegerList)
+{
+	EXPECT_EQ(parse_integer_list(""), std::vector<size_t>{});
+	EXPECT_EQ(parse_integer_list("3"), std::vector<size_t>{3});
+	EXPECT_EQ(parse_integer_list("8,0-3"), (std::vector<size_t>{0, 1, 2, 3, 8}));
+	EXPECT_EQ(parse_integer_list("1-2, 2-3,"), (std::vector<size_t>{1, 2, 3}));
+
+	EXPECT_THROW(parse_integer_list("a"), std::runtime_error);
+	EXPECT_THROW(parse_integer_list("3-1"), std::runtime_error);
+	EXPECT_THROW(parse_integer_list("-1"), std::runtime_error);
+	EXPECT_THROW(parse_integer_list("1-"), std::runtime_error);
+}
+
+TEST(ThreadPlacement, General)
+{
+	ThreadPlacement placement;
+	EXPECT_TRUE(placement.is_default());
+
+	auto const other_placement = ThreadPlacement::from_string("0-3,8", "", "");
+	EXPECT_FALSE(other_placement.is_default());
+	EXPECT_NE(other_placement, placement);
+
+	std::stringstream ss;
+	ss << placement << " " << other_placement;
+	EXPECT_EQ(
+	    ss.str(), "ThreadPlacement(cpus: any, scheduling: default) ThreadPlacement(cpus: 0-3,8, "
+	              "scheduling: default)");
+
+	EXPECT_THROW(ThreadPlacement::from_string("", "", "a"), std::runtime_error);
+	EXPECT_THROW(ThreadPlacement::from_string("", "", "100000"), std::runtime_error);
+	EXPECT_THROW(ThreadPlacement::from_string("", "100000", ""), std::runtime_error);
+}
+
+TEST(ThreadPlacement, FromEnv)
+{
+	unsetenv("HXCOMM_THREAD_CPUS");
+	unsetenv("HXCOMM_THREAD_NUMA_NODES");
+	unsetenv("HXCOMM_THREAD_SCHED_FIFO_PRIORITY");
+	EXPECT_EQ(ThreadPlacement::from_env(), ThreadPlacement());
+
+	setenv("HXCOMM_THREAD_CPUS", "0", 1);
+	setenv("HXCOMM_THREAD_SCHED_FIFO_PRIORITY", "10", 1);
+	auto const placement = ThreadPlacement::from_env();
+	EXPECT_EQ(placement.cpus, std::vector<size_t>{0});
+	EXPECT_EQ(placement.sched_fifo_priority, 10);
+
+	setenv("HXCOMM_THREAD_CPUS", "invalid", 1);
+	EXPECT_THROW(ThreadPlacement::from_env(), std::runtime_error);
+
+	unsetenv("HXCOMM_THREAD_CPUS");
+	unsetenv("HXCOMM_THREAD_SCHED_FIFO_PRIORITY");
+}
+
+TEST(ThreadPlacement, Apply)
+{
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+	size_t cpu = 0;
+	while (!CPU_ISSET(cpu, &cpu_set)) {
+		cpu++;
+	}
+
+	std::atomic<bool> run(true);
+	std::thread thread([&run]() {
+		while (run) {
+			std::this_thread::yield();
+		}
+	});
+
+	ThreadPlacement placement;
+	placement.cpus = {cpu};
+	placement.apply(thread.native_handle(), "test");
+	EXPECT_EQ(ThreadPlacement::get(thread.native_handle()).cpus, std::vector<size_t>{cpu});
+
+	// missing privileges for real-time scheduling only lead to a warning
+	placement.sched_fifo_priority = 1;
+	EXPECT_NO_THROW(placement.apply(thread.native_handle(), "test"));
+
+	run = false;
+	thread.join();
+}
@@ -0,0 +1,192 @@
+#include "hate/timer.h"
+#include "hxcomm/common/execute_messages.h"
+#include "hxcomm/common/stream.h"
+#include "hxcomm/vx/zeromockconnection.h"
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace hxcomm::vx;
+using namespace hxcomm::vx::instruction;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::chrono::nanoseconds execute(
+    ZeroMockConnection& connection, std::vector<UTMessageToFPGAVariant> const& messages)
+{
+	auto const time_info_begin = connection.get_time_info();
+	hxcomm::execute_messages(connection, messages);
+	return (connection.get_time_info() - time_info_begin).execution_duration;
+}
+
+} // namespace
+
+TEST(ZeroMockConnection, VirtualTimeCosts)
+{
+	ZeroMockTimingModel model;
+	model.virtual_time = true;
+	model.default_cost = 10ns;
+	model.set_cost<timing::Setup>(100ns);
+	EXPECT_EQ(model.get_cost<timing::Setup>(), 100ns);
+	EXPECT_EQ(model.get_cost<timing::Barrier>(), 10ns);
+
+	ZeroMockConnection connection(model);
+	EXPECT_EQ(connection.get_timing_model().default_cost, 10ns);
+
+	std::vector<UTMessageToFPGAVariant> messages{
+	    UTMessageToFPGA<timing::Setup>(),
+	    UTMessageToFPGA<system::Loopback>(system::Loopback::tick)};
+	// the halt message is added by execute_messages
+	EXPECT_EQ(execute(connection, messages), 100ns + 10ns + 10ns);
+}
+
+TEST(ZeroMockConnection, VirtualTimeWaitUntil)
+{
+	ZeroMockTimingModel model;
+	model.virtual_time = true;
+	model.default_cost = 0ns;
+	model.timer_tick = 8ns;
+	ZeroMockConnection connection(model);
+
+	// one second of modelled time does not pass in reality
+	constexpr uint32_t ticks = 125000000;
+	std::vector<UTMessageToFPGAVariant> messages{
+	    UTMessageToFPGA<timing::Setup>(),
+	    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(ticks)),
+	    // already passed timer value does not wait
+	    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(1))};
+	hate::Timer timer;
+	EXPECT_EQ(execute(connection, messages), 1s);
+	EXPECT_LT(timer.get_ms(), 1000);
+
+	// the timer is reset by the setup instruction only
+	messages = {UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(10))};
+	EXPECT_EQ(execute(connection, messages), 80ns);
+}
+
+TEST(ZeroMockConnection, VirtualTimeReadLatency)
+{
+	ZeroMockTimingModel model;
+	model.virtual_time = true;
+	model.default_cost = 1ns;
+	model.read_latency = 1us;
+	ZeroMockConnection connection(model);
+
+	UTMessageToFPGA<omnibus_to_fpga::Address> const read(
+	    omnibus_to_fpga::Address::Payload(0, true));
+
+	// reads are pipelined and awaited at the end of the program
+	std::vector<UTMessageToFPGAVariant> messages{read, read, read};
+	EXPECT_EQ(execute(connection, messages), 3ns + 1us);
+
+	// barrier on the omnibus waits for the response before issuing further reads
+	messages = {
+	    read, UTMessageToFPGA<timing::Barrier>(timing::Barrier::omnibus), read,
+	    UTMessageToFPGA<timing::Barrier>(timing::Barrier::omnibus)};
+	EXPECT_EQ(execute(connection, messages), 1ns + 1us + 1ns + 1us + 1ns);
+
+	// barrier on other channels does not wait for reads
+	messages = {read, UTMessageToFPGA<timing::Barrier>(timing::Barrier::systime)};
+	EXPECT_EQ(execute(connection, messages), 1ns + 1us);
+
+	// writes do not wait for responses
+	messages = {
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(0, false)),
+	    UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0))};
+	EXPECT_EQ(execute(connection, messages), 3ns);
+}
+
+TEST(ZeroMockConnection, VirtualTimePipelined)
+{
+	ZeroMockTimingModel model;
+	model.virtual_time = true;
+	model.default_cost = 0ns;
+	model.timer_tick = 8ns;
+	ZeroMockConnection connection(model);
+
+	UTMessageToFPGA<system::Loopback> const halt(system::Loopback::halt);
+
+	// both programs are added before the first one is executed
+	hxcomm::Stream stream(connection);
+	stream.add(UTMessageToFPGA<timing::Setup>());
+	stream.add(UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(1000)));
+	stream.add(halt);
+	stream.add(UTMessageToFPGA<timing::Setup>());
+	stream.add(UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(10)));
+	stream.add(halt);
+	stream.commit();
+
+	// each execution spends the modelled duration of its own program
+	auto time_info = connection.get_time_info();
+	stream.run_until_halt();
+	EXPECT_EQ((connection.get_time_info() - time_info).execution_duration, 8us);
+	time_info = connection.get_time_info();
+	stream.run_until_halt();
+	EXPECT_EQ((connection.get_time_info() - time_info).execution_duration, 80ns);
+	EXPECT_THROW(stream.run_until_halt(), std::runtime_error);
+}
+
+TEST(ZeroMockConnection, RealTime)
+{
+	ZeroMockTimingModel model;
+	model.timer_tick = 1us;
+	ZeroMockConnection connection(model);
+
+	constexpr uint32_t ticks = 10000;
+	std::vector<UTMessageToFPGAVariant> messages{
+	    UTMessageToFPGA<timing::Setup>(),
+	    UTMessageToFPGA<timing::WaitUntil>(timing::WaitUntil::Payload(ticks))};
+	hate::Timer timer;
+	auto const duration = execute(connection, messages);
+	EXPECT_GE(duration, 10ms);
+	EXPECT_GE(timer.get_ms(), 10);
+}
+
+TEST(ZeroMockConnection, RegisterFile)
+{
+	ZeroMockConnection connection;
+	EXPECT_FALSE(connection.get_enable_register_file());
+
+	std::vector<UTMessageToFPGAVariant> const messages{
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(123, false)),
+	    UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0x12345678)),
+	    // only the lowest byte is written
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(
+	        omnibus_to_fpga::Address::Payload(123, false, 0b0001)),
+	    UTMessageToFPGA<omnibus_to_fpga::Data>(omnibus_to_fpga::Data::Payload(0xffffffff)),
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(123, true)),
+	    UTMessageToFPGA<omnibus_to_fpga::Address>(omnibus_to_fpga::Address::Payload(124, true))};
+	std::vector<UTMessageToFPGAVariant> const read_messages(messages.end() - 2, messages.end());
+
+	auto const read = [](ZeroMockConnection& connection,
+	                     std::vector<UTMessageToFPGAVariant> const& messages) {
+		auto const [responses, _] = hxcomm::execute_messages(connection, messages);
+		std::vector<uint32_t> values;
+		for (auto const& response : responses) {
+			if (auto const* data = std::get_if<UTMessageFromFPGA<omnibus_from_fpga::Data>>(
+			        &response)) {
+				values.push_back(data->decode().value());
+			}
+		}
+		return values;
+	};
+
+	EXPECT_EQ(read(connection, messages), (std::vector<uint32_t>{0, 0}));
+
+	connection.set_enable_register_file(true);
+	EXPECT_TRUE(connection.get_enable_register_file());
+	EXPECT_EQ(read(connection, messages), (std::vector<uint32_t>{0x123456ff, 0}));
+
+	// register contents are kept on move
+	ZeroMockConnection moved_connection(std::move(connection));
+	EXPECT_TRUE(moved_connection.get_enable_register_file());
+	connection = std::move(moved_connection);
+	EXPECT_EQ(read(connection, read_messages), (std::vector<uint32_t>{0x123456ff, 0}));
+
+	// register contents are discarded on disabling
+	connection.set_enable_register_file(false);
+	connection.set_enable_register_file(true);
+	EXPECT_EQ(read(connection, read_messages), (std::vector<uint32_t>{0, 0}));
+}